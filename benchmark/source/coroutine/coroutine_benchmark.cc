@@ -0,0 +1,120 @@
+#include <cstdint>
+#include <future>
+
+#include <benchmark/benchmark.h>
+
+#include <common/coroutine/coroutine.h>
+#include <common/coroutine/thread_pool_awaiter.h>
+
+namespace {
+
+/// Count of hops through the pool in each iteration.
+constexpr int64_t hops = 1000;
+
+/**
+ * @brief       Task which adds itself again until no hops left.
+ */
+void hopTask(::remotePortMapper::ThreadPool &threadPool,
+             int64_t                         left,
+             ::std::promise<void>           &done)
+{
+    if (left == 0) {
+        done.set_value();
+        return;
+    }
+
+    threadPool.addTask([&threadPool, left, &done]() -> void {
+        hopTask(threadPool, left - 1, done);
+    });
+}
+
+/**
+ * @brief       Coroutine which continues on the pool until no hops left.
+ */
+::remotePortMapper::Coroutine<>
+    hopCoroutine(::remotePortMapper::ThreadPool &threadPool,
+                 ::std::promise<void>           &done)
+{
+    for (int64_t i = 0; i < hops; ++i) {
+        co_await ::remotePortMapper::schedule(threadPool);
+    }
+    done.set_value();
+}
+
+/**
+ * @brief       Child coroutine.
+ */
+::remotePortMapper::Coroutine<int64_t> child(int64_t value)
+{
+    co_return value + 1;
+}
+
+/**
+ * @brief       Await child coroutines.
+ */
+::remotePortMapper::Coroutine<> awaitChildren(int64_t &value)
+{
+    for (int64_t i = 0; i < hops; ++i) {
+        value = co_await child(value);
+    }
+}
+
+} // namespace
+
+/**
+ * @brief       Continuation written as a chain of \c addTask calls, each
+ *              step captures its state in a new task.
+ */
+static void addTaskChain(::benchmark::State &state)
+{
+    auto result = ::remotePortMapper::ThreadPool::create(2);
+    auto threadPool
+        = result.value<::std::shared_ptr<::remotePortMapper::ThreadPool>>();
+
+    for (auto _ : state) {
+        ::std::promise<void> done;
+        hopTask(*threadPool, hops, done);
+        done.get_future().wait();
+    }
+
+    state.SetItemsProcessed(state.iterations() * hops);
+}
+
+BENCHMARK(addTaskChain)->UseRealTime();
+
+/**
+ * @brief       Continuation written as a coroutine awaiting the pool, the
+ *              state lives in one coroutine frame.
+ */
+static void coroutineResume(::benchmark::State &state)
+{
+    auto result = ::remotePortMapper::ThreadPool::create(2);
+    auto threadPool
+        = result.value<::std::shared_ptr<::remotePortMapper::ThreadPool>>();
+
+    for (auto _ : state) {
+        ::std::promise<void> done;
+        hopCoroutine(*threadPool, done).start(*threadPool);
+        done.get_future().wait();
+    }
+
+    state.SetItemsProcessed(state.iterations() * hops);
+}
+
+BENCHMARK(coroutineResume)->UseRealTime();
+
+/**
+ * @brief       Await child coroutines on the same thread.
+ */
+static void coroutineAwaitChild(::benchmark::State &state)
+{
+    int64_t value = 0;
+    for (auto _ : state) {
+        awaitChildren(value).start();
+    }
+    ::benchmark::DoNotOptimize(value);
+
+    state.SetItemsProcessed(state.iterations() * hops);
+}
+
+BENCHMARK(coroutineAwaitChild);
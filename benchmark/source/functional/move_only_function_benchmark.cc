@@ -0,0 +1,138 @@
+#include <array>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <memory_resource>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+#include <common/functional/move_only_function.h>
+
+namespace {
+
+/**
+ * @brief       Construct, move, call and destroy a function capturing two
+ *              pointers, like most tasks added to a thread pool.
+ */
+template<typename Function>
+void smallCapture(::benchmark::State &state)
+{
+    int64_t  value   = 0;
+    int64_t *pointer = &value;
+    for (auto _ : state) {
+        Function function([&value, pointer]() -> void {
+            value += *pointer + 1;
+        });
+        Function moved(::std::move(function));
+        moved();
+        ::benchmark::DoNotOptimize(value);
+    }
+}
+
+/**
+ * @brief       Construct, move, call and destroy a function capturing a
+ *              64 byte array.
+ */
+template<typename Function>
+void largeCapture(::benchmark::State &state)
+{
+    ::std::array<int64_t, 8> array = {1, 2, 3, 4, 5, 6, 7, 8};
+    int64_t                  value = 0;
+    for (auto _ : state) {
+        Function function([&value, array]() -> void {
+            value += array[7];
+        });
+        Function moved(::std::move(function));
+        moved();
+        ::benchmark::DoNotOptimize(value);
+    }
+}
+
+/**
+ * @brief       Construct, move, call and destroy a function capturing a
+ *              64 byte array, allocated from an arena released in bulk every
+ *              1024 functions, like the arena of a connection.
+ */
+void largeCaptureArena(::benchmark::State &state)
+{
+    ::std::vector<::std::byte>            buffer(128 * 1024);
+    ::std::pmr::monotonic_buffer_resource arena(buffer.data(), buffer.size());
+    ::std::array<int64_t, 8>              array = {1, 2, 3, 4, 5, 6, 7, 8};
+    int64_t                               value = 0;
+    int64_t                               count = 0;
+    for (auto _ : state) {
+        ::remotePortMapper::MoveOnlyFunction<void()> function(
+            ::std::allocator_arg, &arena, [&value, array]() -> void {
+                value += array[7];
+            });
+        ::remotePortMapper::MoveOnlyFunction<void()> moved(
+            ::std::move(function));
+        moved();
+        ::benchmark::DoNotOptimize(value);
+        if (++count % 1024 == 0) {
+            arena.release();
+        }
+    }
+}
+
+/**
+ * @brief       Call a function constructed once.
+ */
+template<typename Function>
+void call(::benchmark::State &state)
+{
+    int64_t  value = 0;
+    Function function([&value]() -> void {
+        ++value;
+    });
+    for (auto _ : state) {
+        function();
+        ::benchmark::DoNotOptimize(value);
+    }
+}
+
+/**
+ * @brief       Move functions through a queue, like the task queue of a
+ *              thread pool.
+ */
+template<typename Function>
+void queue(::benchmark::State &state)
+{
+    ::std::vector<Function> functions;
+    functions.reserve(1024);
+    int64_t value = 0;
+    for (auto _ : state) {
+        for (int64_t i = 0; i < 1024; ++i) {
+            functions.emplace_back([&value, i]() -> void {
+                value += i;
+            });
+        }
+        for (auto &function : functions) {
+            Function taken(::std::move(function));
+            taken();
+        }
+        functions.clear();
+        ::benchmark::DoNotOptimize(value);
+    }
+    state.SetItemsProcessed(state.iterations() * 1024);
+}
+
+} // namespace
+
+BENCHMARK_TEMPLATE(smallCapture, ::remotePortMapper::MoveOnlyFunction<void()>);
+BENCHMARK_TEMPLATE(smallCapture, ::std::function<void()>);
+BENCHMARK_TEMPLATE(largeCapture, ::remotePortMapper::MoveOnlyFunction<void()>);
+BENCHMARK_TEMPLATE(largeCapture, ::std::function<void()>);
+BENCHMARK(largeCaptureArena);
+BENCHMARK_TEMPLATE(call, ::remotePortMapper::MoveOnlyFunction<void()>);
+BENCHMARK_TEMPLATE(call, ::std::function<void()>);
+BENCHMARK_TEMPLATE(queue, ::remotePortMapper::MoveOnlyFunction<void()>);
+BENCHMARK_TEMPLATE(queue, ::std::function<void()>);
+
+#if defined(__cpp_lib_move_only_function)
+BENCHMARK_TEMPLATE(smallCapture, ::std::move_only_function<void()>);
+BENCHMARK_TEMPLATE(largeCapture, ::std::move_only_function<void()>);
+BENCHMARK_TEMPLATE(call, ::std::move_only_function<void()>);
+BENCHMARK_TEMPLATE(queue, ::std::move_only_function<void()>);
+#endif
@@ -0,0 +1,151 @@
+#include <chrono>
+#include <cstdint>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+#include <common/thread_pool/thread_pool.h>
+
+/**
+ * @brief       Idle timeouts which are almost always cancelled, \c range(0) is
+ *              the alarm store and \c range(1) is the count of alarms alive.
+ */
+static void addAndCancel(::benchmark::State &state)
+{
+    auto result = ::remotePortMapper::ThreadPool::create(
+        ::remotePortMapper::ThreadPoolOptions {
+            .workers    = 1,
+            .alarmStore = static_cast<::remotePortMapper::ThreadPoolAlarmStore>(
+                state.range(0))});
+    auto threadPool
+        = result.value<::std::shared_ptr<::remotePortMapper::ThreadPool>>();
+
+    // Alarms alive in the background.
+    auto now = ::std::chrono::steady_clock::now();
+    ::std::vector<decltype(threadPool->addAlarm(
+        now, ::remotePortMapper::ThreadPool::Task()))>
+        alarms;
+    for (int64_t i = 0; i < state.range(1); ++i) {
+        alarms.push_back(threadPool->addAlarm(
+            now + ::std::chrono::seconds(60) + ::std::chrono::microseconds(i),
+            []() -> void {}));
+    }
+
+    ::std::size_t index = 0;
+    for (auto _ : state) {
+        // Push back one idle timeout.
+        auto &alarm = alarms[index];
+        alarm->cancel();
+        alarm = threadPool->addAlarm(
+            ::std::chrono::steady_clock::now() + ::std::chrono::seconds(60),
+            []() -> void {});
+        index = (index + 1) % alarms.size();
+    }
+
+    for (auto &alarm : alarms) {
+        alarm->cancel();
+    }
+}
+
+BENCHMARK(addAndCancel)
+    ->ArgNames({"store", "alarms"})
+    ->ArgsProduct({{static_cast<int64_t>(
+                        ::remotePortMapper::ThreadPoolAlarmStore::SortedMap),
+                    static_cast<int64_t>(
+                        ::remotePortMapper::ThreadPoolAlarmStore::TimingWheel)},
+                   {1000, 100000}});
+
+/**
+ * @brief       Idle timeouts as pooled timers, \c range(0) is the count of
+ *              timers alive.
+ */
+static void addAndCancelTimer(::benchmark::State &state)
+{
+    auto result = ::remotePortMapper::ThreadPool::create(1);
+    auto threadPool
+        = result.value<::std::shared_ptr<::remotePortMapper::ThreadPool>>();
+
+    // Timers alive in the background.
+    auto now = ::std::chrono::steady_clock::now();
+    ::std::vector<::remotePortMapper::ThreadPool::TimerHandle> timers;
+    for (int64_t i = 0; i < state.range(0); ++i) {
+        timers.push_back(threadPool->addTimer(
+            now + ::std::chrono::seconds(60) + ::std::chrono::microseconds(i),
+            []() -> void {}));
+    }
+
+    ::std::size_t index = 0;
+    for (auto _ : state) {
+        // Push back one idle timeout.
+        auto &timer = timers[index];
+        threadPool->cancelTimer(timer);
+        timer = threadPool->addTimer(
+            ::std::chrono::steady_clock::now() + ::std::chrono::seconds(60),
+            []() -> void {});
+        index = (index + 1) % timers.size();
+    }
+
+    for (auto &timer : timers) {
+        threadPool->cancelTimer(timer);
+    }
+}
+
+BENCHMARK(addAndCancelTimer)->ArgName("timers")->Arg(1000)->Arg(100000);
+
+/**
+ * @brief       Idle timeouts pushed back by several threads at once, like
+ *              workers relaying packets of different connections.
+ */
+static void addAndCancelContended(::benchmark::State &state)
+{
+    static auto threadPool
+        = ::remotePortMapper::ThreadPool::create(1)
+              .value<::std::shared_ptr<::remotePortMapper::ThreadPool>>();
+
+    auto alarm = threadPool->addAlarm(::std::chrono::steady_clock::now()
+                                          + ::std::chrono::seconds(60),
+                                      []() -> void {});
+    for (auto _ : state) {
+        alarm->cancel();
+        alarm = threadPool->addAlarm(
+            ::std::chrono::steady_clock::now() + ::std::chrono::seconds(60),
+            []() -> void {});
+    }
+    alarm->cancel();
+}
+
+BENCHMARK(addAndCancelContended)->ThreadRange(1, 8)->UseRealTime();
+
+/**
+ * @brief       Idle timeouts pushed back by rescheduling, \c range(0) is the
+ *              alarm store and \c range(1) turns lazy mode on.
+ */
+static void reschedule(::benchmark::State &state)
+{
+    auto result = ::remotePortMapper::ThreadPool::create(
+        ::remotePortMapper::ThreadPoolOptions {
+            .workers    = 1,
+            .alarmStore = static_cast<::remotePortMapper::ThreadPoolAlarmStore>(
+                state.range(0))});
+    auto threadPool
+        = result.value<::std::shared_ptr<::remotePortMapper::ThreadPool>>();
+
+    bool lazy  = state.range(1) != 0;
+    auto alarm = threadPool->addAlarm(::std::chrono::steady_clock::now()
+                                          + ::std::chrono::seconds(60),
+                                      []() -> void {});
+    for (auto _ : state) {
+        alarm->reschedule(
+            ::std::chrono::steady_clock::now() + ::std::chrono::seconds(60),
+            lazy);
+    }
+    alarm->cancel();
+}
+
+BENCHMARK(reschedule)
+    ->ArgNames({"store", "lazy"})
+    ->ArgsProduct({{static_cast<int64_t>(
+                        ::remotePortMapper::ThreadPoolAlarmStore::SortedMap),
+                    static_cast<int64_t>(
+                        ::remotePortMapper::ThreadPoolAlarmStore::TimingWheel)},
+                   {0, 1}});
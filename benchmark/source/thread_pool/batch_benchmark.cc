@@ -0,0 +1,74 @@
+#include <atomic>
+#include <cstdint>
+#include <future>
+#include <vector>
+
+#include <sys/resource.h>
+
+#include <benchmark/benchmark.h>
+
+#include <common/thread_pool/thread_pool.h>
+
+/**
+ * @brief       Get count of context switches of the process, each futex wait
+ *              which actually sleeps is one voluntary context switch.
+ *
+ * @return      Count of context switches.
+ */
+static int64_t contextSwitches()
+{
+    struct rusage usage;
+    ::getrusage(RUSAGE_SELF, &usage);
+    return usage.ru_nvcsw + usage.ru_nivcsw;
+}
+
+/**
+ * @brief       An event loop wakes with ready sockets and submits one task
+ *              for each, \c range(0) is \c 1 to submit in one batch and
+ *              \c range(1) is the count of ready sockets.
+ */
+static void submitReadySockets(::benchmark::State &state)
+{
+    auto result = ::remotePortMapper::ThreadPool::create(4);
+    auto threadPool
+        = result.value<::std::shared_ptr<::remotePortMapper::ThreadPool>>();
+    bool    batch    = state.range(0) != 0;
+    int64_t ready    = state.range(1);
+    int64_t switches = contextSwitches();
+
+    ::std::vector<::remotePortMapper::ThreadPool::Task> tasks;
+    for (auto _ : state) {
+        ::std::atomic<int64_t> counter(0);
+        ::std::promise<void>   done;
+        auto                   makeTask = [&]() {
+            return [&]() -> void {
+                if (counter.fetch_add(1) + 1 == ready) {
+                    done.set_value();
+                }
+            };
+        };
+
+        if (batch) {
+            for (int64_t i = 0; i < ready; ++i) {
+                tasks.push_back(makeTask());
+            }
+            threadPool->addTasks(tasks);
+            tasks.clear();
+        } else {
+            for (int64_t i = 0; i < ready; ++i) {
+                threadPool->addTask(makeTask());
+            }
+        }
+        done.get_future().wait();
+    }
+
+    state.counters["ctx_switches_per_wake"] = ::benchmark::Counter(
+        static_cast<double>(contextSwitches() - switches),
+        ::benchmark::Counter::kAvgIterations);
+    state.SetItemsProcessed(state.iterations() * ready);
+}
+
+BENCHMARK(submitReadySockets)
+    ->ArgNames({"batch", "ready"})
+    ->ArgsProduct({{0, 1}, {8, 64}})
+    ->UseRealTime();
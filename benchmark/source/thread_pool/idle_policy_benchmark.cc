@@ -0,0 +1,66 @@
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <thread>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+#include <common/thread_pool/thread_pool.h>
+
+/**
+ * @brief       Latency from addTask() to the task starting on a worker which
+ *              went idle before, \c range(0) is \c 0 for the power-saving
+ *              preset and \c 1 for the latency-optimized preset.
+ */
+static void dispatchLatency(::benchmark::State &state)
+{
+    auto idlePolicy
+        = state.range(0) == 0
+              ? ::remotePortMapper::ThreadPoolIdlePolicy::powerSaving()
+              : ::remotePortMapper::ThreadPoolIdlePolicy::latencyOptimized();
+    auto result = ::remotePortMapper::ThreadPool::create(
+        ::remotePortMapper::ThreadPoolOptions {.workers    = 2,
+                                               .idlePolicy = idlePolicy});
+    auto threadPool
+        = result.value<::std::shared_ptr<::remotePortMapper::ThreadPool>>();
+
+    ::std::vector<int64_t> latencies;
+    for (auto _ : state) {
+        // Let workers go idle as between two packets.
+        state.PauseTiming();
+        ::std::this_thread::sleep_for(::std::chrono::microseconds(20));
+        state.ResumeTiming();
+
+        ::std::atomic<int64_t> latency(-1);
+        auto                   submitted = ::std::chrono::steady_clock::now();
+        threadPool->addTask([&]() -> void {
+            latency.store(
+                ::std::chrono::duration_cast<::std::chrono::nanoseconds>(
+                    ::std::chrono::steady_clock::now() - submitted)
+                    .count());
+        });
+        while (latency.load() < 0) {
+            ::std::this_thread::yield();
+        }
+        latencies.push_back(latency.load());
+    }
+
+    // Spinning workers compete with the submitter without spare cores.
+    if (::std::thread::hardware_concurrency() <= threadPool->workerCount()) {
+        state.SetLabel("not enough cores, spinning is meaningless");
+    }
+
+    ::std::sort(latencies.begin(), latencies.end());
+    state.counters["p50_ns"] = static_cast<double>(
+        latencies[latencies.size() / 2]);
+    state.counters["p99_ns"] = static_cast<double>(
+        latencies[latencies.size() * 99 / 100]);
+}
+
+BENCHMARK(dispatchLatency)
+    ->ArgName("latencyOptimized")
+    ->Arg(0)
+    ->Arg(1)
+    ->Iterations(2000);
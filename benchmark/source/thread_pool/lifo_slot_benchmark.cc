@@ -0,0 +1,60 @@
+#include <atomic>
+#include <cstdint>
+#include <future>
+
+#include <benchmark/benchmark.h>
+
+#include <common/thread_pool/thread_pool.h>
+
+/**
+ * @brief       Relay chains, each task schedules its follow-up, \c range(0)
+ *              turns the slot of workers on.
+ */
+static void relayChain(::benchmark::State &state)
+{
+    auto result = ::remotePortMapper::ThreadPool::create(
+        ::remotePortMapper::ThreadPoolOptions {
+            .workers       = 4,
+            .scheduler     = ::remotePortMapper::ThreadPoolScheduler::Global,
+            .lifoSlot      = state.range(0) != 0,
+            .lifoSlotBurst = 0});
+    auto threadPool
+        = result.value<::std::shared_ptr<::remotePortMapper::ThreadPool>>();
+
+    constexpr int64_t chains = 4;
+    constexpr int64_t links  = 1000;
+    struct Relay {
+        ::remotePortMapper::ThreadPool *threadPool;
+        ::std::atomic<int64_t>         *finished;
+        ::std::promise<void>           *done;
+
+        void operator()(int64_t left) const
+        {
+            if (left == 0) {
+                if (finished->fetch_add(1) + 1 == chains) {
+                    done->set_value();
+                }
+                return;
+            }
+            threadPool->addTask([relay = *this, left]() -> void {
+                relay(left - 1);
+            });
+        }
+    };
+
+    for (auto _ : state) {
+        ::std::atomic<int64_t> finished(0);
+        ::std::promise<void>   done;
+        Relay                  relay {threadPool.get(), &finished, &done};
+        for (int64_t i = 0; i < chains; ++i) {
+            threadPool->addTask([relay]() -> void {
+                relay(links);
+            });
+        }
+        done.get_future().wait();
+    }
+
+    state.SetItemsProcessed(state.iterations() * chains * links);
+}
+
+BENCHMARK(relayChain)->ArgName("lifoSlot")->Arg(0)->Arg(1)->UseRealTime();
@@ -0,0 +1,72 @@
+#include <atomic>
+#include <cstdint>
+#include <thread>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+#include <common/thread_pool/thread_pool.h>
+
+/**
+ * @brief       Entry of session table.
+ */
+struct Session {
+    uint64_t lastActive; ///< Tick of last activity.
+    uint64_t bytes;      ///< Bytes forwarded.
+    bool     expired;    ///< Expired flag.
+};
+
+/**
+ * @brief       Scan a table of one million sessions to expire idle ones and
+ *              sum counters, \c range(0) is \c 1 to use \c parallelFor().
+ */
+static void sessionScan(::benchmark::State &state)
+{
+    auto result = ::remotePortMapper::ThreadPool::create(
+        ::remotePortMapper::ThreadPoolOptions {
+            .workers    = ::std::thread::hardware_concurrency(),
+            .idlePolicy = ::remotePortMapper::ThreadPoolIdlePolicy::
+                latencyOptimized()});
+    auto threadPool
+        = result.value<::std::shared_ptr<::remotePortMapper::ThreadPool>>();
+
+    constexpr ::std::size_t entries = 1000000;
+    ::std::vector<Session>  table(entries);
+    for (::std::size_t i = 0; i < entries; ++i) {
+        table[i] = Session {.lastActive = i * 7919 % 1000,
+                            .bytes      = i,
+                            .expired    = false};
+    }
+
+    // Expire sessions idle for more than the limit, sum bytes of the rest.
+    uint64_t now  = 1000;
+    auto     scan = [&](::std::size_t first, ::std::size_t last) -> uint64_t {
+        uint64_t bytes = 0;
+        for (::std::size_t i = first; i < last; ++i) {
+            Session &session = table[i];
+            session.expired  = now - session.lastActive > 500;
+            bytes += session.expired ? 0 : session.bytes;
+        }
+        return bytes;
+    };
+    bool parallel = state.range(0) != 0;
+    for (auto _ : state) {
+        ::std::atomic<uint64_t> bytes(0);
+        if (parallel) {
+            threadPool->parallelFor(
+                0, entries,
+                [&](::std::size_t first, ::std::size_t last) -> void {
+                    bytes.fetch_add(scan(first, last),
+                                    ::std::memory_order_relaxed);
+                });
+        } else {
+            bytes = scan(0, entries);
+        }
+        ::benchmark::DoNotOptimize(bytes.load());
+        ++now;
+    }
+
+    state.SetItemsProcessed(state.iterations() * entries);
+}
+
+BENCHMARK(sessionScan)->ArgName("parallel")->Arg(0)->Arg(1)->UseRealTime();
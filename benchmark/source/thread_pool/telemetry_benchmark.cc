@@ -0,0 +1,44 @@
+#include <atomic>
+#include <cstdint>
+#include <future>
+
+#include <benchmark/benchmark.h>
+
+#include <common/thread_pool/thread_pool.h>
+
+/**
+ * @brief       Throughput of empty tasks, \c range(0) is the sample interval
+ *              of telemetry, \c 0 turns it off.
+ */
+static void telemetryOverhead(::benchmark::State &state)
+{
+    auto result = ::remotePortMapper::ThreadPool::create(
+        ::remotePortMapper::ThreadPoolOptions {
+            .workers                 = 4,
+            .telemetrySampleInterval = static_cast<uint32_t>(state.range(0))});
+    auto threadPool
+        = result.value<::std::shared_ptr<::remotePortMapper::ThreadPool>>();
+
+    constexpr int64_t tasks = 1000;
+    for (auto _ : state) {
+        ::std::atomic<int64_t> counter(0);
+        ::std::promise<void>   done;
+        for (int64_t i = 0; i < tasks; ++i) {
+            threadPool->addTask([&]() -> void {
+                if (counter.fetch_add(1) + 1 == tasks) {
+                    done.set_value();
+                }
+            });
+        }
+        done.get_future().wait();
+    }
+
+    state.SetItemsProcessed(state.iterations() * tasks);
+}
+
+BENCHMARK(telemetryOverhead)
+    ->ArgName("interval")
+    ->Arg(0)
+    ->Arg(1)
+    ->Arg(16)
+    ->UseRealTime();
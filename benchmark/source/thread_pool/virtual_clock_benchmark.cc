@@ -0,0 +1,52 @@
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <thread>
+
+#include <benchmark/benchmark.h>
+
+#include <common/thread_pool/thread_pool.h>
+#include <common/thread_pool/virtual_clock.h>
+
+/**
+ * @brief       An hour of idle timeouts simulated on a virtual clock, one
+ *              second at a time, \c range(0) is the count of timers.
+ */
+static void simulateHour(::benchmark::State &state)
+{
+    auto clockResult = ::remotePortMapper::VirtualClock::create();
+    auto clock       = clockResult.value<
+        ::std::shared_ptr<::remotePortMapper::VirtualClock>>();
+    auto result      = ::remotePortMapper::ThreadPool::create(
+        ::remotePortMapper::ThreadPoolOptions {.workers = 1, .clock = clock});
+    auto threadPool
+        = result.value<::std::shared_ptr<::remotePortMapper::ThreadPool>>();
+
+    constexpr auto         hour  = ::std::chrono::hours(1);
+    int64_t                count = state.range(0);
+    ::std::atomic<int64_t> fired(0);
+    for (auto _ : state) {
+        fired.store(0);
+        auto start = clock->now();
+        for (int64_t i = 0; i < count; ++i) {
+            threadPool->addTimer(start + hour * (i + 1) / count,
+                                 [&fired]() -> void {
+                                     fired.fetch_add(1);
+                                 });
+        }
+        for (int i = 0; i < 3600; ++i) {
+            clock->advance(::std::chrono::seconds(1));
+        }
+        while (fired.load() < count) {
+            ::std::this_thread::yield();
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * count);
+}
+
+BENCHMARK(simulateHour)
+    ->ArgName("timers")
+    ->Arg(10000)
+    ->Arg(1000000)
+    ->Unit(::benchmark::kMillisecond)
+    ->UseRealTime();
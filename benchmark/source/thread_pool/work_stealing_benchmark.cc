@@ -0,0 +1,131 @@
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <future>
+#include <thread>
+
+#include <benchmark/benchmark.h>
+
+#include <common/thread_pool/thread_pool.h>
+
+/// Count of tasks in each iteration.
+static constexpr int taskCount = 1 << 14;
+
+/**
+ * @brief       Create thread pool from benchmark arguments.
+ *
+ * @param[in]   state       Benchmark state, \c range(0) is the scheduler and
+ *                          \c range(1) is the count of workers.
+ *
+ * @return      Thread pool.
+ */
+static ::std::shared_ptr<::remotePortMapper::ThreadPool>
+    createThreadPool(::benchmark::State &state)
+{
+    auto result = ::remotePortMapper::ThreadPool::create(
+        ::remotePortMapper::ThreadPoolOptions {
+            .workers   = static_cast<::std::size_t>(state.range(1)),
+            .scheduler = static_cast<::remotePortMapper::ThreadPoolScheduler>(
+                state.range(0))});
+    return result.value<::std::shared_ptr<::remotePortMapper::ThreadPool>>();
+}
+
+/**
+ * @brief       Do a small amount of work.
+ */
+static void spin()
+{
+    for (int i = 0; i < 64; ++i) {
+        ::benchmark::DoNotOptimize(i);
+    }
+}
+
+/**
+ * @brief       Tasks submitted from outside of the pool.
+ */
+static void externalSubmit(::benchmark::State &state)
+{
+    auto threadPool = createThreadPool(state);
+    for (auto _ : state) {
+        ::std::atomic<int>   counter(0);
+        ::std::promise<void> done;
+        for (int i = 0; i < taskCount; ++i) {
+            threadPool->addTask([&]() -> void {
+                spin();
+                if (counter.fetch_add(1) + 1 == taskCount) {
+                    done.set_value();
+                }
+            });
+        }
+        done.get_future().wait();
+    }
+    state.SetItemsProcessed(state.iterations() * taskCount);
+}
+
+/**
+ * @brief       Spawn tasks recursively.
+ */
+static void spawn(::remotePortMapper::ThreadPool &threadPool,
+                  int                             depth,
+                  ::std::atomic<int>             &counter,
+                  ::std::promise<void>           &done)
+{
+    if (depth > 0) {
+        for (int i = 0; i < 2; ++i) {
+            threadPool.addTask([&, depth]() -> void {
+                spawn(threadPool, depth - 1, counter, done);
+            });
+        }
+    }
+
+    spin();
+    if (counter.fetch_add(1) + 1 == taskCount * 2 - 1) {
+        done.set_value();
+    }
+}
+
+/**
+ * @brief       Tasks spawned by workers, relay callbacks scheduling their
+ *              follow-ups.
+ */
+static void workerSpawn(::benchmark::State &state)
+{
+    auto threadPool = createThreadPool(state);
+    int  depth      = 0;
+    while ((2 << depth) - 1 < taskCount * 2 - 1) {
+        ++depth;
+    }
+    for (auto _ : state) {
+        ::std::atomic<int>   counter(0);
+        ::std::promise<void> done;
+        threadPool->addTask([&]() -> void {
+            spawn(*threadPool, depth, counter, done);
+        });
+        done.get_future().wait();
+    }
+    state.SetItemsProcessed(state.iterations() * (taskCount * 2 - 1));
+}
+
+/**
+ * @brief       Arguments, scheduler x workers from 1 to count of cores.
+ */
+static void scalingArguments(::benchmark::internal::Benchmark *benchmark)
+{
+    int cores = static_cast<int>(
+        ::std::max(::std::thread::hardware_concurrency(), 1U));
+    benchmark->ArgNames({"scheduler", "workers"});
+    for (int scheduler :
+         {static_cast<int>(::remotePortMapper::ThreadPoolScheduler::Global),
+          static_cast<int>(
+              ::remotePortMapper::ThreadPoolScheduler::WorkStealing)}) {
+        for (int workers = 1; workers <= cores; workers *= 2) {
+            benchmark->Args({scheduler, workers});
+        }
+        if ((cores & (cores - 1)) != 0) {
+            benchmark->Args({scheduler, cores});
+        }
+    }
+}
+
+BENCHMARK(externalSubmit)->Apply(scalingArguments)->UseRealTime();
+BENCHMARK(workerSpawn)->Apply(scalingArguments)->UseRealTime();
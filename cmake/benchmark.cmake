@@ -0,0 +1,59 @@
+option (BUILD_BENCHMARK     OFF)
+
+if (BUILD_BENCHMARK)
+    find_package (benchmark REQUIRED)
+
+    set (BENCHMARK_OUTPUT_DIRECTORY  "${CMAKE_CURRENT_SOURCE_DIR}/bin/${OUTPUT_SUB_DIR}/benchmark")
+    
+    # Add benchmark case.
+    function (add_benchmark_case)
+        # Parse arguments.
+        set (options            "")
+        set (one_value_args     "NAME")
+        set (multi_value_args   "LINK_LIBRARIES")
+        cmake_parse_arguments (ARG 
+            "${options}" 
+            "${one_value_args}"
+            "${multi_value_args}" 
+            ${ARGN} 
+        )   
+
+        if (NOT ARG_NAME)
+            message (FATAL_ERROR    "Missing argument \"NAME\"")
+
+        endif ()
+        
+        # Add executable.
+        set (target_name  "${ARG_NAME}_benchmark")
+        file (GLOB_RECURSE  sources
+            "${CMAKE_CURRENT_SOURCE_DIR}/benchmark/source/${ARG_NAME}/*.c"
+            "${CMAKE_CURRENT_SOURCE_DIR}/benchmark/source/${ARG_NAME}/*.cc"
+        )
+
+        add_executable ("${target_name}"
+            ${sources}
+        )
+        set_target_properties ("${target_name}"
+            PROPERTIES  "RUNTIME_OUTPUT_DIRECTORY"  "${BENCHMARK_OUTPUT_DIRECTORY}"
+        )
+        target_include_directories ("${target_name}"    PRIVATE
+            "${CMAKE_CURRENT_SOURCE_DIR}/include"
+        )
+        target_link_libraries ("${target_name}"
+            benchmark::benchmark
+            benchmark::benchmark_main
+        )
+        if (ARG_LINK_LIBRARIES)
+            target_link_libraries ("${target_name}"
+                "${ARG_LINK_LIBRARIES}"
+            )
+
+        endif ()
+
+    endfunction (add_benchmark_case)
+
+else ()
+    function (add_benchmark_case)
+    endfunction (add_benchmark_case)
+
+endif ()
@@ -0,0 +1,252 @@
+#pragma once
+
+#include <coroutine>
+#include <optional>
+#include <type_traits>
+
+namespace remotePortMapper {
+
+/**
+ * @brief   Thread pool.
+ */
+class ThreadPool;
+
+template<typename Type>
+class Coroutine;
+
+/**
+ * @brief   Awaiter of the final suspend point of coroutine.
+ *
+ * Transfers to the awaiting coroutine if there is one, destroys the frame
+ * if the coroutine is detached.
+ */
+class CoroutineFinalAwaiter {
+  public:
+    /**
+     * @brief       Check if ready.
+     *
+     * @return      Always \c false.
+     */
+    inline bool await_ready() const noexcept;
+
+    /**
+     * @brief       Suspend.
+     *
+     * @tparam      PromiseType     Type of promise.
+     *
+     * @param[in]   handle          Handle of the finished coroutine.
+     *
+     * @return      Coroutine to resume.
+     */
+    template<typename PromiseType>
+    inline ::std::coroutine_handle<>
+        await_suspend(::std::coroutine_handle<PromiseType> handle) noexcept;
+
+    /**
+     * @brief       Resume, never called.
+     */
+    inline void await_resume() const noexcept;
+};
+
+/**
+ * @brief   Common part of coroutine promises.
+ */
+class CoroutinePromiseBase {
+    friend class CoroutineFinalAwaiter;
+
+    template<typename Type>
+    friend class Coroutine;
+
+  private:
+    ::std::coroutine_handle<> m_continuation; ///< Coroutine awaiting this.
+    bool                      m_detached;     ///< Frame owns itself.
+
+  public:
+    /**
+     * @brief       Constructor.
+     */
+    inline CoroutinePromiseBase();
+
+  public:
+    /**
+     * @brief       Initial suspend, coroutines are lazy.
+     *
+     * @return      Awaiter.
+     */
+    inline ::std::suspend_always initial_suspend() const noexcept;
+
+    /**
+     * @brief       Final suspend.
+     *
+     * @return      Awaiter.
+     */
+    inline CoroutineFinalAwaiter final_suspend() const noexcept;
+
+    /**
+     * @brief       Handle unhandled exception.
+     */
+    void unhandled_exception() noexcept;
+};
+
+/**
+ * @brief   Promise of coroutine(not void).
+ *
+ * @tparam  Type    Type of return value.
+ */
+template<typename Type>
+class CoroutinePromise : public CoroutinePromiseBase {
+  private:
+    ::std::optional<Type> m_value; ///< Return value.
+
+  public:
+    /**
+     * @brief       Get return object.
+     *
+     * @return      Coroutine.
+     */
+    inline Coroutine<Type> get_return_object() noexcept;
+
+    /**
+     * @brief       Set return value.
+     *
+     * @param[in]   value       Return value.
+     */
+    template<typename ValueType>
+        requires ::std::is_convertible<ValueType &&, Type>::value
+    inline void return_value(ValueType &&value);
+
+    /**
+     * @brief       Take return value.
+     *
+     * @return      Return value.
+     */
+    inline Type takeValue();
+};
+
+/**
+ * @brief   Promise of coroutine(void).
+ */
+template<>
+class CoroutinePromise<void> : public CoroutinePromiseBase {
+  public:
+    /**
+     * @brief       Get return object.
+     *
+     * @return      Coroutine.
+     */
+    inline Coroutine<void> get_return_object() noexcept;
+
+    /**
+     * @brief       Return.
+     */
+    inline void return_void() const noexcept;
+
+    /**
+     * @brief       Take return value.
+     */
+    inline void takeValue() const noexcept;
+};
+
+/**
+ * @brief   Coroutine.
+ *
+ * Coroutines are lazy, they start when awaited or started. Awaiting a
+ * coroutine transfers to it directly and it transfers back when finished,
+ * so a chain of awaits never grows the stack. A started coroutine is
+ * detached and its frame is freed when it finishes.
+ *
+ * @tparam  Type    Type of return value.
+ */
+template<typename Type = void>
+class Coroutine {
+    friend class CoroutinePromise<Type>;
+
+  public:
+    /**
+     * @brief   Promise type.
+     */
+    using promise_type = CoroutinePromise<Type>;
+
+  private:
+    ::std::coroutine_handle<promise_type> m_handle; ///< Handle.
+
+  private:
+    /**
+     * @brief       Constructor.
+     *
+     * @param[in]   handle      Handle.
+     */
+    inline Coroutine(::std::coroutine_handle<promise_type> handle);
+
+  public:
+    /**
+     * @brief       Move constructor.
+     *
+     * @param[in]   coroutine   Coroutine to move.
+     */
+    inline Coroutine(Coroutine &&coroutine);
+
+    Coroutine(const Coroutine &) = delete;
+
+    /**
+     * @brief       Destructor, destroys the frame if not detached.
+     */
+    inline ~Coroutine();
+
+  public:
+    /**
+     * @brief       Check if the coroutine has finished.
+     *
+     * @return      \c true if finished, \c false if not.
+     */
+    inline bool done() const;
+
+    /**
+     * @brief       Start the coroutine on current thread and detach it.
+     */
+    inline void start() &&;
+
+    /**
+     * @brief       Start the coroutine on a thread pool and detach it.
+     *
+     * @param[in]   threadPool      Thread pool.
+     */
+    inline void start(ThreadPool &threadPool) &&;
+
+  public:
+    /**
+     * @brief       Check if ready.
+     *
+     * @return      Always \c false.
+     */
+    inline bool await_ready() const noexcept;
+
+    /**
+     * @brief       Suspend the awaiting coroutine and run this one.
+     *
+     * @param[in]   continuation    Awaiting coroutine.
+     *
+     * @return      Coroutine to resume.
+     */
+    inline ::std::coroutine_handle<>
+        await_suspend(::std::coroutine_handle<> continuation) noexcept;
+
+    /**
+     * @brief       Resume the awaiting coroutine.
+     *
+     * @return      Return value.
+     */
+    inline Type await_resume();
+
+  private:
+    /**
+     * @brief       Release the frame to itself.
+     *
+     * @return      Handle.
+     */
+    inline ::std::coroutine_handle<promise_type> detach();
+};
+
+} // namespace remotePortMapper
+
+#include <common/coroutine/coroutine.hpp>
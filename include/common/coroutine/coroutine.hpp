@@ -0,0 +1,219 @@
+#pragma once
+
+#include <utility>
+
+#include <common/logger/logger.h>
+
+#include <common/coroutine/coroutine.h>
+#include <common/thread_pool/thread_pool.h>
+
+namespace remotePortMapper {
+
+/**
+ * @brief       Check if ready.
+ */
+inline bool CoroutineFinalAwaiter::await_ready() const noexcept
+{
+    return false;
+}
+
+/**
+ * @brief       Suspend.
+ */
+template<typename PromiseType>
+inline ::std::coroutine_handle<> CoroutineFinalAwaiter::await_suspend(
+    ::std::coroutine_handle<PromiseType> handle) noexcept
+{
+    CoroutinePromiseBase &promise = handle.promise();
+    if (promise.m_continuation) {
+        return promise.m_continuation;
+    }
+
+    if (promise.m_detached) {
+        handle.destroy();
+    }
+
+    return ::std::noop_coroutine();
+}
+
+/**
+ * @brief       Resume, never called.
+ */
+inline void CoroutineFinalAwaiter::await_resume() const noexcept {}
+
+/**
+ * @brief       Constructor.
+ */
+inline CoroutinePromiseBase::CoroutinePromiseBase() :
+    m_continuation(nullptr), m_detached(false)
+{}
+
+/**
+ * @brief       Initial suspend, coroutines are lazy.
+ */
+inline ::std::suspend_always
+    CoroutinePromiseBase::initial_suspend() const noexcept
+{
+    return {};
+}
+
+/**
+ * @brief       Final suspend.
+ */
+inline CoroutineFinalAwaiter
+    CoroutinePromiseBase::final_suspend() const noexcept
+{
+    return {};
+}
+
+/**
+ * @brief       Get return object.
+ */
+template<typename Type>
+inline Coroutine<Type> CoroutinePromise<Type>::get_return_object() noexcept
+{
+    return Coroutine<Type>(
+        ::std::coroutine_handle<CoroutinePromise<Type>>::from_promise(*this));
+}
+
+/**
+ * @brief       Set return value.
+ */
+template<typename Type>
+template<typename ValueType>
+    requires ::std::is_convertible<ValueType &&, Type>::value
+inline void CoroutinePromise<Type>::return_value(ValueType &&value)
+{
+    m_value.emplace(::std::forward<ValueType>(value));
+}
+
+/**
+ * @brief       Take return value.
+ */
+template<typename Type>
+inline Type CoroutinePromise<Type>::takeValue()
+{
+    return ::std::move(*m_value);
+}
+
+/**
+ * @brief       Get return object.
+ */
+inline Coroutine<void> CoroutinePromise<void>::get_return_object() noexcept
+{
+    return Coroutine<void>(
+        ::std::coroutine_handle<CoroutinePromise<void>>::from_promise(*this));
+}
+
+/**
+ * @brief       Return.
+ */
+inline void CoroutinePromise<void>::return_void() const noexcept {}
+
+/**
+ * @brief       Take return value.
+ */
+inline void CoroutinePromise<void>::takeValue() const noexcept {}
+
+/**
+ * @brief       Constructor.
+ */
+template<typename Type>
+inline Coroutine<Type>::Coroutine(
+    ::std::coroutine_handle<promise_type> handle) :
+    m_handle(handle)
+{}
+
+/**
+ * @brief       Move constructor.
+ */
+template<typename Type>
+inline Coroutine<Type>::Coroutine(Coroutine &&coroutine) :
+    m_handle(::std::exchange(coroutine.m_handle, nullptr))
+{}
+
+/**
+ * @brief       Destructor, destroys the frame if not detached.
+ */
+template<typename Type>
+inline Coroutine<Type>::~Coroutine()
+{
+    if (m_handle) {
+        m_handle.destroy();
+    }
+}
+
+/**
+ * @brief       Check if the coroutine has finished.
+ */
+template<typename Type>
+inline bool Coroutine<Type>::done() const
+{
+    return ! m_handle || m_handle.done();
+}
+
+/**
+ * @brief       Start the coroutine on current thread and detach it.
+ */
+template<typename Type>
+inline void Coroutine<Type>::start() &&
+{
+    this->detach().resume();
+}
+
+/**
+ * @brief       Start the coroutine on a thread pool and detach it.
+ */
+template<typename Type>
+inline void Coroutine<Type>::start(ThreadPool &threadPool) &&
+{
+    threadPool.addTask([handle = this->detach()]() -> void {
+        handle.resume();
+    });
+}
+
+/**
+ * @brief       Check if ready.
+ */
+template<typename Type>
+inline bool Coroutine<Type>::await_ready() const noexcept
+{
+    return false;
+}
+
+/**
+ * @brief       Suspend the awaiting coroutine and run this one.
+ */
+template<typename Type>
+inline ::std::coroutine_handle<> Coroutine<Type>::await_suspend(
+    ::std::coroutine_handle<> continuation) noexcept
+{
+    m_handle.promise().m_continuation = continuation;
+    return m_handle;
+}
+
+/**
+ * @brief       Resume the awaiting coroutine.
+ */
+template<typename Type>
+inline Type Coroutine<Type>::await_resume()
+{
+    return m_handle.promise().takeValue();
+}
+
+/**
+ * @brief       Release the frame to itself.
+ */
+template<typename Type>
+inline ::std::coroutine_handle<typename Coroutine<Type>::promise_type>
+    Coroutine<Type>::detach()
+{
+    if (! m_handle || m_handle.done()) {
+        panic("Coroutine at " << this << " is empty or finished.");
+    }
+
+    m_handle.promise().m_detached = true;
+    return ::std::exchange(m_handle, nullptr);
+}
+
+} // namespace remotePortMapper
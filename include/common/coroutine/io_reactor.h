@@ -0,0 +1,175 @@
+#pragma once
+
+#if defined(OS_LINUX)
+
+    #include <coroutine>
+    #include <memory>
+    #include <mutex>
+    #include <thread>
+    #include <unordered_map>
+
+    #include <common/error/error.h>
+    #include <common/error/static_error.h>
+    #include <common/event_loop/event_loop.h>
+    #include <common/interfaces/i_create_shared_function.h>
+    #include <common/thread_pool/thread_pool.h>
+    #include <common/types/result.h>
+
+namespace remotePortMapper {
+
+/**
+ * @brief   Readiness reactor to await file descriptors in coroutines.
+ *
+ * One thread waits for registered file descriptors with \c epoll. Each fd
+ * is registered one-shot for the events awaited on it, a ready coroutine is
+ * resumed on the thread pool and the fd is rearmed for the events still
+ * awaited. At most one coroutine may await each event of a fd at a time.
+ */
+class IoReactor :
+    public ::std::enable_shared_from_this<IoReactor>,
+    virtual public ICreateSharedFunc<IoReactor, ::std::shared_ptr<ThreadPool>> {
+    CREATE_SHARED(IoReactor, ::std::shared_ptr<ThreadPool>);
+
+  public:
+    /**
+     * @brief   Awaiter of a fd event.
+     */
+    class WaitAwaiter;
+
+  private:
+    /**
+     * @brief   Coroutines awaiting a fd.
+     */
+    struct Waiters {
+        WaitAwaiter *readable;  ///< Awaiter of readable event.
+        WaitAwaiter *writeable; ///< Awaiter of writeable event.
+    };
+
+  private:
+    static inline constexpr int _maxEvents = 64; ///< Events per wait.
+
+  private:
+    ::std::shared_ptr<ThreadPool> m_threadPool; ///< Thread pool to resume.
+    int                           m_epollFd;    ///< Epoll fd.
+    int                           m_wakeupFd;   ///< Event fd to wake up.
+    bool                          m_running;    ///< Running flag.
+    ::std::mutex                  m_lock;       ///< Lock of waiters.
+    ::std::unordered_map<int, Waiters> m_waiters; ///< Waiters of each fd.
+    ::std::thread                      m_thread;  ///< Reactor thread.
+
+  private:
+    /**
+     * @brief       Constructor.
+     *
+     * @param[in]   threadPool      Thread pool to resume coroutines.
+     */
+    IoReactor(::std::shared_ptr<ThreadPool> threadPool);
+
+    IoReactor(const IoReactor &) = delete;
+    IoReactor(IoReactor &&)      = delete;
+
+  public:
+    /**
+     * @brief       Destructor, awaiting coroutines are resumed with an
+     *              error.
+     */
+    virtual ~IoReactor();
+
+  public:
+    /**
+     * @brief       Await an event of a fd.
+     *
+     * @param[in]   fd          File descriptor.
+     * @param[in]   event       Event to await.
+     *
+     * @return      Awaiter, \c co_await it to get the result.
+     */
+    WaitAwaiter wait(int fd, EventLoop::Event event);
+
+  private:
+    /**
+     * @brief       Register an awaiter.
+     *
+     * @param[in]   awaiter     Awaiter.
+     *
+     * @return      On success, the method returns an ok result. Otherwise
+     *              returns an error.
+     */
+    Result<void, StaticError> addWaiter(WaitAwaiter *awaiter);
+
+    /**
+     * @brief       Get epoll events of waiters.
+     *
+     * @param[in]   waiters     Waiters.
+     *
+     * @return      Epoll events.
+     */
+    static uint32_t epollEvents(const Waiters &waiters);
+
+    /**
+     * @brief       Resume an awaiter on the thread pool.
+     *
+     * @param[in]   awaiter     Awaiter.
+     * @param[in]   result      Result of awaiting.
+     */
+    void resume(WaitAwaiter *awaiter, Result<void, StaticError> result);
+
+    /**
+     * @brief       Reactor thread function.
+     */
+    void reactorThread();
+};
+
+/**
+ * @brief   Awaiter of a fd event.
+ */
+class IoReactor::WaitAwaiter {
+    friend class IoReactor;
+
+  private:
+    IoReactor                *m_reactor; ///< Reactor.
+    int                       m_fd;      ///< File descriptor.
+    EventLoop::Event          m_event;   ///< Event to await.
+    ::std::coroutine_handle<> m_handle;  ///< Awaiting coroutine.
+    Result<void, StaticError> m_result;  ///< Result.
+
+  private:
+    /**
+     * @brief       Constructor.
+     *
+     * @param[in]   reactor     Reactor.
+     * @param[in]   fd          File descriptor.
+     * @param[in]   event       Event to await.
+     */
+    WaitAwaiter(IoReactor *reactor, int fd, EventLoop::Event event);
+
+  public:
+    /**
+     * @brief       Check if ready.
+     *
+     * @return      Always \c false.
+     */
+    bool await_ready() const noexcept;
+
+    /**
+     * @brief       Register the awaiting coroutine.
+     *
+     * @param[in]   handle      Awaiting coroutine.
+     *
+     * @return      \c false if failed to register, the coroutine continues
+     *              immediately with the error.
+     */
+    bool await_suspend(::std::coroutine_handle<> handle);
+
+    /**
+     * @brief       Resume.
+     *
+     * @return      On success, the method returns an ok result. Otherwise
+     *              returns an error.
+     */
+    Result<void, StaticError> await_resume();
+};
+
+} // namespace remotePortMapper
+
+#endif
@@ -0,0 +1,130 @@
+#pragma once
+
+#include <chrono>
+#include <coroutine>
+
+#include <common/thread_pool/thread_pool.h>
+
+namespace remotePortMapper {
+
+/**
+ * @brief   Awaiter to continue on a thread pool.
+ */
+class ThreadPoolScheduleAwaiter {
+  private:
+    ThreadPool        &m_threadPool; ///< Thread pool.
+    ThreadPoolPriority m_priority;   ///< Priority.
+
+  public:
+    /**
+     * @brief       Constructor.
+     *
+     * @param[in]   threadPool      Thread pool.
+     * @param[in]   priority        Priority.
+     */
+    inline ThreadPoolScheduleAwaiter(ThreadPool        &threadPool,
+                                     ThreadPoolPriority priority);
+
+  public:
+    /**
+     * @brief       Check if ready.
+     *
+     * @return      Always \c false.
+     */
+    inline bool await_ready() const noexcept;
+
+    /**
+     * @brief       Suspend and queue the coroutine to the pool.
+     *
+     * @param[in]   handle      Coroutine.
+     */
+    inline void await_suspend(::std::coroutine_handle<> handle);
+
+    /**
+     * @brief       Resume.
+     */
+    inline void await_resume() const noexcept;
+};
+
+/**
+ * @brief   Awaiter to sleep until a timepoint.
+ */
+class ThreadPoolSleepAwaiter {
+  private:
+    ThreadPool &m_threadPool; ///< Thread pool.
+    ::std::chrono::steady_clock::time_point
+        m_timepoint; ///< Timepoint to wake up.
+
+  public:
+    /**
+     * @brief       Constructor.
+     *
+     * @param[in]   threadPool      Thread pool.
+     * @param[in]   timepoint       Timepoint to wake up.
+     */
+    inline ThreadPoolSleepAwaiter(
+        ThreadPool                             &threadPool,
+        ::std::chrono::steady_clock::time_point timepoint);
+
+  public:
+    /**
+     * @brief       Check if ready.
+     *
+     * @return      \c true if the timepoint has passed.
+     */
+    inline bool await_ready() const noexcept;
+
+    /**
+     * @brief       Suspend and add an alarm to resume the coroutine.
+     *
+     * @param[in]   handle      Coroutine.
+     */
+    inline void await_suspend(::std::coroutine_handle<> handle);
+
+    /**
+     * @brief       Resume.
+     */
+    inline void await_resume() const noexcept;
+};
+
+/**
+ * @brief       Continue on a thread pool.
+ *
+ * @param[in]   threadPool      Thread pool.
+ * @param[in]   priority        Priority.
+ *
+ * @return      Awaiter.
+ */
+inline ThreadPoolScheduleAwaiter
+    schedule(ThreadPool        &threadPool,
+             ThreadPoolPriority priority = ThreadPoolPriority::Normal);
+
+/**
+ * @brief       Sleep until a timepoint, continues on the thread pool.
+ *
+ * @param[in]   threadPool      Thread pool, must be owned by a
+ *                              \c std::shared_ptr.
+ * @param[in]   timepoint       Timepoint to wake up.
+ *
+ * @return      Awaiter.
+ */
+inline ThreadPoolSleepAwaiter
+    sleepUntil(ThreadPool                             &threadPool,
+               ::std::chrono::steady_clock::time_point timepoint);
+
+/**
+ * @brief       Sleep for a duration, continues on the thread pool.
+ *
+ * @param[in]   threadPool      Thread pool, must be owned by a
+ *                              \c std::shared_ptr.
+ * @param[in]   duration        Duration to sleep.
+ *
+ * @return      Awaiter.
+ */
+inline ThreadPoolSleepAwaiter
+    sleepFor(ThreadPool                           &threadPool,
+             ::std::chrono::steady_clock::duration duration);
+
+} // namespace remotePortMapper
+
+#include <common/coroutine/thread_pool_awaiter.hpp>
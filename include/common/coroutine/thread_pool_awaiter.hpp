@@ -0,0 +1,104 @@
+#pragma once
+
+#include <common/coroutine/thread_pool_awaiter.h>
+
+namespace remotePortMapper {
+
+/**
+ * @brief       Constructor.
+ */
+inline ThreadPoolScheduleAwaiter::ThreadPoolScheduleAwaiter(
+    ThreadPool &threadPool, ThreadPoolPriority priority) :
+    m_threadPool(threadPool),
+    m_priority(priority)
+{}
+
+/**
+ * @brief       Check if ready.
+ */
+inline bool ThreadPoolScheduleAwaiter::await_ready() const noexcept
+{
+    return false;
+}
+
+/**
+ * @brief       Suspend and queue the coroutine to the pool.
+ */
+inline void
+    ThreadPoolScheduleAwaiter::await_suspend(::std::coroutine_handle<> handle)
+{
+    m_threadPool.addTask(
+        [handle]() -> void {
+            handle.resume();
+        },
+        m_priority);
+}
+
+/**
+ * @brief       Resume.
+ */
+inline void ThreadPoolScheduleAwaiter::await_resume() const noexcept {}
+
+/**
+ * @brief       Constructor.
+ */
+inline ThreadPoolSleepAwaiter::ThreadPoolSleepAwaiter(
+    ThreadPool &threadPool, ::std::chrono::steady_clock::time_point timepoint) :
+    m_threadPool(threadPool),
+    m_timepoint(timepoint)
+{}
+
+/**
+ * @brief       Check if ready.
+ */
+inline bool ThreadPoolSleepAwaiter::await_ready() const noexcept
+{
+    return m_timepoint <= m_threadPool.now();
+}
+
+/**
+ * @brief       Suspend and add an alarm to resume the coroutine.
+ */
+inline void
+    ThreadPoolSleepAwaiter::await_suspend(::std::coroutine_handle<> handle)
+{
+    m_threadPool.addAlarm(m_timepoint, [handle]() -> void {
+        handle.resume();
+    });
+}
+
+/**
+ * @brief       Resume.
+ */
+inline void ThreadPoolSleepAwaiter::await_resume() const noexcept {}
+
+/**
+ * @brief       Continue on a thread pool.
+ */
+inline ThreadPoolScheduleAwaiter schedule(ThreadPool        &threadPool,
+                                          ThreadPoolPriority priority)
+{
+    return ThreadPoolScheduleAwaiter(threadPool, priority);
+}
+
+/**
+ * @brief       Sleep until a timepoint, continues on the thread pool.
+ */
+inline ThreadPoolSleepAwaiter
+    sleepUntil(ThreadPool                             &threadPool,
+               ::std::chrono::steady_clock::time_point timepoint)
+{
+    return ThreadPoolSleepAwaiter(threadPool, timepoint);
+}
+
+/**
+ * @brief       Sleep for a duration, continues on the thread pool.
+ */
+inline ThreadPoolSleepAwaiter
+    sleepFor(ThreadPool                           &threadPool,
+             ::std::chrono::steady_clock::duration duration)
+{
+    return ThreadPoolSleepAwaiter(threadPool, threadPool.now() + duration);
+}
+
+} // namespace remotePortMapper
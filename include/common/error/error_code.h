@@ -9,10 +9,12 @@ namespace remotePortMapper {
  */
 enum class ErrorCode : int32_t {
     // Error code begin.
-    Success      = 0,           ///< Success.
-    InvalidValue = -1,          ///< Invalid value.
-    PageAlloc    = -2,          ///< Failed to allocate memory pages.
-    Unknow       = -2147483648, ///< Unknow error.
+    Success       = 0,           ///< Success.
+    InvalidValue  = -1,          ///< Invalid value.
+    PageAlloc     = -2,          ///< Failed to allocate memory pages.
+    BrokenPromise = -3,          ///< Promise destroyed without a result.
+    Busy          = -4,          ///< Too many requests in progress.
+    Unknow        = -2147483648, ///< Unknow error.
     // Error code end.
 };
 
@@ -0,0 +1,67 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <type_traits>
+
+#include <common/error/error.h>
+#include <common/error/error_code.h>
+#include <common/types/result.h>
+
+namespace remotePortMapper {
+
+/**
+ * @brief   Error infomation without allocation.
+ *
+ * The message is a static string and the detail is only a system error
+ * number, the text of the detail is built when asked for. Trivially copyable,
+ * so hot paths like non-blocking I/O return errors without allocating. Slow
+ * paths convert it to \c Error.
+ */
+struct StaticError {
+    ErrorCode   errCode;          ///< Error code.
+    const char *message     = ""; ///< Static message, never freed.
+    int32_t     systemError = 0;  ///< System error number, \c 0 if none.
+
+    /**
+     * @brief       Build the message with the detail.
+     *
+     * @return      Message, followed by the description of the system error
+     *              if any.
+     */
+    ::std::string detail() const;
+
+    /**
+     * @brief       Convert to \c Error.
+     *
+     * @return      Error with the message and the detail.
+     */
+    operator Error() const;
+};
+
+static_assert(::std::is_trivially_copyable<StaticError>::value);
+
+/**
+ * @brief   Niche of \c StaticError.
+ */
+template<>
+struct ResultNiche<StaticError> {
+    /**
+     * @brief       Get the error code of the value.
+     *
+     * @tparam      Value       Type of the value, maybe const.
+     *
+     * @param[in]   value       Value.
+     *
+     * @return      Reference to the error code.
+     */
+    template<typename Value>
+    static inline auto &errCode(Value &value)
+    {
+        return value.errCode;
+    }
+};
+
+static_assert(sizeof(Result<void, StaticError>) == sizeof(StaticError));
+
+} // namespace remotePortMapper
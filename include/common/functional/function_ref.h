@@ -0,0 +1,104 @@
+#pragma once
+
+#include <functional>
+#include <memory>
+#include <type_traits>
+#include <utility>
+
+namespace remotePortMapper {
+
+/**
+ * @brief   Non-owning reference to a callable.
+ */
+template<typename>
+class FunctionRef;
+
+/**
+ * @brief   Non-owning reference to a callable.
+ *
+ * Two pointers, taken by value and trivially copied. Calls go through a
+ * plain function pointer, nothing is allocated. The referenced callable
+ * must outlive the reference, so it suits callbacks which are called before
+ * the callee returns, never stored ones.
+ *
+ * @tparam  ReturnType  Type of return value.
+ * @tparam  ArgTypes    Type of arguments.
+ */
+template<typename ReturnType, typename... ArgTypes>
+class FunctionRef<ReturnType(ArgTypes...)> {
+  private:
+    /**
+     * @brief   Referenced callable.
+     */
+    union Storage {
+        void *object;       ///< Callable object.
+        void (*function)(); ///< Function pointer.
+    };
+
+  private:
+    Storage m_storage; ///< Referenced callable.
+    ReturnType (*m_invoke)(Storage,
+                           ArgTypes &&...); ///< Function to call it.
+
+  public:
+    /**
+     * @brief       Constructor.
+     *
+     * @param[in]   callable        Callable object or function, must
+     *                              outlive the reference.
+     */
+    template<typename CallableType>
+        requires(! ::std::is_same<::std::remove_cvref_t<CallableType>,
+                                  FunctionRef>::value
+                 && ::std::is_invocable_r<ReturnType,
+                                          CallableType &,
+                                          ArgTypes...>::value)
+    inline FunctionRef(CallableType &&callable) noexcept
+    {
+        using Type = ::std::remove_reference_t<CallableType>;
+        if constexpr (::std::is_function<Type>::value
+                      || ::std::is_pointer<::std::remove_cv_t<Type>>::value) {
+            // Functions are referenced by their address.
+            m_storage.function = reinterpret_cast<void (*)()>(callable);
+            m_invoke = [](Storage storage, ArgTypes &&...args) -> ReturnType {
+                auto function = reinterpret_cast<::std::decay_t<Type>>(
+                    storage.function);
+                if constexpr (::std::is_void<ReturnType>::value) {
+                    function(::std::forward<ArgTypes>(args)...);
+                } else {
+                    return function(::std::forward<ArgTypes>(args)...);
+                }
+            };
+        } else {
+            m_storage.object = const_cast<void *>(
+                static_cast<const void *>(::std::addressof(callable)));
+            m_invoke = [](Storage storage, ArgTypes &&...args) -> ReturnType {
+                Type &object = *static_cast<Type *>(storage.object);
+                if constexpr (::std::is_void<ReturnType>::value) {
+                    ::std::invoke(object, ::std::forward<ArgTypes>(args)...);
+                } else {
+                    return ::std::invoke(object,
+                                         ::std::forward<ArgTypes>(args)...);
+                }
+            };
+        }
+    }
+
+    FunctionRef(const FunctionRef &)            = default;
+    FunctionRef &operator=(const FunctionRef &) = default;
+
+  public:
+    /**
+     * @brief       Call the referenced callable.
+     *
+     * @param[in]   args        Arguments.
+     *
+     * @return  Return value of the referenced callable.
+     */
+    inline ReturnType operator()(ArgTypes... args) const
+    {
+        return m_invoke(m_storage, ::std::forward<ArgTypes>(args)...);
+    }
+};
+
+} // namespace remotePortMapper
@@ -1,176 +1,402 @@
 #pragma once
 
+#include <cstddef>
 #include <functional>
 #include <memory>
+#include <memory_resource>
+#include <new>
 #include <tuple>
 #include <type_traits>
+#include <utility>
 
 #include <common/types/type_traits.h>
 
 namespace remotePortMapper {
 
 /**
- * @brief   Invoker of move-only function.
+ * @brief   Table of operations on the callable stored in a move-only
+ *          function.
  */
 template<typename>
-class MoveOnlyFunctionInvokerBase;
+struct MoveOnlyFunctionVTable;
 
 /**
- * @brief   Invoker of move-only function.
+ * @brief   Table of operations on the callable stored in a move-only
+ *          function.
  *
  * @tparam  ReturnType  Type of return value.
  * @tparam  ArgTypes    Type of arguments.
  */
 template<typename ReturnType, typename... ArgTypes>
-class MoveOnlyFunctionInvokerBase<ReturnType(ArgTypes...)> {
-  public:
-    /**
-     * @brief       Constructor.
-     */
-    MoveOnlyFunctionInvokerBase()                                    = default;
-    MoveOnlyFunctionInvokerBase(const MoveOnlyFunctionInvokerBase &) = delete;
-    MoveOnlyFunctionInvokerBase(MoveOnlyFunctionInvokerBase &&)      = delete;
+struct MoveOnlyFunctionVTable<ReturnType(ArgTypes...)> {
+    /// Invoke the callable in the storage.
+    ReturnType (*invoke)(void *storage, ArgTypes &&...args);
 
-    /**
-     * @brief       Invoke.
-     *
-     * @param[in]   args        Arguments.
-     *
-     * @return      Return value of the function.
-     */
-    virtual ReturnType invoke(ArgTypes &&...args) = 0;
+    /// Move the callable from a storage to an uninitialized one and destroy
+    /// the source.
+    void (*move)(void *destination, void *source) noexcept;
 
-    /**
-     * @brief       Destructor.
-     */
-    virtual ~MoveOnlyFunctionInvokerBase() = default;
+    /// Destroy the callable in the storage.
+    void (*destroy)(void *storage) noexcept;
 };
 
 /**
- * @brief   Invoker for move-only function(\c ReturnType is not \c void).
+ * @brief   Operations on a callable stored in a move-only function.
+ *
+ * A callable which fits the inline storage and moves without throwing is
+ * stored in place, others are allocated and the storage keeps the pointer.
  *
  * @tparam  CallableType    Type of the callable.
+ * @tparam  Inline          Whether the callable is stored in place.
  * @tparam  ReturnType      Type of return value.
  * @tparam  ArgTypes        Type of arguments.
  */
-template<typename CallableType, typename ReturnType, typename... ArgTypes>
+template<typename CallableType,
+         bool Inline,
+         typename ReturnType,
+         typename... ArgTypes>
     requires(
-        ::std::is_invocable_r<ReturnType, CallableType, ArgTypes...>::value)
-class MoveOnlyFunctionInvoker :
-    public MoveOnlyFunctionInvokerBase<ReturnType(ArgTypes...)> {
-  private:
-    CallableType m_callable; ///< Callable object.
+        ::std::is_invocable_r<ReturnType, CallableType &, ArgTypes...>::value)
+class MoveOnlyFunctionInvoker {
+  public:
+    /// Table of the operations.
+    static constexpr MoveOnlyFunctionVTable<ReturnType(ArgTypes...)> _vtable
+        = {&MoveOnlyFunctionInvoker::invoke, &MoveOnlyFunctionInvoker::move,
+           &MoveOnlyFunctionInvoker::destroy};
 
   public:
     /**
-     * @brief       Constructor.
+     * @brief       Construct the callable in an uninitialized storage.
      *
-     * @param[in]   callable        Callable object.
+     * @param[in]   storage     Storage.
+     * @param[in]   callable    Callable object.
      */
-    inline MoveOnlyFunctionInvoker(CallableType &&callable) :
-        m_callable(::std::move(callable))
-    {}
+    template<typename Type>
+    static inline void construct(void *storage, Type &&callable)
+    {
+        if constexpr (Inline) {
+            new (storage) CallableType(::std::forward<Type>(callable));
+        } else {
+            *static_cast<CallableType **>(storage)
+                = new CallableType(::std::forward<Type>(callable));
+        }
+    }
 
-    MoveOnlyFunctionInvoker(const MoveOnlyFunctionInvoker &) = delete;
-    MoveOnlyFunctionInvoker(MoveOnlyFunctionInvoker &&)      = delete;
+  private:
+    /**
+     * @brief       Get the callable in the storage.
+     *
+     * @param[in]   storage     Storage.
+     *
+     * @return      Callable.
+     */
+    static inline CallableType &callable(void *storage)
+    {
+        if constexpr (Inline) {
+            return *::std::launder(static_cast<CallableType *>(storage));
+        } else {
+            return **static_cast<CallableType **>(storage);
+        }
+    }
 
     /**
-     * @brief       Invoke.
+     * @brief       Invoke the callable in the storage.
      *
+     * @param[in]   storage     Storage.
      * @param[in]   args        Arguments.
      *
-     * @return      Return value of the function.
+     * @return      Return value of the callable.
      */
-    virtual ReturnType invoke(ArgTypes &&...args) override
+    static ReturnType invoke(void *storage, ArgTypes &&...args)
     {
-        return m_callable(::std::forward<ArgTypes &&>(args)...);
+        if constexpr (::std::is_void<ReturnType>::value) {
+            MoveOnlyFunctionInvoker::callable(storage)(
+                ::std::forward<ArgTypes &&>(args)...);
+        } else {
+            return MoveOnlyFunctionInvoker::callable(storage)(
+                ::std::forward<ArgTypes &&>(args)...);
+        }
     }
 
     /**
-     * @brief       Destructor.
+     * @brief       Move the callable to an uninitialized storage and destroy
+     *              the source.
+     *
+     * @param[in]   destination     Destination storage.
+     * @param[in]   source          Source storage.
      */
-    virtual ~MoveOnlyFunctionInvoker() = default;
+    static void move(void *destination, void *source) noexcept
+    {
+        if constexpr (Inline) {
+            CallableType &callable = MoveOnlyFunctionInvoker::callable(source);
+            new (destination) CallableType(::std::move(callable));
+            callable.~CallableType();
+        } else {
+            *static_cast<CallableType **>(destination)
+                = *static_cast<CallableType **>(source);
+        }
+    }
+
+    /**
+     * @brief       Destroy the callable in the storage.
+     *
+     * @param[in]   storage     Storage.
+     */
+    static void destroy(void *storage) noexcept
+    {
+        if constexpr (Inline) {
+            MoveOnlyFunctionInvoker::callable(storage).~CallableType();
+        } else {
+            delete *static_cast<CallableType **>(storage);
+        }
+    }
 };
 
 /**
- * @brief   Invoker for move-only function(\c ReturnType is \c void).
+ * @brief   Operations on a callable stored in a move-only function and
+ *          allocated by an allocator.
+ *
+ * The allocator is kept next to the callable, the storage keeps the pointer
+ * to both.
  *
  * @tparam  CallableType    Type of the callable.
+ * @tparam  Allocator       Type of the allocator.
+ * @tparam  ReturnType      Type of return value.
  * @tparam  ArgTypes        Type of arguments.
  */
-template<typename CallableType, typename... ArgTypes>
-    requires(::std::is_invocable_r<void, CallableType, ArgTypes...>::value)
-class MoveOnlyFunctionInvoker<CallableType, void, ArgTypes...> :
-    public MoveOnlyFunctionInvokerBase<void(ArgTypes...)> {
+template<typename CallableType,
+         typename Allocator,
+         typename ReturnType,
+         typename... ArgTypes>
+    requires(
+        ::std::is_invocable_r<ReturnType, CallableType &, ArgTypes...>::value)
+class MoveOnlyFunctionAllocatedInvoker {
   private:
-    CallableType m_callable; ///< Callable object.
+    /**
+     * @brief   Allocated block.
+     */
+    struct Block {
+        Allocator    allocator; ///< Allocator of the block.
+        CallableType callable;  ///< Callable object.
+
+        /**
+         * @brief       Constructor.
+         *
+         * @param[in]   allocator       Allocator of the block.
+         * @param[in]   callable        Callable object.
+         */
+        template<typename Type>
+        inline Block(const Allocator &allocator, Type &&callable) :
+            allocator(allocator), callable(::std::forward<Type>(callable))
+        {}
+    };
+
+    /// Allocator of blocks.
+    using BlockAllocator = typename ::std::allocator_traits<
+        Allocator>::template rebind_alloc<Block>;
+
+    /// Traits of the allocator of blocks.
+    using BlockAllocatorTraits = ::std::allocator_traits<BlockAllocator>;
+
+  public:
+    /// Table of the operations.
+    static constexpr MoveOnlyFunctionVTable<ReturnType(ArgTypes...)> _vtable
+        = {&MoveOnlyFunctionAllocatedInvoker::invoke,
+           &MoveOnlyFunctionAllocatedInvoker::move,
+           &MoveOnlyFunctionAllocatedInvoker::destroy};
 
   public:
     /**
-     * @brief       Constructor.
+     * @brief       Allocate the callable and keep the pointer in an
+     *              uninitialized storage.
      *
-     * @param[in]   callable        Callable object.
+     * @param[in]   storage     Storage.
+     * @param[in]   allocator   Allocator.
+     * @param[in]   callable    Callable object.
      */
-    inline MoveOnlyFunctionInvoker(CallableType &&callable) :
-        m_callable(::std::move(callable))
-    {}
-
-    MoveOnlyFunctionInvoker(const MoveOnlyFunctionInvoker &) = delete;
-    MoveOnlyFunctionInvoker(MoveOnlyFunctionInvoker &&)      = delete;
+    template<typename Type>
+    static inline void
+        construct(void *storage, const Allocator &allocator, Type &&callable)
+    {
+        BlockAllocator blockAllocator(allocator);
+        Block *block = BlockAllocatorTraits::allocate(blockAllocator, 1);
+        try {
+            new (block) Block(allocator, ::std::forward<Type>(callable));
+        } catch (...) {
+            BlockAllocatorTraits::deallocate(blockAllocator, block, 1);
+            throw;
+        }
+        *static_cast<Block **>(storage) = block;
+    }
 
+  private:
     /**
-     * @brief       Invoke.
+     * @brief       Invoke the callable in the storage.
      *
+     * @param[in]   storage     Storage.
      * @param[in]   args        Arguments.
      *
-     * @return      Return value of the function.
+     * @return      Return value of the callable.
      */
-    virtual void invoke(ArgTypes &&...args) override
+    static ReturnType invoke(void *storage, ArgTypes &&...args)
     {
-        m_callable(::std::forward<ArgTypes &&>(args)...);
-        return;
+        CallableType &callable = (*static_cast<Block **>(storage))->callable;
+        if constexpr (::std::is_void<ReturnType>::value) {
+            callable(::std::forward<ArgTypes &&>(args)...);
+        } else {
+            return callable(::std::forward<ArgTypes &&>(args)...);
+        }
     }
 
     /**
-     * @brief       Destructor.
+     * @brief       Move the pointer to an uninitialized storage.
+     *
+     * @param[in]   destination     Destination storage.
+     * @param[in]   source          Source storage.
+     */
+    static void move(void *destination, void *source) noexcept
+    {
+        *static_cast<Block **>(destination) = *static_cast<Block **>(source);
+    }
+
+    /**
+     * @brief       Destroy the callable and return the block to its
+     *              allocator.
+     *
+     * @param[in]   storage     Storage.
      */
-    virtual ~MoveOnlyFunctionInvoker() = default;
+    static void destroy(void *storage) noexcept
+    {
+        Block         *block = *static_cast<Block **>(storage);
+        BlockAllocator blockAllocator(block->allocator);
+        block->~Block();
+        BlockAllocatorTraits::deallocate(blockAllocator, block, 1);
+    }
 };
 
+/// Default size of the inline storage of move-only functions, a lambda
+/// capturing up to three pointers is stored without allocation.
+inline constexpr ::std::size_t moveOnlyFunctionInlineSize = 3 * sizeof(void *);
+
 /**
  * @brief   Move-only function.
  */
-template<typename>
+template<typename, ::std::size_t = moveOnlyFunctionInlineSize>
 class MoveOnlyFunction;
 
 /**
- * @brief   Move-only function(not void).
+ * @brief   Move-only function.
+ *
+ * Callables up to \c InlineSize bytes which move without throwing are
+ * stored in place, calls go through a static table of operations instead of
+ * virtual functions. Larger callables are allocated, from the global heap or
+ * from an allocator or memory resource passed with \c ::std::allocator_arg,
+ * so an arena can serve them.
  *
  * @tparam  ReturnType  Type of return value.
  * @tparam  ArgTypes    Type of arguments.
+ * @tparam  InlineSize  Size of the inline storage.
  */
-template<typename ReturnType, typename... ArgTypes>
-class MoveOnlyFunction<ReturnType(ArgTypes...)> {
+template<typename ReturnType, typename... ArgTypes, ::std::size_t InlineSize>
+class MoveOnlyFunction<ReturnType(ArgTypes...), InlineSize> {
   private:
-    ::std::unique_ptr<MoveOnlyFunctionInvokerBase<ReturnType(ArgTypes...)>>
-        m_invoker; ///< Invoker.
+    /**
+     * @brief       Check if a callable is stored in place.
+     *
+     * @tparam      CallableType    Type of the callable.
+     */
+    template<typename CallableType>
+    static constexpr bool _inline
+        = sizeof(CallableType) <= InlineSize
+          && alignof(CallableType) <= alignof(::std::max_align_t)
+          && ::std::is_nothrow_move_constructible<CallableType>::value;
+
+  private:
+    const MoveOnlyFunctionVTable<ReturnType(ArgTypes...)>
+        *m_vtable; ///< Operations of the callable, \c nullptr if empty.
+    alignas(::std::max_align_t) mutable unsigned char m_storage
+        [InlineSize < sizeof(void *) ? sizeof(void *)
+                                     : InlineSize]; ///< Storage of callable.
 
   public:
     /**
      * @brief       Constructor.
      */
-    inline MoveOnlyFunction() {}
+    inline MoveOnlyFunction() : m_vtable(nullptr) {}
 
     /**
      * @brief       Constructor.
      *
-     * @param[in]   callable        Callable object.
+     * @param[in]   callable        Callable object, copied if an lvalue.
+     */
+    template<typename CallableType>
+        requires(! ::std::is_same<::std::decay_t<CallableType>,
+                                  MoveOnlyFunction>::value
+                 && ::std::is_invocable_r<ReturnType,
+                                          ::std::decay_t<CallableType> &,
+                                          ArgTypes...>::value)
+    inline MoveOnlyFunction(CallableType &&callable)
+    {
+        using Invoker
+            = MoveOnlyFunctionInvoker<::std::decay_t<CallableType>,
+                                      _inline<::std::decay_t<CallableType>>,
+                                      ReturnType, ArgTypes...>;
+        Invoker::construct(m_storage, ::std::forward<CallableType>(callable));
+        m_vtable = &Invoker::_vtable;
+    }
+
+    /**
+     * @brief       Constructor, allocates a callable which is not stored in
+     *              place by an allocator.
+     *
+     * @param[in]   allocator       Allocator.
+     * @param[in]   callable        Callable object, copied if an lvalue.
+     */
+    template<typename Allocator, typename CallableType>
+        requires(! ::std::is_convertible<Allocator,
+                                         ::std::pmr::memory_resource *>::value
+                 && ::std::is_invocable_r<ReturnType,
+                                          ::std::decay_t<CallableType> &,
+                                          ArgTypes...>::value)
+    inline MoveOnlyFunction(::std::allocator_arg_t,
+                            const Allocator &allocator,
+                            CallableType   &&callable)
+    {
+        using Type = ::std::decay_t<CallableType>;
+        if constexpr (_inline<Type>) {
+            using Invoker
+                = MoveOnlyFunctionInvoker<Type, true, ReturnType, ArgTypes...>;
+            Invoker::construct(m_storage,
+                               ::std::forward<CallableType>(callable));
+            m_vtable = &Invoker::_vtable;
+        } else {
+            using Invoker
+                = MoveOnlyFunctionAllocatedInvoker<Type, Allocator, ReturnType,
+                                                   ArgTypes...>;
+            Invoker::construct(m_storage, allocator,
+                               ::std::forward<CallableType>(callable));
+            m_vtable = &Invoker::_vtable;
+        }
+    }
+
+    /**
+     * @brief       Constructor, allocates a callable which is not stored in
+     *              place from a memory resource.
+     *
+     * @param[in]   resource        Memory resource, must outlive the
+     *                              function.
+     * @param[in]   callable        Callable object, copied if an lvalue.
      */
     template<typename CallableType>
-    inline MoveOnlyFunction(CallableType &&callable) :
-        m_invoker(
-            new MoveOnlyFunctionInvoker<CallableType, ReturnType, ArgTypes...>(
-                ::std::move(callable)))
+        requires(::std::is_invocable_r<ReturnType,
+                                       ::std::decay_t<CallableType> &,
+                                       ArgTypes...>::value)
+    inline MoveOnlyFunction(::std::allocator_arg_t,
+                            ::std::pmr::memory_resource *resource,
+                            CallableType               &&callable) :
+        MoveOnlyFunction(::std::allocator_arg,
+                         ::std::pmr::polymorphic_allocator<>(resource),
+                         ::std::forward<CallableType>(callable))
     {}
 
     /**
@@ -178,16 +404,26 @@ class MoveOnlyFunction<ReturnType(ArgTypes...)> {
      *
      * @param[in]   func            Function to move.
      */
-    inline MoveOnlyFunction(MoveOnlyFunction &&func) :
-        m_invoker(::std::move(func.m_invoker))
-    {}
+    inline MoveOnlyFunction(MoveOnlyFunction &&func) noexcept :
+        m_vtable(func.m_vtable)
+    {
+        if (m_vtable != nullptr) {
+            m_vtable->move(m_storage, func.m_storage);
+            func.m_vtable = nullptr;
+        }
+    }
 
     MoveOnlyFunction(const MoveOnlyFunction &) = delete;
 
     /**
      * @brief       Destructor.
      */
-    ~MoveOnlyFunction() = default;
+    inline ~MoveOnlyFunction()
+    {
+        if (m_vtable != nullptr) {
+            m_vtable->destroy(m_storage);
+        }
+    }
 
   public:
     /**
@@ -197,41 +433,45 @@ class MoveOnlyFunction<ReturnType(ArgTypes...)> {
      */
     inline operator bool() const
     {
-        return m_invoker != nullptr;
+        return m_vtable != nullptr;
     }
 
     /**
-     * @brief       Call the stored function object(not void).
+     * @brief       Operator=.
      *
-     * @param[in]   args        Arguments.
+     * @param[in]   func            Function to move.
      *
-     * @return  Return value of the stored callable function object.
+     * @return      *this.
      */
-    template<typename R = ReturnType>
-        requires(! ::std::is_void<R>::value)
-    inline ReturnType operator()(ArgTypes &&...args) const
+    inline MoveOnlyFunction &operator=(MoveOnlyFunction &&func) noexcept
     {
-        if (*this) {
-            return m_invoker->invoke(::std::forward<ArgTypes &&>(args)...);
-        } else {
-            throw std::bad_function_call();
+        if (this != &func) {
+            if (m_vtable != nullptr) {
+                m_vtable->destroy(m_storage);
+            }
+            m_vtable = func.m_vtable;
+            if (m_vtable != nullptr) {
+                m_vtable->move(m_storage, func.m_storage);
+                func.m_vtable = nullptr;
+            }
         }
+        return *this;
     }
 
+    MoveOnlyFunction &operator=(const MoveOnlyFunction &) = delete;
+
     /**
-     * @brief       Call the stored function object(not void).
+     * @brief       Call the stored function object.
      *
      * @param[in]   args        Arguments.
      *
      * @return  Return value of the stored callable function object.
      */
-    template<typename R = ReturnType>
-        requires ::std::is_void<R>::value
     inline ReturnType operator()(ArgTypes &&...args) const
     {
         if (*this) {
-            m_invoker->invoke(::std::forward<ArgTypes &&>(args)...);
-            return;
+            return m_vtable->invoke(m_storage,
+                                    ::std::forward<ArgTypes &&>(args)...);
         } else {
             throw std::bad_function_call();
         }
@@ -13,6 +13,7 @@
 #endif
 
 #include <common/error/error.h>
+#include <common/error/static_error.h>
 #include <common/types/result.h>
 
 #include <common/interfaces/i_to_string.h>
@@ -73,7 +74,7 @@ class SocketAddress : virtual public IToString {
      *
      * @return      Fill result.
      */
-    Result<void, Error> fill(const ::std::string &ip, uint16_t port);
+    Result<void, StaticError> fill(const ::std::string &ip, uint16_t port);
 
     /**
      * @brief   Get address type.
@@ -0,0 +1,133 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <memory>
+#include <type_traits>
+
+#include <common/interfaces/i_create_shared_function.h>
+#include <common/thread_pool/future.h>
+#include <common/thread_pool/thread_pool.h>
+
+namespace remotePortMapper {
+
+/**
+ * @brief   Options of blocking pool.
+ */
+struct BlockingPoolOptions {
+    /// Maximum count of threads running blocking tasks. Threads are spawned
+    /// on demand, one is always kept.
+    ::std::size_t maxThreads = 64;
+
+    /// Maximum count of tasks waiting for a thread, tasks submitted beyond
+    /// it fail with \c ErrorCode::Busy.
+    ::std::size_t maxQueued = 1024;
+
+    /// Idle period after which a thread above one retires.
+    ::std::chrono::steady_clock::duration idleTimeout
+        = ::std::chrono::seconds(10);
+};
+
+/**
+ * @brief   Bounded pool for blocking operations.
+ *
+ * Calls which block, like \c getaddrinfo() or file I/O, run on threads of
+ * their own instead of workers of the main pool, so a blocked call never
+ * takes a worker relaying traffic. Results are delivered through futures of
+ * the main pool, continuations added by \c Future::then() run on its
+ * workers.
+ *
+ * A submitted task keeps the blocking pool alive until it returns.
+ */
+class BlockingPool :
+    public ::std::enable_shared_from_this<BlockingPool>,
+    virtual public ICreateSharedFunc<BlockingPool,
+                                     ::std::shared_ptr<ThreadPool>>,
+    virtual public ICreateSharedFunc<BlockingPool,
+                                     ::std::shared_ptr<ThreadPool>,
+                                     BlockingPoolOptions> {
+    CREATE_SHARED(BlockingPool, ::std::shared_ptr<ThreadPool>);
+    CREATE_SHARED(BlockingPool,
+                  ::std::shared_ptr<ThreadPool>,
+                  BlockingPoolOptions);
+
+  private:
+    ::std::weak_ptr<ThreadPool>   m_threadPool; ///< Main thread pool.
+    ::std::size_t                 m_maxTasks;   ///< Maximum tasks in pool.
+    ::std::atomic<::std::size_t>  m_tasks;      ///< Tasks not finished.
+    ::std::shared_ptr<ThreadPool> m_threads;    ///< Threads of the pool.
+
+  private:
+    /**
+     * @brief       Constructor.
+     *
+     * @param[in]   threadPool      Main thread pool to deliver results.
+     * @param[in]   options         Options.
+     */
+    BlockingPool(::std::shared_ptr<ThreadPool> threadPool,
+                 BlockingPoolOptions           options = {});
+
+  public:
+    BlockingPool(const BlockingPool &) = delete;
+    BlockingPool(BlockingPool &&)      = delete;
+
+  public:
+    /**
+     * @brief       Destructor.
+     */
+    virtual ~BlockingPool();
+
+  public:
+    /**
+     * @brief       Get main thread pool.
+     *
+     * @return      Thread pool, \c nullptr if destroyed.
+     */
+    ::std::shared_ptr<ThreadPool> threadPool() const;
+
+    /**
+     * @brief       Get count of threads.
+     *
+     * @return      Count of threads.
+     */
+    ::std::size_t threadCount() const;
+
+    /**
+     * @brief       Get count of tasks running or waiting for a thread.
+     *
+     * @return      Count of tasks.
+     */
+    ::std::size_t pendingTasks() const;
+
+    /**
+     * @brief       Submit a blocking function.
+     *
+     * @tparam      Function        Type of the function.
+     *
+     * @param[in]   function        Function returns \c Result<T, Error>.
+     *
+     * @return      Future of the main pool, fails with \c ErrorCode::Busy
+     *              if the pool is full.
+     */
+    template<typename Function>
+        requires ::std::is_invocable<::std::decay_t<Function> &>::value
+    inline Future<FutureValueOf<Function>> submit(Function &&function);
+
+  private:
+    /**
+     * @brief       Take a place for a task.
+     *
+     * @return      \c true if taken, \c false if the pool is full.
+     */
+    bool acquire();
+
+    /**
+     * @brief       Release the place of a finished task.
+     */
+    void release();
+};
+
+} // namespace remotePortMapper
+
+#include <common/thread_pool/blocking_pool.hpp>
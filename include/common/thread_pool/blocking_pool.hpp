@@ -0,0 +1,36 @@
+#pragma once
+
+#include <common/thread_pool/blocking_pool.h>
+
+namespace remotePortMapper {
+
+/**
+ * @brief       Submit a blocking function.
+ */
+template<typename Function>
+    requires ::std::is_invocable<::std::decay_t<Function> &>::value
+inline Future<FutureValueOf<Function>>
+    BlockingPool::submit(Function &&function)
+{
+    using T = FutureValueOf<Function>;
+    Promise<T> promise(m_threadPool.lock());
+    Future<T>  ret = promise.future();
+    if (! this->acquire()) {
+        promise.setResult(Result<T, Error>::makeError(
+            Error {ErrorCode::Busy, "Too many blocking tasks."}));
+        return ret;
+    }
+
+    m_threads->addTask(
+        [self     = this->shared_from_this(),
+         function = ::std::forward<Function>(function),
+         promise  = ::std::move(promise)]() mutable -> void {
+            Result<T, Error> result = function();
+            self->release();
+            promise.setResult(::std::move(result));
+        });
+
+    return ret;
+}
+
+} // namespace remotePortMapper
@@ -0,0 +1,104 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include <common/error/error.h>
+#include <common/types/result.h>
+
+namespace remotePortMapper {
+
+/**
+ * @brief   NUMA node.
+ */
+struct NumaNode {
+    uint32_t                id;   ///< ID of the node.
+    ::std::vector<uint32_t> cpus; ///< CPUs of the node the process may use.
+};
+
+/**
+ * @brief   CPU topology of the machine.
+ */
+class CpuTopology {
+  public:
+    CpuTopology() = delete;
+
+  public:
+    /**
+     * @brief       Get NUMA nodes, detected once.
+     *
+     * On Linux the nodes are read from \c /sys/devices/system/node and only
+     * CPUs the process may run on are kept. When NUMA information is not
+     * available, all CPUs are reported as node 0.
+     *
+     * @return      NUMA nodes which have usable CPUs.
+     */
+    static const ::std::vector<NumaNode> &numaNodes();
+
+    /**
+     * @brief       Get all usable CPUs, ordered by NUMA node.
+     *
+     * @return      CPUs.
+     */
+    static ::std::vector<uint32_t> cpus();
+
+    /**
+     * @brief       Get CPUs the process may run on.
+     *
+     * @return      CPUs.
+     */
+    static ::std::vector<uint32_t> allowedCpus();
+
+    /**
+     * @brief       Get count of CPUs the CPU quota of the process allows.
+     *
+     * On Linux the quota is read from \c cpu.max of cgroup v2, or from
+     * \c cpu.cfs_quota_us and \c cpu.cfs_period_us of cgroup v1, of the
+     * cgroup of the process and of its ancestors, the tightest one wins.
+     *
+     * @return      CPUs rounded up, \c 0 if unlimited.
+     */
+    static uint32_t cpuQuota();
+
+    /**
+     * @brief       Get count of CPUs a CPU quota allows.
+     *
+     * @param[in]   cgroupRoot      Mount point of cgroup filesystems, like
+     *                              \c "/sys/fs/cgroup".
+     * @param[in]   cgroups         Content of \c /proc/self/cgroup.
+     *
+     * @return      CPUs rounded up, \c 0 if unlimited.
+     */
+    static uint32_t cpuQuota(const ::std::string &cgroupRoot,
+                             const ::std::string &cgroups);
+
+    /**
+     * @brief       Get count of CPUs the process can use, the smaller of the
+     *              CPUs it may run on and its CPU quota.
+     *
+     * @return      Count of CPUs, at least \c 1.
+     */
+    static uint32_t availableCpuCount();
+
+    /**
+     * @brief       Pin current thread to a CPU.
+     *
+     * @param[in]   cpu         CPU.
+     *
+     * @return      Result.
+     */
+    static Result<void, Error> pinCurrentThread(uint32_t cpu);
+
+    /**
+     * @brief       Parse CPU list like \c "0-3,8,10-11".
+     *
+     * @param[in]   list        List to parse.
+     *
+     * @return      CPUs on success, error if the list is illegal.
+     */
+    static Result<::std::vector<uint32_t>, Error>
+        parseCpuList(const ::std::string &list);
+};
+
+} // namespace remotePortMapper
@@ -0,0 +1,387 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include <common/error/error.h>
+#include <common/functional/move_only_function.h>
+#include <common/thread_pool/thread_pool.h>
+#include <common/types/result.h>
+
+namespace remotePortMapper {
+
+template<typename T>
+class Future;
+
+template<typename T>
+class Promise;
+
+/**
+ * @brief   Value type of future from the return type of a function.
+ */
+template<typename>
+struct FutureValue;
+
+/**
+ * @brief   Value type of future from the return type of a function.
+ *
+ * @tparam  T   Type of the value.
+ */
+template<typename T>
+struct FutureValue<Result<T, Error>> {
+    using type = T; ///< Type of the value.
+};
+
+/**
+ * @brief   Value type of future from a function and its arguments.
+ *
+ * @tparam  Function    Type of the function, called as an lvalue.
+ * @tparam  Args        Types of the arguments.
+ */
+template<typename Function, typename... Args>
+using FutureValueOf = typename FutureValue<
+    ::std::invoke_result_t<::std::decay_t<Function> &, Args...>>::type;
+
+/**
+ * @brief   Shared state of a future and its promise.
+ *
+ * The state is the only allocation of a future. The result is either taken
+ * by \c Future::get() or passed to the continuation.
+ *
+ * @tparam  T   Type of the value.
+ */
+template<typename T>
+class FutureState {
+    friend class Future<T>;
+    friend class Promise<T>;
+
+  public:
+    /**
+     * @brief   Continuation.
+     */
+    using Continuation = MoveOnlyFunction<void(Result<T, Error>)>;
+
+  private:
+    /**
+     * @brief   Status.
+     */
+    enum class Status {
+        Pending, ///< No result.
+        Ready,   ///< Result set.
+        Taken    ///< Result taken by \c get() or a continuation.
+    };
+
+  private:
+    ::std::mutex                m_lock;         ///< Lock.
+    ::std::condition_variable   m_cond;         ///< Condition of result.
+    Status                      m_status;       ///< Status.
+    Result<T, Error>            m_result;       ///< Result.
+    Continuation                m_continuation; ///< Continuation.
+    bool                        m_schedule;     ///< Queue the continuation.
+    ::std::weak_ptr<ThreadPool> m_threadPool;   ///< Thread pool.
+
+  public:
+    /**
+     * @brief       Constructor.
+     *
+     * @param[in]   threadPool      Thread pool to run continuations.
+     */
+    inline FutureState(::std::weak_ptr<ThreadPool> threadPool);
+
+    FutureState(const FutureState &) = delete;
+    FutureState(FutureState &&)      = delete;
+
+    /**
+     * @brief       Destructor.
+     */
+    inline ~FutureState() = default;
+
+  private:
+    /**
+     * @brief       Set result, panics if already set.
+     *
+     * @param[in]   result          Result.
+     */
+    inline void setResult(Result<T, Error> result);
+
+    /**
+     * @brief       Set continuation, called at once in current thread if the
+     *              result is ready.
+     *
+     * @param[in]   continuation    Continuation.
+     * @param[in]   schedule        \c true to queue the continuation to the
+     *                              pool when the result is set later,
+     *                              \c false to call it where the result is
+     *                              set.
+     */
+    inline void setContinuation(Continuation continuation, bool schedule);
+
+    /**
+     * @brief       Wait and take the result.
+     *
+     * @return      Result.
+     */
+    inline Result<T, Error> take();
+};
+
+/**
+ * @brief   Future of \c Result<T, Error>.
+ *
+ * A future is consumed by either \c get() or \c then().
+ *
+ * @tparam  T   Type of the value.
+ */
+template<typename T>
+class Future {
+    friend class Promise<T>;
+
+    template<typename U>
+    friend Future<::std::vector<Result<U, Error>>>
+        whenAll(::std::vector<Future<U>> futures);
+
+    template<typename U>
+    friend Future<::std::pair<::std::size_t, Result<U, Error>>>
+        whenAny(::std::vector<Future<U>> futures);
+
+  private:
+    ::std::shared_ptr<FutureState<T>> m_state; ///< State.
+
+  public:
+    /**
+     * @brief       Constructor, the future is invalid.
+     */
+    inline Future() = default;
+
+    Future(const Future &) = delete;
+
+    /**
+     * @brief       Move constructor.
+     *
+     * @param[in]   future      Future to move.
+     */
+    inline Future(Future &&future) = default;
+
+    /**
+     * @brief       Destructor.
+     */
+    inline ~Future() = default;
+
+  private:
+    /**
+     * @brief       Constructor.
+     *
+     * @param[in]   state       State.
+     */
+    inline Future(::std::shared_ptr<FutureState<T>> state);
+
+  public:
+    /**
+     * @brief       Make a ready future, continuations of it run at once.
+     *
+     * @param[in]   result          Result.
+     * @param[in]   threadPool      Thread pool to run later continuations.
+     *
+     * @return      Future.
+     */
+    static inline Future
+        makeReady(Result<T, Error>              result,
+                  ::std::shared_ptr<ThreadPool> threadPool = nullptr);
+
+    /**
+     * @brief       Check if the future is valid.
+     *
+     * @return      \c true if valid, \c false if consumed or empty.
+     */
+    inline bool valid() const;
+
+    /**
+     * @brief       Check if the result is ready.
+     *
+     * @return      \c true if ready, \c false if not.
+     */
+    inline bool ready() const;
+
+    /**
+     * @brief       Wait and get the result, the future is consumed. Blocks
+     *              current thread, use \c then() on workers.
+     *
+     * @return      Result.
+     */
+    inline Result<T, Error> get();
+
+    /**
+     * @brief       Add a continuation, the future is consumed.
+     *
+     * If the result is ready, the function runs at once in current thread.
+     * Otherwise it is queued to the pool of the future when the result is
+     * set, or runs where the result is set if the pool has gone.
+     *
+     * @tparam      Function        Type of the function.
+     *
+     * @param[in]   function        Function called with \c Result<T, Error>,
+     *                              returns \c Result<U, Error>.
+     *
+     * @return      Future of the result of the function.
+     */
+    template<typename Function>
+        requires ::std::is_invocable<::std::decay_t<Function> &,
+                                     Result<T, Error>>::value
+    inline Future<FutureValueOf<Function, Result<T, Error>>>
+        then(Function &&function);
+
+    /**
+     * @brief       Get the thread pool of the future.
+     *
+     * @return      Thread pool or \c nullptr.
+     */
+    inline ::std::shared_ptr<ThreadPool> threadPool() const;
+
+  public:
+    /**
+     * @brief       Operator=.
+     *
+     * @param[in]   future      Future to move.
+     *
+     * @return      *this.
+     */
+    inline Future &operator=(Future &&future) = default;
+
+    Future &operator=(const Future &) = delete;
+
+  private:
+    /**
+     * @brief       Call a function with the result where it is set, for
+     *              combinators.
+     *
+     * @param[in]   continuation    Continuation.
+     */
+    inline void onResult(typename FutureState<T>::Continuation continuation);
+};
+
+/**
+ * @brief   Promise of \c Result<T, Error>.
+ *
+ * A promise destroyed without a result sets \c ErrorCode::BrokenPromise.
+ *
+ * @tparam  T   Type of the value.
+ */
+template<typename T>
+class Promise {
+  private:
+    ::std::shared_ptr<FutureState<T>> m_state; ///< State.
+    bool m_futureRetrieved; ///< If the future has been retrieved.
+
+  public:
+    /**
+     * @brief       Constructor.
+     *
+     * @param[in]   threadPool      Thread pool to run continuations,
+     *                              \c nullptr to run them where the result
+     *                              is set.
+     */
+    inline Promise(::std::shared_ptr<ThreadPool> threadPool = nullptr);
+
+    Promise(const Promise &) = delete;
+
+    /**
+     * @brief       Move constructor.
+     *
+     * @param[in]   promise     Promise to move.
+     */
+    inline Promise(Promise &&promise);
+
+    /**
+     * @brief       Destructor.
+     */
+    inline ~Promise();
+
+  public:
+    /**
+     * @brief       Get the future, panics if called twice.
+     *
+     * @return      Future.
+     */
+    inline Future<T> future();
+
+    /**
+     * @brief       Set result, panics if already set.
+     *
+     * @param[in]   result      Result.
+     */
+    inline void setResult(Result<T, Error> result);
+
+  public:
+    /**
+     * @brief       Operator=.
+     *
+     * @param[in]   promise     Promise to move.
+     *
+     * @return      *this.
+     */
+    inline Promise &operator=(Promise &&promise);
+
+    Promise &operator=(const Promise &) = delete;
+
+  private:
+    /**
+     * @brief       Set \c ErrorCode::BrokenPromise if no result is set.
+     */
+    inline void breakPromise();
+};
+
+/**
+ * @brief       Run a function on a thread pool.
+ *
+ * @tparam      Function        Type of the function.
+ *
+ * @param[in]   threadPool      Thread pool.
+ * @param[in]   function        Function returns \c Result<T, Error>.
+ * @param[in]   priority        Priority.
+ *
+ * @return      Future of the result of the function.
+ */
+template<typename Function>
+    requires ::std::is_invocable<::std::decay_t<Function> &>::value
+inline Future<FutureValueOf<Function>>
+    submit(const ::std::shared_ptr<ThreadPool> &threadPool,
+           Function                          &&function,
+           ThreadPoolPriority priority = ThreadPoolPriority::Normal);
+
+/**
+ * @brief       Wait for all futures.
+ *
+ * @tparam      T               Type of the value.
+ *
+ * @param[in]   futures         Futures, consumed.
+ *
+ * @return      Future of the results in the order of \c futures, always ok.
+ *              Continuations run on the pool of the first future.
+ */
+template<typename T>
+Future<::std::vector<Result<T, Error>>>
+    whenAll(::std::vector<Future<T>> futures);
+
+/**
+ * @brief       Wait for the first future.
+ *
+ * @tparam      T               Type of the value.
+ *
+ * @param[in]   futures         Futures, consumed.
+ *
+ * @return      Future of the index and the result of the first future to be
+ *              ready, an error if \c futures is empty. Continuations run on
+ *              the pool of the first future.
+ */
+template<typename T>
+Future<::std::pair<::std::size_t, Result<T, Error>>>
+    whenAny(::std::vector<Future<T>> futures);
+
+} // namespace remotePortMapper
+
+#include <common/thread_pool/future.hpp>
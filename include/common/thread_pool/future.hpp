@@ -0,0 +1,403 @@
+#pragma once
+
+#include <common/logger/logger.h>
+
+#include <common/thread_pool/future.h>
+
+namespace remotePortMapper {
+
+/**
+ * @brief       Constructor.
+ */
+template<typename T>
+inline FutureState<T>::FutureState(::std::weak_ptr<ThreadPool> threadPool) :
+    m_status(Status::Pending), m_schedule(false),
+    m_threadPool(::std::move(threadPool))
+{}
+
+/**
+ * @brief       Set result.
+ */
+template<typename T>
+inline void FutureState<T>::setResult(Result<T, Error> result)
+{
+    ::std::unique_lock lock(m_lock);
+    if (m_status != Status::Pending) {
+        panic("Result of future has been set twice.");
+    }
+
+    if (! m_continuation) {
+        m_result = ::std::move(result);
+        m_status = Status::Ready;
+        lock.unlock();
+        m_cond.notify_all();
+        return;
+    }
+
+    // Continue.
+    m_status          = Status::Taken;
+    auto continuation = ::std::move(m_continuation);
+    lock.unlock();
+    auto threadPool = m_schedule ? m_threadPool.lock() : nullptr;
+    if (threadPool != nullptr) {
+        threadPool->addTask(
+            [continuation = ::std::move(continuation),
+             result       = ::std::move(result)]() mutable -> void {
+                continuation(::std::move(result));
+            });
+    } else {
+        continuation(::std::move(result));
+    }
+}
+
+/**
+ * @brief       Set continuation.
+ */
+template<typename T>
+inline void FutureState<T>::setContinuation(Continuation continuation,
+                                            bool         schedule)
+{
+    ::std::unique_lock lock(m_lock);
+    if (m_status == Status::Pending) {
+        m_continuation = ::std::move(continuation);
+        m_schedule     = schedule;
+        return;
+    }
+
+    // Ready, skip scheduling.
+    m_status    = Status::Taken;
+    auto result = ::std::move(m_result);
+    lock.unlock();
+    continuation(::std::move(result));
+}
+
+/**
+ * @brief       Wait and take the result.
+ */
+template<typename T>
+inline Result<T, Error> FutureState<T>::take()
+{
+    ::std::unique_lock lock(m_lock);
+    m_cond.wait(lock, [this]() -> bool {
+        return m_status == Status::Ready;
+    });
+    m_status = Status::Taken;
+
+    return ::std::move(m_result);
+}
+
+/**
+ * @brief       Constructor.
+ */
+template<typename T>
+inline Future<T>::Future(::std::shared_ptr<FutureState<T>> state) :
+    m_state(::std::move(state))
+{}
+
+/**
+ * @brief       Make a ready future.
+ */
+template<typename T>
+inline Future<T> Future<T>::makeReady(Result<T, Error>              result,
+                                      ::std::shared_ptr<ThreadPool> threadPool)
+{
+    auto state      = ::std::make_shared<FutureState<T>>(threadPool);
+    state->m_result = ::std::move(result);
+    state->m_status = FutureState<T>::Status::Ready;
+
+    return Future(::std::move(state));
+}
+
+/**
+ * @brief       Check if the future is valid.
+ */
+template<typename T>
+inline bool Future<T>::valid() const
+{
+    return m_state != nullptr;
+}
+
+/**
+ * @brief       Check if the result is ready.
+ */
+template<typename T>
+inline bool Future<T>::ready() const
+{
+    if (m_state == nullptr) {
+        return false;
+    }
+
+    ::std::unique_lock lock(m_state->m_lock);
+    return m_state->m_status == FutureState<T>::Status::Ready;
+}
+
+/**
+ * @brief       Wait and get the result.
+ */
+template<typename T>
+inline Result<T, Error> Future<T>::get()
+{
+    if (m_state == nullptr) {
+        panic("Invalid future.");
+    }
+
+    auto state = ::std::move(m_state);
+    return state->take();
+}
+
+/**
+ * @brief       Add a continuation.
+ */
+template<typename T>
+template<typename Function>
+    requires ::std::is_invocable<::std::decay_t<Function> &,
+                                 Result<T, Error>>::value
+inline Future<FutureValueOf<Function, Result<T, Error>>>
+    Future<T>::then(Function &&function)
+{
+    using U = FutureValueOf<Function, Result<T, Error>>;
+    if (m_state == nullptr) {
+        panic("Invalid future.");
+    }
+
+    auto       state = ::std::move(m_state);
+    Promise<U> promise(state->m_threadPool.lock());
+    Future<U>  ret = promise.future();
+    state->setContinuation(
+        [function = ::std::forward<Function>(function),
+         promise  = ::std::move(promise)](
+            Result<T, Error> result) mutable -> void {
+            promise.setResult(function(::std::move(result)));
+        },
+        true);
+
+    return ret;
+}
+
+/**
+ * @brief       Get the thread pool of the future.
+ */
+template<typename T>
+inline ::std::shared_ptr<ThreadPool> Future<T>::threadPool() const
+{
+    if (m_state == nullptr) {
+        return nullptr;
+    }
+
+    return m_state->m_threadPool.lock();
+}
+
+/**
+ * @brief       Call a function with the result where it is set.
+ */
+template<typename T>
+inline void
+    Future<T>::onResult(typename FutureState<T>::Continuation continuation)
+{
+    auto state = ::std::move(m_state);
+    state->setContinuation(::std::move(continuation), false);
+}
+
+/**
+ * @brief       Constructor.
+ */
+template<typename T>
+inline Promise<T>::Promise(::std::shared_ptr<ThreadPool> threadPool) :
+    m_state(::std::make_shared<FutureState<T>>(threadPool)),
+    m_futureRetrieved(false)
+{}
+
+/**
+ * @brief       Move constructor.
+ */
+template<typename T>
+inline Promise<T>::Promise(Promise &&promise) :
+    m_state(::std::move(promise.m_state)),
+    m_futureRetrieved(promise.m_futureRetrieved)
+{}
+
+/**
+ * @brief       Destructor.
+ */
+template<typename T>
+inline Promise<T>::~Promise()
+{
+    this->breakPromise();
+}
+
+/**
+ * @brief       Get the future.
+ */
+template<typename T>
+inline Future<T> Promise<T>::future()
+{
+    if (m_state == nullptr || m_futureRetrieved) {
+        panic("Future of promise has been retrieved.");
+    }
+
+    m_futureRetrieved = true;
+    return Future<T>(m_state);
+}
+
+/**
+ * @brief       Set result.
+ */
+template<typename T>
+inline void Promise<T>::setResult(Result<T, Error> result)
+{
+    if (m_state == nullptr) {
+        panic("Result of promise has been set.");
+    }
+
+    auto state = ::std::move(m_state);
+    state->setResult(::std::move(result));
+}
+
+/**
+ * @brief       Operator=.
+ */
+template<typename T>
+inline Promise<T> &Promise<T>::operator=(Promise &&promise)
+{
+    if (this != &promise) {
+        this->breakPromise();
+        m_state           = ::std::move(promise.m_state);
+        m_futureRetrieved = promise.m_futureRetrieved;
+    }
+
+    return *this;
+}
+
+/**
+ * @brief       Set \c ErrorCode::BrokenPromise if no result is set.
+ */
+template<typename T>
+inline void Promise<T>::breakPromise()
+{
+    if (m_state != nullptr) {
+        this->setResult(Result<T, Error>::makeError(
+            Error {ErrorCode::BrokenPromise,
+                   "Promise destroyed without a result."}));
+    }
+}
+
+/**
+ * @brief       Run a function on a thread pool.
+ */
+template<typename Function>
+    requires ::std::is_invocable<::std::decay_t<Function> &>::value
+inline Future<FutureValueOf<Function>>
+    submit(const ::std::shared_ptr<ThreadPool> &threadPool,
+           Function                          &&function,
+           ThreadPoolPriority                  priority)
+{
+    using T = FutureValueOf<Function>;
+    Promise<T> promise(threadPool);
+    Future<T>  ret = promise.future();
+    threadPool->addTask(
+        [function = ::std::forward<Function>(function),
+         promise  = ::std::move(promise)]() mutable -> void {
+            promise.setResult(function());
+        },
+        priority);
+
+    return ret;
+}
+
+/**
+ * @brief       Wait for all futures.
+ */
+template<typename T>
+Future<::std::vector<Result<T, Error>>>
+    whenAll(::std::vector<Future<T>> futures)
+{
+    using Results = ::std::vector<Result<T, Error>>;
+
+    /**
+     * @brief   Shared state of the futures.
+     */
+    struct State {
+        Results                      results;   ///< Results.
+        ::std::atomic<::std::size_t> remaining; ///< Futures not ready.
+        Promise<Results>             promise;   ///< Promise.
+
+        /**
+         * @brief       Constructor.
+         *
+         * @param[in]   count           Count of futures.
+         * @param[in]   threadPool      Thread pool.
+         */
+        State(::std::size_t count, ::std::shared_ptr<ThreadPool> threadPool) :
+            results(count), remaining(count), promise(::std::move(threadPool))
+        {}
+    };
+
+    if (futures.empty()) {
+        return Future<Results>::makeReady(Result<Results, Error>::makeOk());
+    }
+
+    // The last future ready sets the promise, its write happens after all
+    // other results are written.
+    auto state = ::std::make_shared<State>(futures.size(),
+                                           futures.front().threadPool());
+    auto ret   = state->promise.future();
+    for (::std::size_t i = 0; i < futures.size(); ++i) {
+        futures[i].onResult([state, i](Result<T, Error> result) -> void {
+            state->results[i] = ::std::move(result);
+            if (state->remaining.fetch_sub(1, ::std::memory_order_acq_rel)
+                == 1) {
+                state->promise.setResult(Result<Results, Error>::makeOk(
+                    ::std::move(state->results)));
+            }
+        });
+    }
+
+    return ret;
+}
+
+/**
+ * @brief       Wait for the first future.
+ */
+template<typename T>
+Future<::std::pair<::std::size_t, Result<T, Error>>>
+    whenAny(::std::vector<Future<T>> futures)
+{
+    using Value = ::std::pair<::std::size_t, Result<T, Error>>;
+
+    /**
+     * @brief   Shared state of the futures.
+     */
+    struct State {
+        ::std::atomic<bool> done;    ///< If a future is ready.
+        Promise<Value>      promise; ///< Promise.
+
+        /**
+         * @brief       Constructor.
+         *
+         * @param[in]   threadPool      Thread pool.
+         */
+        State(::std::shared_ptr<ThreadPool> threadPool) :
+            done(false), promise(::std::move(threadPool))
+        {}
+    };
+
+    if (futures.empty()) {
+        return Future<Value>::makeReady(Result<Value, Error>::makeError(
+            Error {ErrorCode::InvalidValue, "No future to wait."}));
+    }
+
+    auto state = ::std::make_shared<State>(futures.front().threadPool());
+    auto ret   = state->promise.future();
+    for (::std::size_t i = 0; i < futures.size(); ++i) {
+        futures[i].onResult([state, i](Result<T, Error> result) -> void {
+            if (! state->done.exchange(true)) {
+                state->promise.setResult(
+                    Result<Value, Error>::makeOk(i, ::std::move(result)));
+            }
+        });
+    }
+
+    return ret;
+}
+
+} // namespace remotePortMapper
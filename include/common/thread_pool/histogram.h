@@ -0,0 +1,106 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <bit>
+#include <cstdint>
+
+namespace remotePortMapper {
+
+/**
+ * @brief   Snapshot of histogram.
+ */
+struct HistogramSnapshot {
+    /// Count of buckets, bucket \c 0 counts value \c 0 and bucket \c i
+    /// counts values in [2^(i-1), 2^i).
+    static inline constexpr unsigned int bucketCount = 65;
+
+    uint64_t                             count;   ///< Count of values.
+    uint64_t                             sum;     ///< Sum of values.
+    uint64_t                             max;     ///< Maximum value.
+    ::std::array<uint64_t, bucketCount> buckets; ///< Count of each bucket.
+
+    /**
+     * @brief       Get mean value.
+     *
+     * @return      Mean value, \c 0 if empty.
+     */
+    double mean() const;
+
+    /**
+     * @brief       Get a percentile.
+     *
+     * @param[in]   percentile      Percentile in [0, 100].
+     *
+     * @return      Upper bound of the bucket the percentile falls in, never
+     *              greater than \c max.
+     */
+    uint64_t percentile(double percentile) const;
+
+    /**
+     * @brief       Merge another snapshot.
+     *
+     * @param[in]   snapshot        Snapshot to merge.
+     *
+     * @return      Reference of this.
+     */
+    HistogramSnapshot &operator+=(const HistogramSnapshot &snapshot);
+};
+
+/**
+ * @brief   Histogram with power-of-two buckets.
+ *
+ * Recording is wait-free, a bucket increment, a sum increment and a load of
+ * the maximum with relaxed ordering. Histograms written by one thread, such
+ * as the ones of a worker, never bounce cache lines.
+ */
+class Histogram {
+  private:
+    ::std::array<::std::atomic<uint64_t>, HistogramSnapshot::bucketCount>
+                            m_buckets; ///< Count of each bucket.
+    ::std::atomic<uint64_t> m_sum;     ///< Sum of values.
+    ::std::atomic<uint64_t> m_max;     ///< Maximum value.
+
+  public:
+    /**
+     * @brief       Constructor.
+     */
+    Histogram();
+
+    Histogram(const Histogram &) = delete;
+    Histogram(Histogram &&)      = delete;
+
+    /**
+     * @brief       Destructor.
+     */
+    ~Histogram() = default;
+
+  public:
+    /**
+     * @brief       Record a value.
+     *
+     * @param[in]   value       Value.
+     */
+    inline void record(uint64_t value)
+    {
+        m_buckets[static_cast<unsigned int>(::std::bit_width(value))]
+            .fetch_add(1, ::std::memory_order_relaxed);
+        m_sum.fetch_add(value, ::std::memory_order_relaxed);
+
+        uint64_t max = m_max.load(::std::memory_order_relaxed);
+        while (value > max
+               && ! m_max.compare_exchange_weak(max, value,
+                                                ::std::memory_order_relaxed)) {
+        }
+    }
+
+    /**
+     * @brief       Take a snapshot.
+     *
+     * @return      Snapshot, values recorded concurrently may be partially
+     *              included.
+     */
+    HistogramSnapshot snapshot() const;
+};
+
+} // namespace remotePortMapper
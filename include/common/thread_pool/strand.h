@@ -0,0 +1,115 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+
+#include <common/interfaces/i_create_shared_function.h>
+#include <common/thread_pool/thread_pool.h>
+
+namespace remotePortMapper {
+
+/**
+ * @brief   Serialized executor on a thread pool.
+ *
+ * Tasks posted to one strand run in FIFO order and never concurrently, tasks
+ * of different strands run in parallel. Producers push to a lock-free stack
+ * and only the one who makes the strand non-empty schedules a drain task on
+ * the pool, so there is at most one drain task of a strand at any time.
+ *
+ * The strand holds a weak reference to the pool like alarms do, so a drain
+ * task never destroys the pool on one of its workers. Tasks posted after the
+ * pool is destroyed never run.
+ */
+class Strand :
+    public ::std::enable_shared_from_this<Strand>,
+    virtual public ICreateSharedFunc<Strand, ::std::shared_ptr<ThreadPool>> {
+    CREATE_SHARED(Strand, ::std::shared_ptr<ThreadPool>);
+
+  public:
+    /**
+     * @brief   Task to call.
+     */
+    using Task = ThreadPool::Task;
+
+  private:
+    /**
+     * @brief       Node of queued task.
+     */
+    struct Node;
+
+  private:
+    /// Maximum count of tasks to run in one drain task before yielding the
+    /// worker to other tasks.
+    static inline constexpr ::std::size_t _drainBatch = 64;
+
+    static thread_local Strand *_currentStrand; ///< Strand running on thread.
+
+  private:
+    ::std::weak_ptr<ThreadPool> m_threadPool; ///< Thread pool.
+    ::std::atomic<Node *>
+        m_incoming; ///< Stack of posted tasks, newest first.
+    Node *m_ready; ///< Tasks taken by the drain, oldest first.
+    ::std::atomic<::std::size_t>
+        m_pendingTasks; ///< Count of posted tasks not finished.
+
+  private:
+    /**
+     * @brief       Constructor.
+     *
+     * @param[in]   threadPool      Thread pool to run tasks.
+     */
+    Strand(::std::shared_ptr<ThreadPool> threadPool);
+
+    Strand(const Strand &) = delete;
+    Strand(Strand &&)      = delete;
+
+  public:
+    /**
+     * @brief       Destructor.
+     */
+    virtual ~Strand();
+
+  public:
+    /**
+     * @brief       Get thread pool.
+     *
+     * @return      Thread pool, \c nullptr if destroyed.
+     */
+    ::std::shared_ptr<ThreadPool> threadPool() const;
+
+    /**
+     * @brief       Post a task.
+     *
+     * @param[in]   task            Task to run.
+     */
+    void post(Task task);
+
+    /**
+     * @brief       Check if current thread is running a task of the strand.
+     *
+     * @return      \c true if running in the strand, \c false if not.
+     */
+    bool runningInThisThread() const;
+
+  private:
+    /**
+     * @brief       Schedule a drain task on the pool.
+     */
+    void schedule();
+
+    /**
+     * @brief       Run queued tasks.
+     */
+    void drain();
+
+    /**
+     * @brief       Take the next task to run.
+     *
+     * @return      Node of the task, never \c nullptr while tasks are
+     *              pending.
+     */
+    Node *takeNode();
+};
+
+} // namespace remotePortMapper
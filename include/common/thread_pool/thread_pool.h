@@ -1,36 +1,258 @@
 #pragma once
 
+#include <array>
+#include <atomic>
 #include <chrono>
 #include <condition_variable>
+#include <cstdint>
 #include <functional>
 #include <map>
 #include <memory>
-#include <queue>
+#include <iterator>
+#include <mutex>
 #include <set>
+#include <span>
 #include <thread>
+#include <type_traits>
+#include <vector>
 
+#include <common/functional/function_ref.h>
 #include <common/functional/move_only_function.h>
 #include <common/interfaces/i_create_shared_function.h>
+#include <common/thread_pool/cpu_topology.h>
+#include <common/thread_pool/histogram.h>
+#include <common/thread_pool/timing_wheel.h>
+#include <common/thread_pool/virtual_clock.h>
+#include <common/types/ring_buffer.h>
 
 namespace remotePortMapper {
 
+/**
+ * @brief   Scheduler of thread pool.
+ */
+enum class ThreadPoolScheduler {
+    Global,      ///< All workers share one task queue.
+    WorkStealing ///< Each worker owns a deque and steals when idle.
+};
+
+/**
+ * @brief   Priority of task.
+ */
+enum class ThreadPoolPriority {
+    High,  ///< Control-plane work, heartbeats, handshakes and alarms.
+    Normal ///< Data-plane work.
+};
+
+/**
+ * @brief   Alarm store of thread pool.
+ */
+enum class ThreadPoolAlarmStore {
+    SortedMap,  ///< Alarms sorted by timepoint, O(log n) insert and cancel.
+    TimingWheel ///< Hierarchical timing wheel, O(1) insert and cancel.
+};
+
+/**
+ * @brief   What an idle worker does before it parks.
+ *
+ * An idle worker spins with a pause instruction, then yields, and parks on
+ * the condition variable at last. A spinning or yielding worker picks new
+ * tasks up without a futex wake and a context switch, but burns CPU.
+ */
+struct ThreadPoolIdlePolicy {
+    uint32_t spins;  ///< Count of pause instructions before yield.
+    uint32_t yields; ///< Count of yields before park.
+
+    /**
+     * @brief       Preset for low dispatch latency.
+     *
+     * @return      Policy.
+     */
+    static constexpr ThreadPoolIdlePolicy latencyOptimized()
+    {
+        return ThreadPoolIdlePolicy {.spins = 4096, .yields = 64};
+    }
+
+    /**
+     * @brief       Preset for low power, parks at once.
+     *
+     * @return      Policy.
+     */
+    static constexpr ThreadPoolIdlePolicy powerSaving()
+    {
+        return ThreadPoolIdlePolicy {.spins = 0, .yields = 0};
+    }
+};
+
+/**
+ * @brief   Worker metrics of thread pool.
+ */
+struct ThreadPoolWorkerMetrics {
+    ::std::size_t workers;        ///< Count of running workers.
+    ::std::size_t busyWorkers;    ///< Workers running tasks, elastic only.
+    ::std::size_t idleWorkers;    ///< Parked workers.
+    ::std::size_t minWorkers;     ///< Minimum count of workers.
+    ::std::size_t maxWorkers;     ///< Maximum count of workers.
+    uint64_t      spawnedWorkers; ///< Workers spawned when growing.
+    uint64_t      retiredWorkers; ///< Workers retired when shrinking.
+};
+
+/**
+ * @brief   Telemetry of a worker of thread pool.
+ */
+struct ThreadPoolWorkerTelemetry {
+    ::std::size_t              index;     ///< Index of the worker.
+    ::std::chrono::nanoseconds busyTime;  ///< Time not spinning or parked.
+    ::std::chrono::nanoseconds idleTime;  ///< Time spinning or parked.
+    double                     busyRatio; ///< Busy time over lifetime.
+};
+
+/**
+ * @brief   Telemetry of thread pool, times are in nanoseconds. Task
+ *          histograms only count sampled tasks.
+ */
+struct ThreadPoolTelemetry {
+    HistogramSnapshot queueDepth;    ///< Queued tasks when a task is taken.
+    HistogramSnapshot waitTime;      ///< Time from enqueue to start.
+    HistogramSnapshot runTime;       ///< Time a task runs.
+    HistogramSnapshot alarmLateness; ///< Time an alarm runs after deadline,
+                                     ///< a timer is recorded when queued.
+    ::std::vector<ThreadPoolWorkerTelemetry>
+        workers; ///< Running workers since they started.
+};
+
+/**
+ * @brief   Handle of a pooled timer of thread pool.
+ *
+ * A handle is two integers and owns nothing. The slot of a timer is reused
+ * once it fires or is canceled, the generation tells a stale handle from the
+ * timer reusing its slot.
+ */
+struct ThreadPoolTimerHandle {
+    uint32_t index      = 0; ///< Index of the slot.
+    uint32_t generation = 0; ///< Generation of the slot, \c 0 is invalid.
+};
+
+/**
+ * @brief   Options of thread pool.
+ */
+struct ThreadPoolOptions {
+    /// Count of workers, the minimum count if the pool is elastic. \c 0
+    /// means one more than \c CpuTopology::availableCpuCount(), which honors
+    /// the affinity mask and the cgroup CPU quota of the process.
+    ::std::size_t workers = 0;
+
+    /// Maximum count of workers. When all workers are running tasks and
+    /// more tasks are queued, the pool spawns a worker up to this count.
+    /// Not greater than \c workers means a fixed pool.
+    ::std::size_t maxWorkers = 0;
+
+    /// Idle period after which a worker above \c workers retires.
+    ::std::chrono::steady_clock::duration workerIdleTimeout
+        = ::std::chrono::seconds(30);
+
+    /// Scheduler.
+    ThreadPoolScheduler scheduler = ThreadPoolScheduler::Global;
+
+    /// Idle policy of workers.
+    ThreadPoolIdlePolicy idlePolicy = ThreadPoolIdlePolicy::powerSaving();
+
+    /// Maximum count of high priority tasks a worker runs in a row while
+    /// normal priority tasks are waiting, \c 0 means no limit.
+    uint32_t highPriorityBurst = 32;
+
+    /// A normal priority task added by a worker goes to the slot of the
+    /// worker and runs next on it while the cache is warm, the task it
+    /// displaces is queued as usual. The slot is never stolen, a task in it
+    /// waits until the task which added it returns, so a task must not block
+    /// waiting for a task it added.
+    bool lifoSlot = false;
+
+    /// Maximum count of tasks a worker runs from its slot in a row, then the
+    /// tasks it adds are queued as usual, \c 0 means no limit.
+    uint32_t lifoSlotBurst = 3;
+
+    /// A worker of a work-stealing pool takes from the injection queue
+    /// before its local deque once in this many lookups, so the injection
+    /// queue is never starved, \c 0 means never.
+    uint32_t injectionQueueInterval = 61;
+
+    /// CPU of each worker, worker \c i is pinned to \c cpus[i % size], an
+    /// empty map leaves workers unpinned. \c CpuTopology::cpus() gives the
+    /// detected CPUs ordered by NUMA node.
+    ::std::vector<uint32_t> cpus = {};
+
+    /// Alarm store.
+    ThreadPoolAlarmStore alarmStore = ThreadPoolAlarmStore::SortedMap;
+
+    /// Tick of timing wheels, alarms in the timing wheel store and pooled
+    /// timers fire at most one tick late.
+    ::std::chrono::steady_clock::duration alarmTick
+        = ::std::chrono::milliseconds(1);
+
+    /// Slack of alarms, an alarm may fire up to this late so that all alarms
+    /// due within the window fire in one wakeup of the alarm thread.
+    ::std::chrono::steady_clock::duration alarmSlack
+        = ::std::chrono::steady_clock::duration::zero();
+
+    /// Clock of alarms and pooled timers, \c nullptr means the steady clock.
+    /// With a virtual clock, deadlines are timepoints of that clock and they
+    /// fire only as it is advanced.
+    ::std::shared_ptr<VirtualClock> clock = nullptr;
+
+    /// Telemetry samples one task in this many, \c 0 turns telemetry off.
+    /// A sampled task costs three clock reads and a few relaxed increments
+    /// on cache lines of its worker, other tasks cost a counter decrement.
+    uint32_t telemetrySampleInterval = 16;
+};
+
 /**
  * @brief   Thread pool.
  */
 class ThreadPool :
     public ::std::enable_shared_from_this<ThreadPool>,
     virtual public ICreateSharedFunc<ThreadPool>,
-    virtual public ICreateSharedFunc<ThreadPool, ::std::size_t> {
+    virtual public ICreateSharedFunc<ThreadPool, ::std::size_t>,
+    virtual public ICreateSharedFunc<ThreadPool, ThreadPoolOptions> {
     CREATE_SHARED(ThreadPool);
     CREATE_SHARED(ThreadPool, ::std::size_t);
+    CREATE_SHARED(ThreadPool, ThreadPoolOptions);
+    friend class VirtualClock;
 
   public:
     /**
      * @brief   Task to call.
+     *
+     * Small captures are stored in the task. A task with a large capture
+     * constructed as \c Task(::std::allocator_arg, resource, function)
+     * allocates it from the memory resource instead of the global heap, for
+     * example from an arena of a connection released when it closes.
      */
     using Task = MoveOnlyFunction<void()>;
 
+    /**
+     * @brief   Options.
+     */
+    using Options = ThreadPoolOptions;
+
+    /**
+     * @brief   Handle of pooled timer.
+     */
+    using TimerHandle = ThreadPoolTimerHandle;
+
   private:
+    /**
+     * @brief       Queued task.
+     */
+    struct QueuedTask {
+        Task task; ///< Task.
+        ::std::chrono::steady_clock::time_point
+            enqueueTime; ///< Timepoint queued, the epoch if not sampled.
+    };
+
+    /**
+     * @brief       Worker.
+     */
+    struct Worker;
     /**
      * @brief       Asynchronous alarm object.
      */
@@ -41,33 +263,126 @@ class ThreadPool :
      */
     class AlarmTask;
 
+    /**
+     * @brief       Alarm store.
+     */
+    class AlarmStore;
+
+    /**
+     * @brief       Alarm store sorted by timepoint.
+     */
+    class SortedAlarmStore;
+
+    /**
+     * @brief       Alarm store based on timing wheel.
+     */
+    class TimingWheelAlarmStore;
+
+    /**
+     * @brief       Slot of pooled timer.
+     */
+    struct TimerSlot;
+
+    /**
+     * @brief       Store of pooled timers.
+     */
+    class TimerStore;
+
+    /**
+     * @brief       Shared state of a parallel loop.
+     */
+    struct ParallelForState;
+
+    /**
+     * @brief       Result of running a task on a worker.
+     */
+    enum class WorkerRun {
+        Idle,    ///< No task found.
+        Ran,     ///< A task ran.
+        Detached ///< A task ran and destroyed the pool.
+    };
+
+  private:
+    /// Count of priorities.
+    static inline constexpr ::std::size_t _priorityCount = 2;
+
+    /// Capacity of local deques reserved by workers, so the buffers are
+    /// first touched on the NUMA node of the worker.
+    static inline constexpr ::std::size_t _localDequeCapacity = 256;
+
   private:
+    ThreadPoolScheduler     m_scheduler;         ///< Scheduler.
+    ThreadPoolIdlePolicy    m_idlePolicy;        ///< Idle policy.
+    uint32_t                m_highPriorityBurst; ///< Starvation guard.
+    bool                    m_lifoSlot;          ///< If workers use slots.
+    uint32_t                m_lifoSlotBurst;     ///< Slot starvation guard.
+    uint32_t m_injectionQueueInterval; ///< Injection queue starvation guard.
+    ::std::vector<uint32_t> m_cpus;              ///< CPU map of workers.
+    ::std::size_t           m_minWorkers;        ///< Minimum count of workers.
+    ::std::size_t           m_maxWorkers;        ///< Maximum count of workers.
+    ::std::chrono::steady_clock::duration
+        m_workerIdleTimeout; ///< Idle period before retiring.
+    uint32_t m_telemetrySampleInterval; ///< Telemetry samples 1 in this.
+
     // Tasks.
-    ::std::mutex m_taskQueueLock; ///< Lock for task queue.
+    ::std::mutex m_taskQueueLock; ///< Lock for task queues.
     ::std::condition_variable
-                       m_taskQueueCond; ///< Condition variable for task queue.
-    ::std::queue<Task> m_taskQueue;     ///< Task queue.
+        m_taskQueueCond; ///< Condition variable for task queues.
+    ::std::array<RingBuffer<QueuedTask>, _priorityCount>
+        m_taskQueues; ///< Task queue of each priority, the normal one is
+                      ///< the injection queue when stealing.
+    ::std::array<::std::atomic<::std::size_t>, _priorityCount>
+        m_taskQueueSizes; ///< Size of each task queue.
+    ::std::atomic<::std::size_t>
+        m_pendingTasks; ///< Count of tasks in all queues.
+    ::std::atomic<::std::size_t> m_idleWorkers; ///< Count of parked workers.
 
     // Alarms.
     ::std::mutex              m_alarmLock; ///< Lock vor alarm.
     ::std::condition_variable m_alarmCond; ///< Condition variable for alarm.
-    ::std::map<::std::chrono::steady_clock::time_point,
-               ::std::set<::std::shared_ptr<AsyncAlarm>>>
-                  m_alarmMap;    ///< Sorted alarms.
-    ::std::thread m_alarmThread; ///< Thread to handle alarm.
+    ::std::unique_ptr<AlarmStore> m_alarmStore;  ///< Alarms.
+    ::std::atomic<AsyncAlarm *>
+        m_alarmInbox; ///< Stack of alarms scheduled or canceled, newest first.
+    ::std::atomic<::std::chrono::steady_clock::rep>
+        m_alarmWakeup; ///< When the sleeping alarm thread wakes, the minimum
+                       ///< while it is awake.
+    ::std::thread                 m_alarmThread; ///< Thread to handle alarm.
+    ::std::chrono::steady_clock::duration m_alarmSlack; ///< Slack of alarms.
+    ::std::shared_ptr<VirtualClock> m_clock; ///< Virtual clock of alarms.
+    ::std::set<::std::shared_ptr<AsyncAlarm>>
+        m_periodicAlarms; ///< Periodic alarms not canceled.
+    ::std::unique_ptr<TimerStore> m_timerStore; ///< Pooled timers.
+    Histogram m_alarmLateness; ///< Time an alarm runs after deadline.
 
     // Workers.
-    ::std::vector<::std::thread> m_workers; ///< Workers.
-    volatile bool                m_running; ///< Running flag.
+    ::std::mutex m_workersLock; ///< Lock to spawn workers.
+    ::std::vector<::std::unique_ptr<Worker>>
+        m_workers; ///< Slots of workers, never resized after construction.
+    ::std::atomic<::std::size_t> m_activeWorkers; ///< Count of workers.
+    ::std::atomic<::std::size_t> m_busyWorkers;   ///< Workers running tasks.
+    ::std::atomic<uint64_t>      m_spawnedWorkers; ///< Workers spawned.
+    ::std::atomic<uint64_t>      m_retiredWorkers; ///< Workers retired.
+    ::std::atomic<bool>          m_running;        ///< Running flag.
+
+    static thread_local Worker *_currentWorker; ///< Worker of current thread.
+    static thread_local uint32_t
+        _sampleCountdown; ///< Tasks to enqueue before sampling one.
 
   private:
     /**
      * @brief       Constructor.
      *
-     * @param[in]   workers         Counnt of workers.
+     * @param[in]   workers         Counnt of workers, \c 0 means the
+     *                              default count.
      */
-    ThreadPool(::std::size_t workers
-               = ::std::thread::hardware_concurrency() + 1);
+    ThreadPool(::std::size_t workers = 0);
+
+    /**
+     * @brief       Constructor.
+     *
+     * @param[in]   options         Options.
+     */
+    ThreadPool(ThreadPoolOptions options);
 
     ThreadPool(const ThreadPool &) = delete;
     ThreadPool(ThreadPool &&)      = delete;
@@ -79,10 +394,150 @@ class ThreadPool :
     virtual ~ThreadPool();
 
   public:
+    /**
+     * @brief       Create a pool on each NUMA node.
+     *
+     * Each pool has one worker pinned to each CPU of its node, other options
+     * are shared.
+     *
+     * @param[in]   options         Options, \c workers and \c cpus are
+     *                              ignored.
+     *
+     * @return      Pools ordered as \c CpuTopology::numaNodes() on success.
+     */
+    static Result<::std::vector<::std::shared_ptr<ThreadPool>>, Error>
+        createPerNumaNode(ThreadPoolOptions options = {});
+
+    /**
+     * @brief       Get CPU map of workers.
+     *
+     * @return      CPU map, empty if workers are not pinned.
+     */
+    const ::std::vector<uint32_t> &cpus() const;
+
+    /**
+     * @brief       Get count of running workers.
+     *
+     * @return      Count of workers.
+     */
+    ::std::size_t workerCount() const;
+
+    /**
+     * @brief       Get worker metrics.
+     *
+     * @return      Metrics.
+     */
+    ThreadPoolWorkerMetrics workerMetrics() const;
+
+    /**
+     * @brief       Get telemetry.
+     *
+     * @return      Telemetry, histograms are empty if telemetry is off.
+     */
+    ThreadPoolTelemetry telemetry() const;
+
+    /**
+     * @brief       Get scheduler.
+     *
+     * @return      Scheduler.
+     */
+    ThreadPoolScheduler scheduler() const;
+
+    /**
+     * @brief       Get count of queued tasks of a priority.
+     *
+     * @param[in]   priority        Priority.
+     *
+     * @return      Count of queued tasks, local deques of workers are
+     *              counted as normal priority.
+     */
+    ::std::size_t queueDepth(ThreadPoolPriority priority) const;
+
     /**
      * @brief       Add task.
+     *
+     * Workers take high priority tasks first. When the pool is
+     * work-stealing and the caller is one of its workers, a normal priority
+     * task is pushed to the local deque of the caller, otherwise tasks are
+     * pushed to the shared task queue of their priority.
+     *
+     * @param[in]   task            Task to run.
+     * @param[in]   priority        Priority.
+     */
+    void addTask(Task               task,
+                 ThreadPoolPriority priority = ThreadPoolPriority::Normal);
+
+    /**
+     * @brief       Add tasks in one batch with normal priority.
+     *
+     * The tasks are queued under a single lock acquisition and at most one
+     * parked worker is woken for each task.
+     *
+     * @tparam      Iterator        Type of the iterator.
+     *
+     * @param[in]   begin           Beginning of the tasks, tasks are moved.
+     * @param[in]   end             End of the tasks.
      */
-    void addTask(Task task);
+    template<typename Iterator>
+        requires ::std::is_same<typename ::std::iterator_traits<
+                                    Iterator>::value_type,
+                                Task>::value
+    void addTasks(Iterator begin, Iterator end);
+
+    /**
+     * @brief       Add tasks in one batch with normal priority.
+     *
+     * @param[in]   tasks           Tasks, tasks are moved.
+     */
+    void addTasks(::std::span<Task> tasks);
+
+    /**
+     * @brief       Run a function over a range in parallel and wait.
+     *
+     * The range is split into chunks of \c grain indices. Workers claim
+     * chunks one by one, the caller claims chunks too, so a loop makes
+     * progress even if all workers are busy. When the caller is a worker of
+     * this pool and the remaining chunks are running on other workers, it
+     * runs queued tasks of the pool while it waits instead of blocking.
+     *
+     * @tparam      Function        Type of the function.
+     *
+     * @param[in]   begin           Beginning of the range.
+     * @param[in]   end             End of the range.
+     * @param[in]   function        Function called as \c function(first,
+     *                              last) on each chunk [first, last), from
+     *                              several threads at once.
+     * @param[in]   grain           Count of indices in a chunk, \c 0 splits
+     *                              the range into four chunks per worker.
+     */
+    template<typename Function>
+        requires ::std::is_invocable<Function &,
+                                     ::std::size_t,
+                                     ::std::size_t>::value
+    void parallelFor(::std::size_t begin,
+                     ::std::size_t end,
+                     Function    &&function,
+                     ::std::size_t grain = 0);
+
+    /**
+     * @brief       Run functions in parallel and wait, the fork-join form of
+     *              \c parallelFor().
+     *
+     * @tparam      Functions       Types of the functions.
+     *
+     * @param[in]   functions       Functions.
+     */
+    template<typename... Functions>
+        requires(::std::is_invocable<Functions &>::value && ...)
+    void parallelInvoke(Functions &&...functions);
+
+    /**
+     * @brief       Get current time of alarms and pooled timers.
+     *
+     * @return      Current time of the virtual clock if any, otherwise of
+     *              the steady clock.
+     */
+    ::std::chrono::steady_clock::time_point now() const;
 
     /**
      * @brief       Add alarm.
@@ -95,7 +550,94 @@ class ThreadPool :
     ::std::shared_ptr<AsyncAlarm>
         addAlarm(::std::chrono::steady_clock::time_point timepoint, Task task);
 
+    /**
+     * @brief       Add periodic alarm, the task runs at \c timepoint and then
+     *              every \c period until the alarm is canceled or the pool is
+     *              destroyed. Runs never overlap and never drift, periods
+     *              missed while the pool is overloaded are skipped.
+     *
+     * @param[in]   timepoint       Timepoint of the first alarm.
+     * @param[in]   period          Period, must be positive.
+     * @param[in]   task            Task to run when alarm.
+     *
+     * @return      Alarm object.
+     */
+    ::std::shared_ptr<AsyncAlarm>
+        addPeriodicAlarm(::std::chrono::steady_clock::time_point timepoint,
+                         ::std::chrono::steady_clock::duration   period,
+                         Task                                    task);
+
+    /**
+     * @brief       Add pooled timer.
+     *
+     * Timers live in slots reused by later timers and are linked into a
+     * timing wheel intrusively, so adding, canceling and firing a timer
+     * allocate nothing once the pool of slots has grown to the peak count
+     * of pending timers. A timer fires at most one \c alarmTick late, its
+     * task is queued with high priority as it is.
+     *
+     * @param[in]   timepoint       Timepoint to fire.
+     * @param[in]   task            Task to run when fired.
+     *
+     * @return      Handle of the timer.
+     */
+    TimerHandle addTimer(::std::chrono::steady_clock::time_point timepoint,
+                         Task                                    task);
+
+    /**
+     * @brief       Cancel pooled timer.
+     *
+     * @param[in]   handle          Handle of the timer.
+     *
+     * @return      \c true if canceled, \c false if the timer has fired, has
+     *              been canceled or the handle is invalid.
+     */
+    bool cancelTimer(TimerHandle handle);
+
   private:
+    /**
+     * @brief       Get the timepoint the alarm thread needs to wake up,
+     *              \c m_alarmLock must be held.
+     *
+     * @param[out]  timepoint       Timepoint, without the slack.
+     *
+     * @return      \c true if any alarm or timer is pending, \c false if
+     *              not.
+     */
+    bool nextAlarmTimepoint(
+        ::std::chrono::steady_clock::time_point &timepoint) const;
+
+    /**
+     * @brief       Wake the alarm thread if a new deadline is the earliest,
+     *              \c m_alarmLock must be held and the deadline must not be
+     *              inserted yet.
+     *
+     * @param[in]   deadline        New deadline.
+     */
+    void notifyAlarmThread(::std::chrono::steady_clock::time_point deadline);
+
+    /**
+     * @brief       Wake the alarm thread to check the time again.
+     */
+    void wakeAlarmThread();
+
+    /**
+     * @brief       Post an alarm scheduled or canceled to the alarm thread,
+     *              lock-free.
+     *
+     * @param[in]   alarm       Alarm.
+     * @param[in]   deadline    Deadline the alarm is scheduled to, the
+     *                          maximum if canceled.
+     */
+    void postAlarm(const ::std::shared_ptr<AsyncAlarm>    &alarm,
+                   ::std::chrono::steady_clock::time_point deadline);
+
+    /**
+     * @brief       Apply alarms posted to the inbox to the store,
+     *              \c m_alarmLock must be held.
+     */
+    void drainAlarmInbox();
+
     /**
      * @brief       Remove alarm.
      *
@@ -103,16 +645,241 @@ class ThreadPool :
      */
     void removeAlarm(::std::shared_ptr<AsyncAlarm> &alarm);
 
+    /**
+     * @brief       Insert a periodic alarm again for its next period.
+     *
+     * @param[in]   alarm       Alarm to rearm.
+     */
+    void rearmAlarm(::std::shared_ptr<AsyncAlarm> &alarm);
+
   private:
+    /**
+     * @brief       Get enqueue time of a task.
+     *
+     * @return      Current timepoint if the task is sampled, otherwise the
+     *              epoch.
+     */
+    inline ::std::chrono::steady_clock::time_point enqueueTime() const;
+
+    /**
+     * @brief       Convert a duration to nanoseconds for histograms.
+     *
+     * @param[in]   duration        Duration.
+     *
+     * @return      Nanoseconds, \c 0 if negative.
+     */
+    static inline uint64_t
+        nanoseconds(::std::chrono::steady_clock::duration duration);
+
     /**
      * @brief   Alarm thread function.
      */
     void alarmThread();
 
     /**
-     * @brief   Worker thread function.
+     * @brief       Start a worker in a slot, \c m_workersLock must be held.
+     *
+     * @param[in]   worker      Worker slot, must not be active.
+     */
+    void startWorker(Worker *worker);
+
+    /**
+     * @brief       Spawn a worker if the pool is elastic, all workers are
+     *              busy and tasks are queued.
+     */
+    void growWorkers();
+
+    /**
+     * @brief       Retire current worker if the pool has more workers than
+     *              the minimum, \c m_taskQueueLock must be held.
+     *
+     * @return      \c true if retired, \c false if not.
+     */
+    bool retireWorker();
+
+    /**
+     * @brief       Worker thread function.
+     *
+     * @param[in]   worker      Worker.
+     */
+    void workerThread(Worker *worker);
+
+    /**
+     * @brief       Take a task from the slot or the queues of a worker and
+     *              run it.
+     *
+     * @param[in]   worker      Worker, must be current worker.
+     * @param[in]   nested      \c true if the worker is already running a
+     *                          task which waits, so it is counted busy.
+     *
+     * @return      \c WorkerRun::Detached if the task dropped the last
+     *              reference to the pool, nothing of it may be touched then.
+     */
+    WorkerRun runWorkerTask(Worker *worker, bool nested);
+
+    /**
+     * @brief       Add the idle period of a worker which got a task.
+     *
+     * @param[in]   worker      Worker.
+     */
+    void finishIdle(Worker *worker);
+
+    /**
+     * @brief       Get the worker of current thread if it belongs to this
+     *              pool.
+     *
+     * @return      Worker or \c nullptr.
+     */
+    Worker *currentWorker() const;
+
+    /**
+     * @brief       Take the task in the slot of a worker, unless high
+     *              priority tasks are waiting.
+     *
+     * @param[in]   worker      Worker, must be current worker.
+     * @param[out]  task        Task taken.
+     *
+     * @return      \c true if taken, \c false if not.
+     */
+    bool takeLifoTask(Worker *worker, QueuedTask &task);
+
+    /**
+     * @brief       Find a task to run.
+     *
+     * @param[in]   worker      Worker to find task for.
+     * @param[out]  task        Task found.
+     *
+     * @return      \c true if found, \c false if not.
+     */
+    bool findTask(Worker *worker, QueuedTask &task);
+
+    /**
+     * @brief       Find a normal priority task to run.
+     *
+     * @param[in]   worker      Worker to find task for.
+     * @param[out]  task        Task found.
+     *
+     * @return      \c true if found, \c false if not.
+     */
+    bool findNormalTask(Worker *worker, QueuedTask &task);
+
+    /**
+     * @brief       Take a task from a shared task queue.
+     *
+     * @param[in]   priority    Priority of the queue.
+     * @param[out]  task        Task taken.
+     *
+     * @return      \c true if taken, \c false if the queue is empty.
+     */
+    bool takeSharedTask(ThreadPoolPriority priority, QueuedTask &task);
+
+    /**
+     * @brief       Steal a task from other workers.
+     *
+     * @param[in]   thief       Worker who steals.
+     * @param[out]  task        Task stolen.
+     *
+     * @return      \c true if stolen, \c false if nothing to steal.
+     */
+    bool stealTask(Worker *thief, QueuedTask &task);
+
+    /**
+     * @brief       Run a type-erased parallel loop and wait.
+     *
+     * @param[in]   begin       Beginning of the range.
+     * @param[in]   end         End of the range.
+     * @param[in]   grain       Count of indices in a chunk, \c 0 for auto.
+     * @param[in]   function    Function to call on a chunk.
+     */
+    void runParallelFor(
+        ::std::size_t                                    begin,
+        ::std::size_t                                    end,
+        ::std::size_t                                    grain,
+        FunctionRef<void(::std::size_t, ::std::size_t)> function);
+
+    /**
+     * @brief       Claim and run chunks of a parallel loop until none is
+     *              left.
+     *
+     * @param[in]   state       State of the loop.
      */
-    void workerThread();
+    static void runChunks(ParallelForState &state);
+
+    /**
+     * @brief       Wake parked workers.
+     *
+     * @param[in]   count       Count of workers needed.
+     */
+    void wakeWorkers(::std::size_t count = 1);
+
+    /**
+     * @brief       Wake parked workers with \c m_taskQueueLock held.
+     *
+     * @param[in]   count       Count of workers needed.
+     */
+    void wakeWorkersLocked(::std::size_t count);
+
+    /**
+     * @brief       Spin and yield as the idle policy says until there are
+     *              tasks to run.
+     *
+     * @return      \c true if there are tasks to run, \c false if the
+     *              worker should park.
+     */
+    bool spinWorker();
+
+    /**
+     * @brief       Park current worker until there are tasks to run.
+     *
+     * @return      \c false if the pool is stopped and drained, or the
+     *              worker retired.
+     */
+    bool parkWorker();
+};
+
+/**
+ * @brief       Worker.
+ */
+struct ThreadPool::Worker {
+    ThreadPool         *threadPool; ///< Thread pool.
+    ::std::size_t       index;      ///< Index of the worker.
+    ::std::thread       thread;     ///< Thread.
+    int64_t             cpu;        ///< CPU to pin, \c -1 if not pinned.
+    ::std::atomic<bool> active;     ///< If the slot has a running thread.
+    ::std::mutex        dequeLock;  ///< Lock of local deque.
+    RingBuffer<QueuedTask>
+        deque; ///< Local deque, the owner pops back, thieves pop front.
+    ::std::atomic<::std::size_t> dequeSize;  ///< Size of local deque.
+    uint32_t                     random;     ///< State to pick victims.
+    uint32_t                     highStreak; ///< High priority tasks in a row.
+    QueuedTask                   lifoTask;   ///< Task in the slot, owner only.
+    uint32_t                     lifoStreak; ///< Tasks from the slot in a row.
+    uint32_t                     lookups;    ///< Lookups of normal tasks.
+
+    // Telemetry.
+    Histogram queueDepth; ///< Queued tasks when a task is taken.
+    Histogram waitTime;   ///< Time from enqueue to start.
+    Histogram runTime;    ///< Time a task runs.
+    ::std::atomic<::std::chrono::steady_clock::time_point>
+        startTime; ///< Timepoint the thread started.
+    ::std::atomic<::std::chrono::steady_clock::time_point>
+        idleSince; ///< Timepoint becoming idle, the epoch if busy.
+    ::std::atomic<uint64_t> idleTime; ///< Idle time since started.
+};
+
+/**
+ * @brief       Shared state of a parallel loop, owned by the caller and the
+ *              helper tasks, which may start after the loop has finished.
+ */
+struct ThreadPool::ParallelForState {
+    FunctionRef<void(::std::size_t, ::std::size_t)>
+                  function; ///< Function, only valid until finished.
+    ::std::size_t begin;    ///< Beginning of the range.
+    ::std::size_t end;      ///< End of the range.
+    ::std::size_t grain;    ///< Count of indices in a chunk.
+    ::std::size_t chunks;   ///< Count of chunks.
+    ::std::atomic<::std::size_t> nextChunk;      ///< Next chunk to claim.
+    ::std::atomic<::std::size_t> finishedChunks; ///< Count of chunks run.
 };
 
 /**
@@ -120,14 +887,20 @@ class ThreadPool :
  */
 class ThreadPool::AsyncAlarm :
     public ::std::enable_shared_from_this<AsyncAlarm>,
+    private TimingWheelNode,
     virtual public ICreateSharedFunc<AsyncAlarm,
                                      ::std::chrono::steady_clock::time_point,
+                                     ::std::chrono::steady_clock::duration,
                                      Task,
                                      ::std::weak_ptr<ThreadPool>> {
     CREATE_SHARED(AsyncAlarm,
                   ::std::chrono::steady_clock::time_point,
+                  ::std::chrono::steady_clock::duration,
                   Task,
                   ::std::weak_ptr<ThreadPool>);
+    friend class ThreadPool;
+    friend class SortedAlarmStore;
+    friend class TimingWheelAlarmStore;
 
   private:
     /**
@@ -139,22 +912,45 @@ class ThreadPool::AsyncAlarm :
         Canceled ///< Alarm has been canceled.
     };
 
+    /// Value of \c m_nextDeadline once a one-shot alarm has fired.
+    static inline constexpr ::std::chrono::steady_clock::rep _fired
+        = ::std::chrono::steady_clock::time_point::min()
+              .time_since_epoch()
+              .count();
+
   private:
     ::std::chrono::steady_clock::time_point
-                                m_timepoint;  ///< Timepoint to alarm.
+        m_timepoint; ///< Timepoint to alarm.
+    ::std::chrono::steady_clock::duration
+        m_period; ///< Period, zero if not periodic.
+    ::std::chrono::steady_clock::time_point
+        m_deadline; ///< Timepoint of next alarm in the store. Written by
+                    ///< the alarm thread for one-shot alarms and while it
+                    ///< is neither stored nor posted for periodic ones.
+    ::std::atomic<::std::chrono::steady_clock::rep>
+        m_nextDeadline; ///< Deadline requested of a one-shot alarm.
     Task                        m_task;       ///< Task.
     ::std::atomic<Status>       m_status;     ///< Status.
     ::std::weak_ptr<ThreadPool> m_threadPool; ///< Thread pool.
+    ::std::shared_ptr<AsyncAlarm>
+        m_storeRef; ///< Reference held by intrusive alarm stores.
+    AsyncAlarm         *m_inboxNext; ///< Next alarm in the inbox.
+    ::std::atomic<bool> m_posted;    ///< If in the inbox.
+    ::std::shared_ptr<AsyncAlarm>
+         m_inboxRef; ///< Reference held by the inbox.
+    bool m_stored;   ///< If in the store, guarded by \c m_alarmLock.
 
   private:
     /**
      * @brief       Constructor.
      *
      * @param[in]   timepoint   Timepoint to alarm.
+     * @param[in]   period      Period, zero if not periodic.
      * @param[in]   task        Task.
      * @param[in]   threadPool  Thread pool.
      */
     AsyncAlarm(::std::chrono::steady_clock::time_point timepoint,
+               ::std::chrono::steady_clock::duration   period,
                Task                                    task,
                ::std::weak_ptr<ThreadPool>             threadPool);
 
@@ -171,21 +967,62 @@ class ThreadPool::AsyncAlarm :
     /**
      * @brief   Get timepoint to alarm.
      *
-     * @return  Timepoint to alarm.
+     * @return  Timepoint to alarm, the first one if periodic.
      */
     const ::std::chrono::steady_clock::time_point &timepoint() const;
 
     /**
-     * @brief   Cancel the alarm.
+     * @brief   Get period.
+     *
+     * @return  Period, zero if not periodic.
+     */
+    const ::std::chrono::steady_clock::duration &period() const;
+
+    /**
+     * @brief   Cancel the alarm, a periodic alarm is always cancelable.
      *
      * @return  \c true if canceled, \c false if alarmed.
      */
     bool cancel();
 
+    /**
+     * @brief   Move the deadline of a one-shot alarm, reusing the object.
+     *
+     * In lazy mode a later deadline is only recorded, when the earlier one
+     * comes the alarm is scheduled again instead of firing, so pushing back
+     * an idle timeout costs a compare-and-swap. An earlier deadline always
+     * moves the alarm at once.
+     *
+     * @param[in]   timepoint   New timepoint to alarm.
+     * @param[in]   lazy        If a later deadline is checked when the
+     *                          earlier one comes.
+     *
+     * @return  \c true if the alarm fires at the new timepoint, \c false if
+     *          it has fired, has been canceled or is periodic.
+     */
+    bool reschedule(::std::chrono::steady_clock::time_point timepoint,
+                    bool                                    lazy = false);
+
     /**
      * @brief   Run alarm task if not canceled or alarmed.
      */
     void alarm();
+
+  private:
+    /**
+     * @brief   Check a one-shot alarm whose deadline has come, it is marked
+     *          fired unless rescheduled later.
+     *
+     * @param[in]   now     Current time.
+     *
+     * @return  \c true if rescheduled later, the deadline is updated.
+     */
+    bool takeLaterDeadline(::std::chrono::steady_clock::time_point now);
+
+    /**
+     * @brief   Record lateness of the alarm to the pool.
+     */
+    void recordLateness();
 };
 
 /**
@@ -229,4 +1066,308 @@ class ThreadPool::AlarmTask {
     void operator()();
 };
 
+/**
+ * @brief       Alarm store, accessed with \c m_alarmLock held.
+ */
+class ThreadPool::AlarmStore {
+  public:
+    /**
+     * @brief       Destructor.
+     */
+    virtual ~AlarmStore() = default;
+
+  public:
+    /**
+     * @brief       Check if the store is empty.
+     *
+     * @return      \c true if empty, \c false if not.
+     */
+    virtual bool empty() const = 0;
+
+    /**
+     * @brief       Insert an alarm.
+     *
+     * @param[in]   alarm       Alarm to insert.
+     */
+    virtual void insert(const ::std::shared_ptr<AsyncAlarm> &alarm) = 0;
+
+    /**
+     * @brief       Remove an alarm.
+     *
+     * @param[in]   alarm       Alarm to remove.
+     */
+    virtual void remove(const ::std::shared_ptr<AsyncAlarm> &alarm) = 0;
+
+    /**
+     * @brief       Get the timepoint the store needs to be checked.
+     *
+     * @return      Timepoint, only valid if not empty.
+     */
+    virtual ::std::chrono::steady_clock::time_point nextTimepoint() const = 0;
+
+    /**
+     * @brief       Take expired alarms.
+     *
+     * @param[in]   now         Current timepoint.
+     * @param[out]  alarms      Expired alarms are appended to it.
+     */
+    virtual void
+        takeExpired(::std::chrono::steady_clock::time_point      now,
+                    ::std::vector<::std::shared_ptr<AsyncAlarm>> &alarms)
+        = 0;
+};
+
+/**
+ * @brief       Alarm store sorted by timepoint.
+ */
+class ThreadPool::SortedAlarmStore : public AlarmStore {
+  private:
+    ::std::map<::std::chrono::steady_clock::time_point,
+               ::std::set<::std::shared_ptr<AsyncAlarm>>>
+        m_alarmMap; ///< Sorted alarms.
+
+  public:
+    /**
+     * @brief       Constructor.
+     */
+    SortedAlarmStore() = default;
+
+    /**
+     * @brief       Destructor.
+     */
+    virtual ~SortedAlarmStore() = default;
+
+  public:
+    /**
+     * @brief       Check if the store is empty.
+     *
+     * @return      \c true if empty, \c false if not.
+     */
+    virtual bool empty() const override;
+
+    /**
+     * @brief       Insert an alarm.
+     *
+     * @param[in]   alarm       Alarm to insert.
+     */
+    virtual void insert(const ::std::shared_ptr<AsyncAlarm> &alarm) override;
+
+    /**
+     * @brief       Remove an alarm.
+     *
+     * @param[in]   alarm       Alarm to remove.
+     */
+    virtual void remove(const ::std::shared_ptr<AsyncAlarm> &alarm) override;
+
+    /**
+     * @brief       Get the timepoint the store needs to be checked.
+     *
+     * @return      Timepoint, only valid if not empty.
+     */
+    virtual ::std::chrono::steady_clock::time_point
+        nextTimepoint() const override;
+
+    /**
+     * @brief       Take expired alarms.
+     *
+     * @param[in]   now         Current timepoint.
+     * @param[out]  alarms      Expired alarms are appended to it.
+     */
+    virtual void
+        takeExpired(::std::chrono::steady_clock::time_point      now,
+                    ::std::vector<::std::shared_ptr<AsyncAlarm>> &alarms)
+            override;
+};
+
+/**
+ * @brief       Alarm store based on timing wheel.
+ */
+class ThreadPool::TimingWheelAlarmStore : public AlarmStore {
+  private:
+    ::std::chrono::steady_clock::time_point m_start; ///< Timepoint of tick 0.
+    ::std::chrono::steady_clock::duration   m_tick;  ///< Duration of a tick.
+    TimingWheel                             m_wheel; ///< Timing wheel.
+    ::std::vector<TimingWheelNode *> m_expired; ///< Buffer of expired nodes.
+
+  public:
+    /**
+     * @brief       Constructor.
+     *
+     * @param[in]   start       Timepoint of tick 0.
+     * @param[in]   tick        Duration of a tick.
+     */
+    TimingWheelAlarmStore(::std::chrono::steady_clock::time_point start,
+                          ::std::chrono::steady_clock::duration   tick);
+
+    /**
+     * @brief       Destructor.
+     */
+    virtual ~TimingWheelAlarmStore();
+
+  public:
+    /**
+     * @brief       Check if the store is empty.
+     *
+     * @return      \c true if empty, \c false if not.
+     */
+    virtual bool empty() const override;
+
+    /**
+     * @brief       Insert an alarm.
+     *
+     * @param[in]   alarm       Alarm to insert.
+     */
+    virtual void insert(const ::std::shared_ptr<AsyncAlarm> &alarm) override;
+
+    /**
+     * @brief       Remove an alarm.
+     *
+     * @param[in]   alarm       Alarm to remove.
+     */
+    virtual void remove(const ::std::shared_ptr<AsyncAlarm> &alarm) override;
+
+    /**
+     * @brief       Get the timepoint the store needs to be checked.
+     *
+     * @return      Timepoint, only valid if not empty.
+     */
+    virtual ::std::chrono::steady_clock::time_point
+        nextTimepoint() const override;
+
+    /**
+     * @brief       Take expired alarms.
+     *
+     * @param[in]   now         Current timepoint.
+     * @param[out]  alarms      Expired alarms are appended to it.
+     */
+    virtual void
+        takeExpired(::std::chrono::steady_clock::time_point      now,
+                    ::std::vector<::std::shared_ptr<AsyncAlarm>> &alarms)
+            override;
+};
+
+/**
+ * @brief       Slot of pooled timer.
+ */
+struct ThreadPool::TimerSlot : public TimingWheelNode {
+    Task task; ///< Task, empty if the slot is free.
+    ::std::chrono::steady_clock::time_point deadline; ///< Timepoint to fire.
+    uint32_t index;      ///< Index of the slot.
+    uint32_t generation; ///< Generation, increased when freed.
+    uint32_t nextFree;   ///< Next free slot if free.
+};
+
+/**
+ * @brief       Store of pooled timers, accessed with \c m_alarmLock held.
+ *
+ * Slots are allocated in chunks which never move, so the timing wheel links
+ * them by address. Free slots form a list by index.
+ */
+class ThreadPool::TimerStore {
+  private:
+    /// Count of slots in a chunk.
+    static inline constexpr uint32_t _chunkSize = 256;
+
+    /// Index of no slot.
+    static inline constexpr uint32_t _noSlot = UINT32_MAX;
+
+  private:
+    ::std::vector<::std::unique_ptr<TimerSlot[]>>
+        m_chunks; ///< Chunks of slots.
+    uint32_t      m_freeSlot; ///< First free slot.
+    ::std::chrono::steady_clock::time_point m_start; ///< Timepoint of tick 0.
+    ::std::chrono::steady_clock::duration   m_tick;  ///< Duration of a tick.
+    TimingWheel                             m_wheel; ///< Timing wheel.
+    ::std::vector<TimingWheelNode *> m_expired; ///< Buffer of expired nodes.
+
+  public:
+    /**
+     * @brief       Constructor.
+     *
+     * @param[in]   start       Timepoint of tick 0.
+     * @param[in]   tick        Duration of a tick.
+     */
+    TimerStore(::std::chrono::steady_clock::time_point start,
+               ::std::chrono::steady_clock::duration   tick);
+
+    TimerStore(const TimerStore &) = delete;
+    TimerStore(TimerStore &&)      = delete;
+
+    /**
+     * @brief       Destructor.
+     */
+    ~TimerStore();
+
+  public:
+    /**
+     * @brief       Check if the store is empty.
+     *
+     * @return      \c true if empty, \c false if not.
+     */
+    bool empty() const;
+
+    /**
+     * @brief       Insert a timer.
+     *
+     * @param[in]   deadline    Timepoint to fire.
+     * @param[in]   task        Task.
+     *
+     * @return      Handle of the timer.
+     */
+    TimerHandle insert(::std::chrono::steady_clock::time_point deadline,
+                       Task                                    task);
+
+    /**
+     * @brief       Remove a timer.
+     *
+     * @param[in]   handle      Handle of the timer.
+     * @param[out]  task        Task of the timer, so that it is destroyed
+     *                          without \c m_alarmLock held.
+     *
+     * @return      \c true if removed, \c false if the handle is stale or
+     *              invalid.
+     */
+    bool remove(TimerHandle handle, Task &task);
+
+    /**
+     * @brief       Get the timepoint the store needs to be checked.
+     *
+     * @return      Timepoint, only valid if not empty.
+     */
+    ::std::chrono::steady_clock::time_point nextTimepoint() const;
+
+    /**
+     * @brief       Take tasks of expired timers and free their slots.
+     *
+     * @param[in]   now         Current timepoint.
+     * @param[out]  tasks       Tasks are appended to it.
+     * @param[in]   lateness    Histogram of lateness, \c nullptr to skip.
+     */
+    void takeExpired(::std::chrono::steady_clock::time_point now,
+                     ::std::vector<Task>                    &tasks,
+                     Histogram                              *lateness);
+
+  private:
+    /**
+     * @brief       Get a slot.
+     *
+     * @param[in]   index       Index of the slot.
+     *
+     * @return      Slot.
+     */
+    inline TimerSlot &slot(uint32_t index)
+    {
+        return m_chunks[index / _chunkSize][index % _chunkSize];
+    }
+
+    /**
+     * @brief       Free a slot, the task must have been moved out.
+     *
+     * @param[in]   slot        Slot.
+     */
+    void freeSlot(TimerSlot &slot);
+};
+
 } // namespace remotePortMapper
+
+#include <common/thread_pool/thread_pool.hpp>
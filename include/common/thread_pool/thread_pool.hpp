@@ -0,0 +1,118 @@
+#pragma once
+
+#include <common/thread_pool/thread_pool.h>
+
+namespace remotePortMapper {
+
+/**
+ * @brief       Get enqueue time of a task.
+ */
+inline ::std::chrono::steady_clock::time_point ThreadPool::enqueueTime() const
+{
+    // A countdown left by a pool with a longer interval restarts.
+    if (m_telemetrySampleInterval == 0) {
+        return ::std::chrono::steady_clock::time_point();
+    } else if (_sampleCountdown > 1
+               && _sampleCountdown <= m_telemetrySampleInterval) {
+        --_sampleCountdown;
+        return ::std::chrono::steady_clock::time_point();
+    }
+
+    _sampleCountdown = m_telemetrySampleInterval;
+    return ::std::chrono::steady_clock::now();
+}
+
+/**
+ * @brief       Convert a duration to nanoseconds for histograms.
+ */
+inline uint64_t
+    ThreadPool::nanoseconds(::std::chrono::steady_clock::duration duration)
+{
+    auto count
+        = ::std::chrono::duration_cast<::std::chrono::nanoseconds>(duration)
+              .count();
+    return count > 0 ? static_cast<uint64_t>(count) : 0;
+}
+
+/**
+ * @brief       Add tasks in one batch.
+ */
+template<typename Iterator>
+    requires ::std::is_same<
+        typename ::std::iterator_traits<Iterator>::value_type,
+        ThreadPool::Task>::value
+void ThreadPool::addTasks(Iterator begin, Iterator end)
+{
+    ::std::size_t count  = 0;
+    Worker       *worker = this->currentWorker();
+    if (m_scheduler == ThreadPoolScheduler::WorkStealing && worker != nullptr) {
+        // Push to local deque.
+        {
+            ::std::unique_lock lock(worker->dequeLock);
+            for (; begin != end; ++begin, ++count) {
+                worker->deque.pushBack(
+                    QueuedTask {::std::move(*begin), this->enqueueTime()});
+            }
+            worker->dequeSize.store(worker->deque.size(),
+                                    ::std::memory_order_relaxed);
+        }
+        if (count > 0) {
+            m_pendingTasks.fetch_add(count);
+            this->wakeWorkers(count);
+        }
+
+    } else {
+        // Push to shared task queue.
+        constexpr auto     lane = static_cast<::std::size_t>(
+            ThreadPoolPriority::Normal);
+        ::std::unique_lock lock(m_taskQueueLock);
+        for (; begin != end; ++begin, ++count) {
+            m_taskQueues[lane].pushBack(
+                QueuedTask {::std::move(*begin), this->enqueueTime()});
+        }
+        if (count > 0) {
+            m_taskQueueSizes[lane].store(m_taskQueues[lane].size(),
+                                         ::std::memory_order_relaxed);
+            m_pendingTasks.fetch_add(count);
+            this->wakeWorkersLocked(count);
+        }
+    }
+
+    this->growWorkers();
+}
+
+/**
+ * @brief       Run a function over a range in parallel and wait.
+ */
+template<typename Function>
+    requires ::std::is_invocable<Function &,
+                                 ::std::size_t,
+                                 ::std::size_t>::value
+void ThreadPool::parallelFor(::std::size_t begin,
+                             ::std::size_t end,
+                             Function    &&function,
+                             ::std::size_t grain)
+{
+    this->runParallelFor(begin, end, grain, function);
+}
+
+/**
+ * @brief       Run functions in parallel and wait.
+ */
+template<typename... Functions>
+    requires(::std::is_invocable<Functions &>::value && ...)
+void ThreadPool::parallelInvoke(Functions &&...functions)
+{
+    this->parallelFor(
+        0, sizeof...(Functions),
+        [&](::std::size_t first, ::std::size_t last) -> void {
+            for (::std::size_t index = first; index < last; ++index) {
+                ::std::size_t i = 0;
+                ((index == i++ ? static_cast<void>(functions()) : void()),
+                 ...);
+            }
+        },
+        1);
+}
+
+} // namespace remotePortMapper
@@ -0,0 +1,200 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+namespace remotePortMapper {
+
+/**
+ * @brief   Node of timing wheel, objects to schedule inherit from it.
+ */
+class TimingWheelNode {
+    friend class TimingWheel;
+
+  private:
+    TimingWheelNode  *m_next;       ///< Next node in the slot.
+    TimingWheelNode **m_pprev;      ///< Pointer to the link pointing to this.
+    uint64_t          m_expireTick; ///< Tick to expire.
+    uint8_t           m_level;      ///< Level of the slot.
+    uint8_t           m_slot;       ///< Index of the slot.
+
+  public:
+    /**
+     * @brief       Constructor.
+     */
+    inline TimingWheelNode() :
+        m_next(nullptr), m_pprev(nullptr), m_expireTick(0), m_level(0),
+        m_slot(0)
+    {}
+
+    TimingWheelNode(const TimingWheelNode &) = delete;
+    TimingWheelNode(TimingWheelNode &&)      = delete;
+
+    /**
+     * @brief       Destructor.
+     */
+    ~TimingWheelNode() = default;
+
+  public:
+    /**
+     * @brief       Check if the node is in a timing wheel.
+     *
+     * @return      \c true if linked, \c false if not.
+     */
+    inline bool linked() const
+    {
+        return m_pprev != nullptr;
+    }
+
+    /**
+     * @brief       Get tick to expire.
+     *
+     * @return      Tick to expire.
+     */
+    inline uint64_t expireTick() const
+    {
+        return m_expireTick;
+    }
+};
+
+/**
+ * @brief   Hierarchical timing wheel.
+ *
+ * Each level has 64 slots, a slot of level \c n covers \c 64^n ticks, so
+ * insert and remove are O(1) and the wheel jumps over empty slots with the
+ * occupancy bitmap of each level instead of walking every tick. Nodes are
+ * linked intrusively and never owned by the wheel.
+ */
+class TimingWheel {
+  public:
+    /// Bits of slot index in each level.
+    static inline constexpr unsigned int slotBits = 6;
+
+    /// Count of slots in each level.
+    static inline constexpr unsigned int slotCount = 1U << slotBits;
+
+    /// Count of levels, enough to cover all 64-bit ticks.
+    static inline constexpr unsigned int levelCount
+        = (64 + slotBits - 1) / slotBits;
+
+    /// Tick returned when the wheel is empty.
+    static inline constexpr uint64_t noTick
+        = ::std::numeric_limits<uint64_t>::max();
+
+  private:
+    ::std::array<::std::array<TimingWheelNode *, slotCount>, levelCount>
+        m_slots; ///< Slots.
+    ::std::array<uint64_t, levelCount>
+                  m_bitmaps;     ///< Occupancy bitmap of each level.
+    uint64_t      m_currentTick; ///< Current tick.
+    ::std::size_t m_size;        ///< Count of nodes.
+
+  public:
+    /**
+     * @brief       Constructor.
+     *
+     * @param[in]   currentTick     Initial tick.
+     */
+    TimingWheel(uint64_t currentTick = 0);
+
+    TimingWheel(const TimingWheel &) = delete;
+    TimingWheel(TimingWheel &&)      = delete;
+
+    /**
+     * @brief       Destructor, unlinks all nodes.
+     */
+    ~TimingWheel();
+
+  public:
+    /**
+     * @brief       Get current tick.
+     *
+     * @return      Current tick.
+     */
+    inline uint64_t currentTick() const
+    {
+        return m_currentTick;
+    }
+
+    /**
+     * @brief       Get count of nodes.
+     *
+     * @return      Count of nodes.
+     */
+    inline ::std::size_t size() const
+    {
+        return m_size;
+    }
+
+    /**
+     * @brief       Check if the wheel is empty.
+     *
+     * @return      \c true if empty, \c false if not.
+     */
+    inline bool empty() const
+    {
+        return m_size == 0;
+    }
+
+    /**
+     * @brief       Insert a node.
+     *
+     * @param[in]   node        Node to insert, must not be linked.
+     * @param[in]   expireTick  Tick to expire, ticks not after current tick
+     *                          expire on the next tick.
+     */
+    void insert(TimingWheelNode *node, uint64_t expireTick);
+
+    /**
+     * @brief       Remove a node.
+     *
+     * @param[in]   node        Node to remove, ignored if not linked.
+     */
+    void remove(TimingWheelNode *node);
+
+    /**
+     * @brief       Get the next tick the wheel has work to do, either to
+     *              expire nodes or to cascade a higher level.
+     *
+     * @return      Next tick or \c noTick if empty.
+     */
+    uint64_t nextTick() const;
+
+    /**
+     * @brief       Advance the wheel.
+     *
+     * @param[in]   tick        Tick to advance to.
+     * @param[out]  expired     Expired nodes are appended to it, they are
+     *                          unlinked.
+     */
+    void advance(uint64_t tick, ::std::vector<TimingWheelNode *> &expired);
+
+    /**
+     * @brief       Unlink all nodes.
+     *
+     * @param[out]  nodes       Nodes unlinked are appended to it.
+     */
+    void clear(::std::vector<TimingWheelNode *> &nodes);
+
+  private:
+    /**
+     * @brief       Link a node to the slot matching its expire tick.
+     *
+     * @param[in]   node        Node to link.
+     */
+    void link(TimingWheelNode *node);
+
+    /**
+     * @brief       Take all nodes in a slot.
+     *
+     * @param[in]   level       Level.
+     * @param[in]   slot        Slot.
+     *
+     * @return      First node of the list taken.
+     */
+    TimingWheelNode *takeSlot(unsigned int level, unsigned int slot);
+};
+
+} // namespace remotePortMapper
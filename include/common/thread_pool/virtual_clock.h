@@ -0,0 +1,94 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <vector>
+
+#include <common/interfaces/i_create_shared_function.h>
+
+namespace remotePortMapper {
+
+class ThreadPool;
+
+/**
+ * @brief   Manually advanced clock of alarms and timers of thread pools.
+ *
+ * Time only moves when advanced, the alarm threads of the pools using the
+ * clock are woken to fire what became due. Timeout and keepalive workloads
+ * spanning hours can be simulated in milliseconds. Deadlines passed to the
+ * pools are timepoints of this clock, tasks and their telemetry still run in
+ * real time.
+ */
+class VirtualClock :
+    virtual public ICreateSharedFunc<VirtualClock>,
+    virtual public ICreateSharedFunc<VirtualClock,
+                                     ::std::chrono::steady_clock::time_point> {
+    CREATE_SHARED(VirtualClock);
+    CREATE_SHARED(VirtualClock, ::std::chrono::steady_clock::time_point);
+    friend class ThreadPool;
+
+  private:
+    ::std::atomic<::std::chrono::steady_clock::rep> m_now; ///< Current time.
+    ::std::mutex m_lock; ///< Lock of thread pools.
+    ::std::vector<ThreadPool *> m_threadPools; ///< Thread pools to wake.
+
+  private:
+    /**
+     * @brief       Constructor.
+     *
+     * @param[in]   start       Time to start at.
+     */
+    VirtualClock(::std::chrono::steady_clock::time_point start
+                 = ::std::chrono::steady_clock::now());
+
+  public:
+    VirtualClock(const VirtualClock &) = delete;
+    VirtualClock(VirtualClock &&)      = delete;
+
+  public:
+    /**
+     * @brief       Destructor.
+     */
+    virtual ~VirtualClock() = default;
+
+  public:
+    /**
+     * @brief       Get current time.
+     *
+     * @return      Current time.
+     */
+    ::std::chrono::steady_clock::time_point now() const;
+
+    /**
+     * @brief       Advance the clock.
+     *
+     * @param[in]   duration    Duration to advance, negative ones are
+     *                          ignored.
+     */
+    void advance(::std::chrono::steady_clock::duration duration);
+
+    /**
+     * @brief       Advance the clock to a timepoint, never backwards.
+     *
+     * @param[in]   timepoint   Timepoint.
+     */
+    void advanceTo(::std::chrono::steady_clock::time_point timepoint);
+
+  private:
+    /**
+     * @brief       Wake a thread pool when the clock advances.
+     *
+     * @param[in]   threadPool      Thread pool.
+     */
+    void attach(ThreadPool *threadPool);
+
+    /**
+     * @brief       Stop waking a thread pool.
+     *
+     * @param[in]   threadPool      Thread pool.
+     */
+    void detach(ThreadPool *threadPool);
+};
+
+} // namespace remotePortMapper
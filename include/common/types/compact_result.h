@@ -0,0 +1,373 @@
+#pragma once
+
+#include <cstdint>
+#include <limits>
+#include <type_traits>
+
+#include <common/error/error_code.h>
+#include <common/types/result.h>
+
+namespace remotePortMapper {
+
+/**
+ * @brief   Type which can be kept in a compact \c Result.
+ *
+ * @tparam  Type    Type.
+ */
+template<typename Type>
+concept CompactResultValueType
+    = ResultValueType<Type>
+      && (::std::is_void<Type>::value
+          || ((! ::std::is_reference<Type>::value)
+              && ::std::is_trivially_copyable<Type>::value));
+
+/**
+ * @brief   Niche of an error type.
+ *
+ * Specialize it to keep the status of \c Result<void, Type> in the error
+ * code of the value, instead of a separate status byte. The specialization
+ * provides \c errCode(), which returns a reference to the error code of the
+ * value, const if the value is.
+ *
+ * @tparam  Type    Error type.
+ */
+template<typename Type>
+struct ResultNiche;
+
+/**
+ * @brief   Error type with a niche.
+ *
+ * @tparam  Type    Type.
+ */
+template<typename Type>
+concept NicheResultErrorType
+    = CompactResultValueType<Type>
+      && ::std::is_default_constructible<Type>::value && requires(Type &value) {
+             {
+                 ResultNiche<Type>::errCode(value)
+             } -> ::std::same_as<ErrorCode &>;
+         };
+
+/**
+ * @brief   Niche of \c ErrorCode.
+ */
+template<>
+struct ResultNiche<ErrorCode> {
+    /**
+     * @brief       Get the error code of the value.
+     *
+     * @tparam      Value       Type of the value, maybe const.
+     *
+     * @param[in]   value       Value.
+     *
+     * @return      Reference to the error code.
+     */
+    template<typename Value>
+    static inline Value &errCode(Value &value)
+    {
+        return value;
+    }
+};
+
+/**
+ * @brief       Result type for trivially copyable values.
+ *
+ * Copy, move and destruction are trivial, so small results are returned in
+ * registers. Moving a result copies it, the source keeps its value.
+ *
+ * @param[in]   OkType      Type of the value on ok.
+ * @param[in]   ErrorType   Type of the value on erred.
+ */
+template<typename OkType, typename ErrorType>
+    requires CompactResultValueType<OkType> && CompactResultValueType<ErrorType>
+class Result<OkType, ErrorType> {
+  private:
+    /**
+     * @brief   Status.
+     */
+    enum class Status : uint8_t { Bad, Ok, Error };
+
+  public:
+    /**
+     * @brief   Reference type of the value.
+     *
+     * @tparam  Type    Type.
+     */
+    template<typename Type>
+        requires(::std::is_same<Type, OkType>::value
+                 || ::std::is_same<Type, ErrorType>::value)
+                    && (! ::std::is_same<void, Type>::value)
+    using ValueReference = typename ::std::add_lvalue_reference<Type>::type;
+
+    /**
+     * @brief   Constant reference type of the value.
+     *
+     * @tparam  Type    Type.
+     */
+    template<typename Type>
+        requires(::std::is_same<Type, OkType>::value
+                 || ::std::is_same<Type, ErrorType>::value)
+                    && (! ::std::is_same<void, Type>::value)
+    using ConstValueReference = typename ::std::add_lvalue_reference<
+        typename ::std::add_const<Type>::type>::type;
+
+  private:
+    /// Size of the data.
+    static inline constexpr ::std::size_t dataSize
+        = BufferSize<OkType, ErrorType>::value;
+
+    /// Alignment of the data.
+    static inline constexpr ::std::size_t dataAlignment
+        = BufferAlignment<OkType, ErrorType>::value;
+
+  private:
+    Status m_status = Status::Bad;                   ///< Status.
+    alignas(dataAlignment) uint8_t m_data[dataSize]; ///< Data.
+
+  public:
+    Result()                          = default;
+    Result(const Result &)            = default;
+    Result(Result &&)                 = default;
+    ~Result()                         = default;
+    Result &operator=(const Result &) = default;
+    Result &operator=(Result &&)      = default;
+
+  public:
+    /**
+     * @brief       Make an ok result.
+     *
+     * @tparam      Args        Types of the arguments of the constructor.
+     *
+     * @param[in]   args        Arguments of the constructor of the value.
+     *
+     * @return      Result.
+     */
+    template<typename... Args>
+    static Result makeOk(Args &&...args);
+
+    /**
+     * @brief       Make a error result.
+     *
+     * @tparam      Args        Types of the arguments of the constructor.
+     *
+     * @param[in]   args        Arguments of the constructor of the value.
+     *
+     * @return      Result.
+     */
+    template<typename... Args>
+    static Result makeError(Args &&...args);
+
+  public:
+    /**
+     * @brief       Check if the result is good.
+     *
+     * @return      \c true if good, \c false if bad.
+     */
+    inline bool good() const;
+
+    /**
+     * @brief       Check if the result is ok.
+     *
+     * @return      \c true if ok, \c false if not.
+     */
+    inline bool ok() const;
+
+    /**
+     * @brief       Get value.
+     *
+     * @tparam      Type    Value type.
+     *
+     * @return      Reference to  the value.
+     */
+    template<typename Type>
+        requires(! ::std::is_void<Type>::value)
+    inline ValueReference<Type> value();
+
+    /**
+     * @brief       Get value.
+     *
+     * @tparam      Type    Value type.
+     *
+     * @return      Reference to  the value.
+     */
+    template<typename Type>
+        requires(! ::std::is_void<Type>::value)
+    inline ConstValueReference<Type> value() const;
+
+    /**
+     * @brief       Clear the value.
+     */
+    inline void clear();
+
+  public:
+    /**
+     * @brief       Operator bool.
+     *
+     * @return      \c true if ok, \c false if not.
+     */
+    inline operator bool() const;
+
+  private:
+    /**
+     * @brief       Construct the value.
+     *
+     * @tparam      Type    Value type.
+     * @tparam      Args    Types of the arguments
+     *
+     * @param[in]   args    Arguments of the constructor.
+     */
+    template<typename Type, typename... Args>
+        requires(::std::is_same<Type, OkType>::value
+                 || ::std::is_same<Type, ErrorType>::value)
+    inline void construct(Args &&...args);
+
+    /**
+     * @brief       Check the status and the type of the value to get.
+     *
+     * @tparam      Type    Value type.
+     */
+    template<typename Type>
+    inline void checkValue() const;
+};
+
+/**
+ * @brief       Result type for an error type with a niche.
+ *
+ * The status is kept in the error code of the value: \c ErrorCode::Success
+ * means ok and a positive code which is never an error means bad, so the
+ * result is as large as the error.
+ *
+ * @param[in]   ErrorType   Type of the value on erred.
+ */
+template<typename ErrorType>
+    requires NicheResultErrorType<ErrorType>
+class Result<void, ErrorType> {
+  public:
+    /**
+     * @brief   Reference type of the value.
+     *
+     * @tparam  Type    Type.
+     */
+    template<typename Type>
+        requires ::std::is_same<Type, ErrorType>::value
+    using ValueReference = Type &;
+
+    /**
+     * @brief   Constant reference type of the value.
+     *
+     * @tparam  Type    Type.
+     */
+    template<typename Type>
+        requires ::std::is_same<Type, ErrorType>::value
+    using ConstValueReference = const Type &;
+
+  private:
+    /// Error code of ok.
+    static inline constexpr ErrorCode _ok = ErrorCode::Success;
+
+    /// Error code of bad.
+    static inline constexpr ErrorCode _bad
+        = static_cast<ErrorCode>(::std::numeric_limits<int32_t>::max());
+
+  private:
+    ErrorType m_value; ///< Value, its error code is the status.
+
+  public:
+    /**
+     * @brief       Constructor.
+     */
+    inline Result();
+
+    Result(const Result &)            = default;
+    Result(Result &&)                 = default;
+    ~Result()                         = default;
+    Result &operator=(const Result &) = default;
+    Result &operator=(Result &&)      = default;
+
+  public:
+    /**
+     * @brief       Make an ok result.
+     *
+     * @return      Result.
+     */
+    static Result makeOk();
+
+    /**
+     * @brief       Make a error result.
+     *
+     * @tparam      Args        Types of the arguments of the constructor.
+     *
+     * @param[in]   args        Arguments of the constructor of the value,
+     *                          its error code must be an error.
+     *
+     * @return      Result.
+     */
+    template<typename... Args>
+    static Result makeError(Args &&...args);
+
+  public:
+    /**
+     * @brief       Check if the result is good.
+     *
+     * @return      \c true if good, \c false if bad.
+     */
+    inline bool good() const;
+
+    /**
+     * @brief       Check if the result is ok.
+     *
+     * @return      \c true if ok, \c false if not.
+     */
+    inline bool ok() const;
+
+    /**
+     * @brief       Get value.
+     *
+     * @tparam      Type    Value type.
+     *
+     * @return      Reference to  the value.
+     */
+    template<typename Type>
+        requires(! ::std::is_void<Type>::value)
+    inline ValueReference<Type> value();
+
+    /**
+     * @brief       Get value.
+     *
+     * @tparam      Type    Value type.
+     *
+     * @return      Reference to  the value.
+     */
+    template<typename Type>
+        requires(! ::std::is_void<Type>::value)
+    inline ConstValueReference<Type> value() const;
+
+    /**
+     * @brief       Clear the value.
+     */
+    inline void clear();
+
+  public:
+    /**
+     * @brief       Operator bool.
+     *
+     * @return      \c true if ok, \c false if not.
+     */
+    inline operator bool() const;
+
+  private:
+    /**
+     * @brief       Get the error code of the value.
+     *
+     * @return      Error code.
+     */
+    inline ErrorCode errCode() const;
+};
+
+static_assert(sizeof(Result<uint32_t, ErrorCode>) == 8);
+static_assert(sizeof(Result<void, ErrorCode>) == sizeof(ErrorCode));
+static_assert(::std::is_trivially_copyable<Result<uint64_t, ErrorCode>>::value);
+
+} // namespace remotePortMapper
+
+#include <common/types/compact_result.hpp>
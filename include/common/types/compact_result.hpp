@@ -0,0 +1,264 @@
+#pragma once
+
+#include <new>
+
+#include <common/logger/logger.h>
+
+#include <common/types/compact_result.h>
+
+namespace remotePortMapper {
+
+/**
+ * @brief       Make an ok result.
+ */
+template<typename OkType, typename ErrorType>
+    requires CompactResultValueType<OkType> && CompactResultValueType<ErrorType>
+template<typename... Args>
+Result<OkType, ErrorType> Result<OkType, ErrorType>::makeOk(Args &&...args)
+{
+    Result ret;
+    ret.m_status = Status::Ok;
+    ret.construct<OkType>(::std::forward<Args>(args)...);
+    return ret;
+}
+
+/**
+ * @brief       Make a error result.
+ */
+template<typename OkType, typename ErrorType>
+    requires CompactResultValueType<OkType> && CompactResultValueType<ErrorType>
+template<typename... Args>
+Result<OkType, ErrorType> Result<OkType, ErrorType>::makeError(Args &&...args)
+{
+    Result ret;
+    ret.m_status = Status::Error;
+    ret.construct<ErrorType>(::std::forward<Args>(args)...);
+    return ret;
+}
+
+/**
+ * @brief       Check if the result is good.
+ */
+template<typename OkType, typename ErrorType>
+    requires CompactResultValueType<OkType> && CompactResultValueType<ErrorType>
+inline bool Result<OkType, ErrorType>::good() const
+{
+    return m_status != Status::Bad;
+}
+
+/**
+ * @brief       Check if the result is ok.
+ */
+template<typename OkType, typename ErrorType>
+    requires CompactResultValueType<OkType> && CompactResultValueType<ErrorType>
+inline bool Result<OkType, ErrorType>::ok() const
+{
+    return m_status == Status::Ok;
+}
+
+/**
+ * @brief       Get value.
+ */
+template<typename OkType, typename ErrorType>
+    requires CompactResultValueType<OkType> && CompactResultValueType<ErrorType>
+template<typename Type>
+    requires(! ::std::is_void<Type>::value)
+inline typename Result<OkType, ErrorType>::template ValueReference<
+    Type> Result<OkType, ErrorType>::value()
+{
+    this->checkValue<Type>();
+    return *::std::launder(reinterpret_cast<Type *>(m_data));
+}
+
+/**
+ * @brief       Get value.
+ */
+template<typename OkType, typename ErrorType>
+    requires CompactResultValueType<OkType> && CompactResultValueType<ErrorType>
+template<typename Type>
+    requires(! ::std::is_void<Type>::value)
+inline typename Result<OkType, ErrorType>::template ConstValueReference<
+    Type> Result<OkType, ErrorType>::value() const
+{
+    this->checkValue<Type>();
+    return *::std::launder(reinterpret_cast<const Type *>(m_data));
+}
+
+/**
+ * @brief       Clear the value.
+ */
+template<typename OkType, typename ErrorType>
+    requires CompactResultValueType<OkType> && CompactResultValueType<ErrorType>
+inline void Result<OkType, ErrorType>::clear()
+{
+    m_status = Status::Bad;
+}
+
+/**
+ * @brief       Operator bool.
+ */
+template<typename OkType, typename ErrorType>
+    requires CompactResultValueType<OkType> && CompactResultValueType<ErrorType>
+inline Result<OkType, ErrorType>::operator bool() const
+{
+    return this->ok();
+}
+
+/**
+ * @brief       Construct the value.
+ */
+template<typename OkType, typename ErrorType>
+    requires CompactResultValueType<OkType> && CompactResultValueType<ErrorType>
+template<typename Type, typename... Args>
+    requires(::std::is_same<Type, OkType>::value
+             || ::std::is_same<Type, ErrorType>::value)
+inline void Result<OkType, ErrorType>::construct(Args &&...args)
+{
+    if constexpr (! ::std::is_void<Type>::value) {
+        new (reinterpret_cast<void *>(m_data))
+            Type(::std::forward<Args>(args)...);
+    }
+}
+
+/**
+ * @brief       Check the status and the type of the value to get.
+ */
+template<typename OkType, typename ErrorType>
+    requires CompactResultValueType<OkType> && CompactResultValueType<ErrorType>
+template<typename Type>
+inline void Result<OkType, ErrorType>::checkValue() const
+{
+    if (((! ::std::is_same<Type, OkType>::value) && m_status == Status::Ok)
+        || ((! ::std::is_same<Type, ErrorType>::value)
+            && m_status == Status::Error)) {
+        panic("Data type mismatched!");
+    } else if (m_status == Status::Bad) {
+        panic("Trying to get the value from a bad result!");
+    }
+}
+
+/**
+ * @brief       Constructor.
+ */
+template<typename ErrorType>
+    requires NicheResultErrorType<ErrorType>
+inline Result<void, ErrorType>::Result() : m_value()
+{
+    ResultNiche<ErrorType>::errCode(m_value) = _bad;
+}
+
+/**
+ * @brief       Make an ok result.
+ */
+template<typename ErrorType>
+    requires NicheResultErrorType<ErrorType>
+Result<void, ErrorType> Result<void, ErrorType>::makeOk()
+{
+    Result ret;
+    ResultNiche<ErrorType>::errCode(ret.m_value) = _ok;
+    return ret;
+}
+
+/**
+ * @brief       Make a error result.
+ */
+template<typename ErrorType>
+    requires NicheResultErrorType<ErrorType>
+template<typename... Args>
+Result<void, ErrorType> Result<void, ErrorType>::makeError(Args &&...args)
+{
+    Result ret;
+    ret.m_value = ErrorType(::std::forward<Args>(args)...);
+    if (ret.errCode() == _ok || ret.errCode() == _bad) {
+        panic("Error code of an erred result must be an error!");
+    }
+    return ret;
+}
+
+/**
+ * @brief       Check if the result is good.
+ */
+template<typename ErrorType>
+    requires NicheResultErrorType<ErrorType>
+inline bool Result<void, ErrorType>::good() const
+{
+    return this->errCode() != _bad;
+}
+
+/**
+ * @brief       Check if the result is ok.
+ */
+template<typename ErrorType>
+    requires NicheResultErrorType<ErrorType>
+inline bool Result<void, ErrorType>::ok() const
+{
+    return this->errCode() == _ok;
+}
+
+/**
+ * @brief       Get value.
+ */
+template<typename ErrorType>
+    requires NicheResultErrorType<ErrorType>
+template<typename Type>
+    requires(! ::std::is_void<Type>::value)
+inline typename Result<void, ErrorType>::template ValueReference<Type>
+    Result<void, ErrorType>::value()
+{
+    if (this->errCode() == _ok) {
+        panic("Data type mismatched!");
+    } else if (this->errCode() == _bad) {
+        panic("Trying to get the value from a bad result!");
+    }
+    return m_value;
+}
+
+/**
+ * @brief       Get value.
+ */
+template<typename ErrorType>
+    requires NicheResultErrorType<ErrorType>
+template<typename Type>
+    requires(! ::std::is_void<Type>::value)
+inline typename Result<void, ErrorType>::template ConstValueReference<Type>
+    Result<void, ErrorType>::value() const
+{
+    if (this->errCode() == _ok) {
+        panic("Data type mismatched!");
+    } else if (this->errCode() == _bad) {
+        panic("Trying to get the value from a bad result!");
+    }
+    return m_value;
+}
+
+/**
+ * @brief       Clear the value.
+ */
+template<typename ErrorType>
+    requires NicheResultErrorType<ErrorType>
+inline void Result<void, ErrorType>::clear()
+{
+    ResultNiche<ErrorType>::errCode(m_value) = _bad;
+}
+
+/**
+ * @brief       Operator bool.
+ */
+template<typename ErrorType>
+    requires NicheResultErrorType<ErrorType>
+inline Result<void, ErrorType>::operator bool() const
+{
+    return this->ok();
+}
+
+/**
+ * @brief       Get the error code of the value.
+ */
+template<typename ErrorType>
+    requires NicheResultErrorType<ErrorType>
+inline ErrorCode Result<void, ErrorType>::errCode() const
+{
+    return ResultNiche<ErrorType>::errCode(m_value);
+}
+
+} // namespace remotePortMapper
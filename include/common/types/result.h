@@ -10,6 +10,14 @@
 
 namespace remotePortMapper {
 
+/**
+ * @brief   Type which can be kept in a \c Result.
+ *
+ * @tparam  Type    Type.
+ */
+template<typename Type>
+concept ResultValueType = ! ::std::is_array<Type>::value;
+
 /**
  * @brief       Result type.
  *
@@ -17,8 +25,7 @@ namespace remotePortMapper {
  * @param[in]   ErrorType      Type of the value on erred.
  */
 template<typename OkType, typename ErrorType>
-    requires(! ::std::is_array<OkType>::value)
-            && (! ::std::is_array<ErrorType>::value)
+    requires ResultValueType<OkType> && ResultValueType<ErrorType>
 class Result {
   private:
     /**
@@ -499,3 +506,5 @@ class Result {
 } // namespace remotePortMapper
 
 #include <common/types/result.hpp>
+
+#include <common/types/compact_result.h>
@@ -12,8 +12,7 @@ namespace remotePortMapper {
  * @brief       Constructor.
  */
 template<typename OkType, typename ErrorType>
-    requires(! ::std::is_array<OkType>::value)
-            && (! ::std::is_array<ErrorType>::value)
+    requires ResultValueType<OkType> && ResultValueType<ErrorType>
 inline Result<OkType, ErrorType>::Result() : m_status(Status::Bad)
 {}
 
@@ -21,8 +20,7 @@ inline Result<OkType, ErrorType>::Result() : m_status(Status::Bad)
  * @brief       Copy constructor.
  */
 template<typename OkType, typename ErrorType>
-    requires(! ::std::is_array<OkType>::value)
-            && (! ::std::is_array<ErrorType>::value)
+    requires ResultValueType<OkType> && ResultValueType<ErrorType>
 inline Result<OkType, ErrorType>::Result(const Result &result) :
     m_status(Status::Bad)
 {
@@ -35,8 +33,7 @@ inline Result<OkType, ErrorType>::Result(const Result &result) :
  * @brief       Move constructor.
  */
 template<typename OkType, typename ErrorType>
-    requires(! ::std::is_array<OkType>::value)
-            && (! ::std::is_array<ErrorType>::value)
+    requires ResultValueType<OkType> && ResultValueType<ErrorType>
 inline Result<OkType, ErrorType>::Result(Result &&result) :
     m_status(Status::Bad)
 {
@@ -49,8 +46,7 @@ inline Result<OkType, ErrorType>::Result(Result &&result) :
  * @brief       Destructor.
  */
 template<typename OkType, typename ErrorType>
-    requires(! ::std::is_array<OkType>::value)
-            && (! ::std::is_array<ErrorType>::value)
+    requires ResultValueType<OkType> && ResultValueType<ErrorType>
 inline Result<OkType, ErrorType>::~Result()
 {
     this->clear();
@@ -60,8 +56,7 @@ inline Result<OkType, ErrorType>::~Result()
  * @brief       Make an ok result.
  */
 template<typename OkType, typename ErrorType>
-    requires(! ::std::is_array<OkType>::value)
-            && (! ::std::is_array<ErrorType>::value)
+    requires ResultValueType<OkType> && ResultValueType<ErrorType>
 template<typename... Args>
 Result<OkType, ErrorType> Result<OkType, ErrorType>::makeOk(Args &&...args)
 {
@@ -75,8 +70,7 @@ Result<OkType, ErrorType> Result<OkType, ErrorType>::makeOk(Args &&...args)
  * @brief       Make a error result.
  */
 template<typename OkType, typename ErrorType>
-    requires(! ::std::is_array<OkType>::value)
-            && (! ::std::is_array<ErrorType>::value)
+    requires ResultValueType<OkType> && ResultValueType<ErrorType>
 template<typename... Args>
 Result<OkType, ErrorType> Result<OkType, ErrorType>::makeError(Args &&...args)
 {
@@ -90,8 +84,7 @@ Result<OkType, ErrorType> Result<OkType, ErrorType>::makeError(Args &&...args)
  * @brief       Check if the result is good.
  */
 template<typename OkType, typename ErrorType>
-    requires(! ::std::is_array<OkType>::value)
-            && (! ::std::is_array<ErrorType>::value)
+    requires ResultValueType<OkType> && ResultValueType<ErrorType>
 inline bool Result<OkType, ErrorType>::good() const
 {
     return m_status != Status::Bad;
@@ -101,8 +94,7 @@ inline bool Result<OkType, ErrorType>::good() const
  * @brief       Check if the result is ok.
  */
 template<typename OkType, typename ErrorType>
-    requires(! ::std::is_array<OkType>::value)
-            && (! ::std::is_array<ErrorType>::value)
+    requires ResultValueType<OkType> && ResultValueType<ErrorType>
 inline bool Result<OkType, ErrorType>::ok() const
 {
     return m_status == Status::Ok;
@@ -112,8 +104,7 @@ inline bool Result<OkType, ErrorType>::ok() const
  * @brief       Get value.
  */
 template<typename OkType, typename ErrorType>
-    requires(! ::std::is_array<OkType>::value)
-            && (! ::std::is_array<ErrorType>::value)
+    requires ResultValueType<OkType> && ResultValueType<ErrorType>
             template<typename Type>
                 requires(! ::std::is_reference<Type>::value)
                         && (! ::std::is_void<Type>::value)
@@ -137,8 +128,7 @@ inline typename Result<OkType, ErrorType>::template ValueReference<
  * @brief       Get value(reference).
  */
 template<typename OkType, typename ErrorType>
-    requires(! ::std::is_array<OkType>::value)
-            && (! ::std::is_array<ErrorType>::value)
+    requires ResultValueType<OkType> && ResultValueType<ErrorType>
             template<typename Type>
                 requires(::std::is_reference<Type>::value)
                         && (! ::std::is_void<Type>::value)
@@ -164,8 +154,7 @@ inline typename Result<OkType, ErrorType>::template ValueReference<
  * @brief       Get value.
  */
 template<typename OkType, typename ErrorType>
-    requires(! ::std::is_array<OkType>::value)
-            && (! ::std::is_array<ErrorType>::value)
+    requires ResultValueType<OkType> && ResultValueType<ErrorType>
             template<typename Type>
                 requires(! ::std::is_reference<Type>::value)
                         && (! ::std::is_void<Type>::value)
@@ -190,8 +179,7 @@ inline typename Result<OkType, ErrorType>::template ConstValueReference<
  * @brief       Get value(reference).
  */
 template<typename OkType, typename ErrorType>
-    requires(! ::std::is_array<OkType>::value)
-            && (! ::std::is_array<ErrorType>::value)
+    requires ResultValueType<OkType> && ResultValueType<ErrorType>
             template<typename Type>
                 requires(::std::is_reference<Type>::value)
                         && (! ::std::is_void<Type>::value)
@@ -217,8 +205,7 @@ inline typename Result<OkType, ErrorType>::template ConstValueReference<
  * @brief       Clear the value.
  */
 template<typename OkType, typename ErrorType>
-    requires(! ::std::is_array<OkType>::value)
-            && (! ::std::is_array<ErrorType>::value)
+    requires ResultValueType<OkType> && ResultValueType<ErrorType>
 inline void Result<OkType, ErrorType>::clear()
 {
     switch (m_status) {
@@ -241,8 +228,7 @@ inline void Result<OkType, ErrorType>::clear()
  * @brief       Operator bool.
  */
 template<typename OkType, typename ErrorType>
-    requires(! ::std::is_array<OkType>::value)
-            && (! ::std::is_array<ErrorType>::value)
+    requires ResultValueType<OkType> && ResultValueType<ErrorType>
 inline Result<OkType, ErrorType>::operator bool() const
 {
     return this->ok();
@@ -252,8 +238,7 @@ inline Result<OkType, ErrorType>::operator bool() const
  * @brief       Operator=.
  */
 template<typename OkType, typename ErrorType>
-    requires(! ::std::is_array<OkType>::value)
-            && (! ::std::is_array<ErrorType>::value)
+    requires ResultValueType<OkType> && ResultValueType<ErrorType>
 inline Result<OkType, ErrorType> &Result<OkType, ErrorType>::operator=(
     const Result &result)
 {
@@ -266,8 +251,7 @@ inline Result<OkType, ErrorType> &Result<OkType, ErrorType>::operator=(
  * @brief       Operator=.
  */
 template<typename OkType, typename ErrorType>
-    requires(! ::std::is_array<OkType>::value)
-            && (! ::std::is_array<ErrorType>::value)
+    requires ResultValueType<OkType> && ResultValueType<ErrorType>
 inline Result<OkType, ErrorType> &Result<OkType, ErrorType>::operator=(
     Result &&result)
 {
@@ -280,8 +264,7 @@ inline Result<OkType, ErrorType> &Result<OkType, ErrorType>::operator=(
  * @brief       Copy value.
  */
 template<typename OkType, typename ErrorType>
-    requires(! ::std::is_array<OkType>::value)
-            && (! ::std::is_array<ErrorType>::value)
+    requires ResultValueType<OkType> && ResultValueType<ErrorType>
 inline void Result<OkType, ErrorType>::copy(const Result &result)
 {
     if (result.m_status == Status::Bad) {
@@ -322,8 +305,7 @@ inline void Result<OkType, ErrorType>::copy(const Result &result)
  * @brief       Copy value(void).
  */
 template<typename OkType, typename ErrorType>
-    requires(! ::std::is_array<OkType>::value)
-            && (! ::std::is_array<ErrorType>::value)
+    requires ResultValueType<OkType> && ResultValueType<ErrorType>
             template<typename Type>
                 requires(::std::is_same<Type, OkType>::value
                          || ::std::is_same<Type, ErrorType>::value)
@@ -335,8 +317,7 @@ inline void Result<OkType, ErrorType>::copyValue(const Result &)
  * @brief       Copy value(reference).
  */
 template<typename OkType, typename ErrorType>
-    requires(! ::std::is_array<OkType>::value)
-            && (! ::std::is_array<ErrorType>::value)
+    requires ResultValueType<OkType> && ResultValueType<ErrorType>
             template<typename Type>
                 requires(::std::is_same<Type, OkType>::value
                          || ::std::is_same<Type, ErrorType>::value)
@@ -359,8 +340,7 @@ inline void Result<OkType, ErrorType>::copyValue(const Result &result)
  * @brief       Copy value(copy assignable).
  */
 template<typename OkType, typename ErrorType>
-    requires(! ::std::is_array<OkType>::value)
-            && (! ::std::is_array<ErrorType>::value)
+    requires ResultValueType<OkType> && ResultValueType<ErrorType>
             template<typename Type>
                 requires(::std::is_same<Type, OkType>::value
                          || ::std::is_same<Type, ErrorType>::value)
@@ -382,8 +362,7 @@ inline void Result<OkType, ErrorType>::copyValue(const Result &result)
  * @brief       Copy value(else).
  */
 template<typename OkType, typename ErrorType>
-    requires(! ::std::is_array<OkType>::value)
-            && (! ::std::is_array<ErrorType>::value)
+    requires ResultValueType<OkType> && ResultValueType<ErrorType>
             template<typename Type>
                 requires(::std::is_same<Type, OkType>::value
                          || ::std::is_same<Type, ErrorType>::value)
@@ -400,8 +379,7 @@ inline void Result<OkType, ErrorType>::copyValue(const Result &result)
  * @brief       Copy construct value(void).
  */
 template<typename OkType, typename ErrorType>
-    requires(! ::std::is_array<OkType>::value)
-            && (! ::std::is_array<ErrorType>::value)
+    requires ResultValueType<OkType> && ResultValueType<ErrorType>
             template<typename Type>
                 requires(::std::is_same<Type, OkType>::value
                          || ::std::is_same<Type, ErrorType>::value)
@@ -416,8 +394,7 @@ inline void Result<OkType, ErrorType>::copyConstructValue(const Result &)
  *
  */
 template<typename OkType, typename ErrorType>
-    requires(! ::std::is_array<OkType>::value)
-            && (! ::std::is_array<ErrorType>::value)
+    requires ResultValueType<OkType> && ResultValueType<ErrorType>
             template<typename Type>
                 requires(::std::is_same<Type, OkType>::value
                          || ::std::is_same<Type, ErrorType>::value)
@@ -431,8 +408,7 @@ inline void Result<OkType, ErrorType>::copyConstructValue(const Result &result)
  * @brief       Move value.
  */
 template<typename OkType, typename ErrorType>
-    requires(! ::std::is_array<OkType>::value)
-            && (! ::std::is_array<ErrorType>::value)
+    requires ResultValueType<OkType> && ResultValueType<ErrorType>
 inline void Result<OkType, ErrorType>::move(Result &&result)
 {
     if (result.m_status == Status::Bad) {
@@ -475,8 +451,7 @@ inline void Result<OkType, ErrorType>::move(Result &&result)
  * @brief       Move value(void).
  */
 template<typename OkType, typename ErrorType>
-    requires(! ::std::is_array<OkType>::value)
-            && (! ::std::is_array<ErrorType>::value)
+    requires ResultValueType<OkType> && ResultValueType<ErrorType>
             template<typename Type>
                 requires(::std::is_same<Type, OkType>::value
                          || ::std::is_same<Type, ErrorType>::value)
@@ -488,8 +463,7 @@ inline void Result<OkType, ErrorType>::moveValue(Result &&)
  * @brief       Move value(reference).
  */
 template<typename OkType, typename ErrorType>
-    requires(! ::std::is_array<OkType>::value)
-            && (! ::std::is_array<ErrorType>::value)
+    requires ResultValueType<OkType> && ResultValueType<ErrorType>
             template<typename Type>
                 requires(::std::is_same<Type, OkType>::value
                          || ::std::is_same<Type, ErrorType>::value)
@@ -508,8 +482,7 @@ inline void Result<OkType, ErrorType>::moveValue(Result &&result)
  * @brief       Move value(move assignable).
  */
 template<typename OkType, typename ErrorType>
-    requires(! ::std::is_array<OkType>::value)
-            && (! ::std::is_array<ErrorType>::value)
+    requires ResultValueType<OkType> && ResultValueType<ErrorType>
             template<typename Type>
                 requires(::std::is_same<Type, OkType>::value
                          || ::std::is_same<Type, ErrorType>::value)
@@ -527,8 +500,7 @@ inline void Result<OkType, ErrorType>::moveValue(Result &&result)
  * @brief       Move value(else).
  */
 template<typename OkType, typename ErrorType>
-    requires(! ::std::is_array<OkType>::value)
-            && (! ::std::is_array<ErrorType>::value)
+    requires ResultValueType<OkType> && ResultValueType<ErrorType>
             template<typename Type>
                 requires(::std::is_same<Type, OkType>::value
                          || ::std::is_same<Type, ErrorType>::value)
@@ -546,8 +518,7 @@ inline void Result<OkType, ErrorType>::moveValue(Result &&result)
  * @brief       Move construct value(void).
  */
 template<typename OkType, typename ErrorType>
-    requires(! ::std::is_array<OkType>::value)
-            && (! ::std::is_array<ErrorType>::value)
+    requires ResultValueType<OkType> && ResultValueType<ErrorType>
             template<typename Type>
                 requires(::std::is_same<Type, OkType>::value
                          || ::std::is_same<Type, ErrorType>::value)
@@ -561,8 +532,7 @@ inline void Result<OkType, ErrorType>::moveConstructValue(Result &&)
  * @brief       Move construct value(else).
  */
 template<typename OkType, typename ErrorType>
-    requires(! ::std::is_array<OkType>::value)
-            && (! ::std::is_array<ErrorType>::value)
+    requires ResultValueType<OkType> && ResultValueType<ErrorType>
             template<typename Type>
                 requires(::std::is_same<Type, OkType>::value
                          || ::std::is_same<Type, ErrorType>::value)
@@ -576,8 +546,7 @@ inline void Result<OkType, ErrorType>::moveConstructValue(Result &&result)
  * @brief       Construct the value(void).
  */
 template<typename OkType, typename ErrorType>
-    requires(! ::std::is_array<OkType>::value)
-            && (! ::std::is_array<ErrorType>::value)
+    requires ResultValueType<OkType> && ResultValueType<ErrorType>
             template<typename Type>
                 requires(::std::is_same<Type, OkType>::value
                          || ::std::is_same<Type, ErrorType>::value)
@@ -589,8 +558,7 @@ inline void Result<OkType, ErrorType>::construct()
  * @brief       Construct the value(reference).
  */
 template<typename OkType, typename ErrorType>
-    requires(! ::std::is_array<OkType>::value)
-            && (! ::std::is_array<ErrorType>::value)
+    requires ResultValueType<OkType> && ResultValueType<ErrorType>
             template<typename Type>
                 requires(::std::is_same<Type, OkType>::value
                          || ::std::is_same<Type, ErrorType>::value)
@@ -607,8 +575,7 @@ inline void Result<OkType, ErrorType>::construct(Type ref)
  * @brief       Construct the value(others).
  */
 template<typename OkType, typename ErrorType>
-    requires(! ::std::is_array<OkType>::value)
-            && (! ::std::is_array<ErrorType>::value)
+    requires ResultValueType<OkType> && ResultValueType<ErrorType>
             template<typename Type, typename... Args>
                 requires(::std::is_same<Type, OkType>::value
                          || ::std::is_same<Type, ErrorType>::value)
@@ -625,8 +592,7 @@ inline void Result<OkType, ErrorType>::construct(Args &&...args)
  * @brief       Desctuct the value.
  */
 template<typename OkType, typename ErrorType>
-    requires(! ::std::is_array<OkType>::value)
-            && (! ::std::is_array<ErrorType>::value)
+    requires ResultValueType<OkType> && ResultValueType<ErrorType>
             template<typename Type>
                 requires(::std::is_same<Type, OkType>::value
                          || ::std::is_same<Type, ErrorType>::value)
@@ -640,8 +606,7 @@ inline void Result<OkType, ErrorType>::destruct()
  * @brief       Desctuct the value at the position(trival).
  */
 template<typename OkType, typename ErrorType>
-    requires(! ::std::is_array<OkType>::value)
-            && (! ::std::is_array<ErrorType>::value)
+    requires ResultValueType<OkType> && ResultValueType<ErrorType>
             template<typename Type>
                 requires ::std::is_void<Type>::value
                          || ::std::is_reference<Type>::value
@@ -655,8 +620,7 @@ inline void Result<OkType, ErrorType>::destructAt(
  * @brief       Desctuct the value at the position(non-trival).
  */
 template<typename OkType, typename ErrorType>
-    requires(! ::std::is_array<OkType>::value)
-            && (! ::std::is_array<ErrorType>::value)
+    requires ResultValueType<OkType> && ResultValueType<ErrorType>
             template<typename Type>
                 requires(! ::std::is_void<Type>::value)
                         && (! ::std::is_reference<Type>::value)
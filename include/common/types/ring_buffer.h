@@ -0,0 +1,159 @@
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <type_traits>
+
+namespace remotePortMapper {
+
+/**
+ * @brief       Growable ring buffer.
+ *
+ * @tparam      Type        Type of the element.
+ */
+template<typename Type>
+    requires ::std::is_move_constructible<Type>::value
+class RingBuffer {
+  private:
+    /// Initial capacity.
+    static inline constexpr ::std::size_t initialCapacity = 16;
+
+  private:
+    ::std::unique_ptr<Type[], void (*)(Type *)>
+                  m_buffer;   ///< Buffer, the elements are not constructed.
+    ::std::size_t m_capacity; ///< Capacity, always the power of 2.
+    ::std::size_t m_head;     ///< Index of the first element.
+    ::std::size_t m_size;     ///< Count of elements.
+
+  public:
+    /**
+     * @brief       Constructor.
+     */
+    inline RingBuffer();
+
+    /**
+     * @brief       Move constructor.
+     *
+     * @param[in]   buffer      Buffer to move.
+     */
+    inline RingBuffer(RingBuffer &&buffer);
+
+    RingBuffer(const RingBuffer &) = delete;
+
+    /**
+     * @brief       Destructor.
+     */
+    inline ~RingBuffer();
+
+  public:
+    /**
+     * @brief       Check if the buffer is empty.
+     *
+     * @return      \c true if empty, \c false if not.
+     */
+    inline bool empty() const;
+
+    /**
+     * @brief       Get count of elements.
+     *
+     * @return      Count of elements.
+     */
+    inline ::std::size_t size() const;
+
+    /**
+     * @brief       Get capacity.
+     *
+     * @return      Capacity.
+     */
+    inline ::std::size_t capacity() const;
+
+    /**
+     * @brief       Reserve space, the buffer never shrinks.
+     *
+     * @param[in]   capacity    Minimum capacity.
+     */
+    inline void reserve(::std::size_t capacity);
+
+    /**
+     * @brief       Get the first element.
+     *
+     * @return      Reference to the first element.
+     */
+    inline Type &front();
+
+    /**
+     * @brief       Get the last element.
+     *
+     * @return      Reference to the last element.
+     */
+    inline Type &back();
+
+    /**
+     * @brief       Append an element to the end.
+     *
+     * @param[in]   value       Value to append.
+     */
+    inline void pushBack(Type &&value);
+
+    /**
+     * @brief       Take the first element.
+     *
+     * @return      The first element.
+     */
+    inline Type popFront();
+
+    /**
+     * @brief       Take the last element.
+     *
+     * @return      The last element.
+     */
+    inline Type popBack();
+
+    /**
+     * @brief       Remove all elements.
+     */
+    inline void clear();
+
+  public:
+    /**
+     * @brief       Operator=.
+     *
+     * @param[in]   buffer      Buffer to move.
+     *
+     * @return      *this.
+     */
+    inline RingBuffer &operator=(RingBuffer &&buffer);
+
+    RingBuffer &operator=(const RingBuffer &) = delete;
+
+  private:
+    /**
+     * @brief       Get the element at the position.
+     *
+     * @param[in]   index       Index from the head.
+     *
+     * @return      Pointer to the element.
+     */
+    inline Type *at(::std::size_t index);
+
+    /**
+     * @brief       Allocate uninitialized buffer.
+     *
+     * @param[in]   capacity    Capacity.
+     *
+     * @return      Buffer.
+     */
+    static inline ::std::unique_ptr<Type[], void (*)(Type *)>
+        allocate(::std::size_t capacity);
+
+    /**
+     * @brief       Free the buffer.
+     *
+     * @param[in]   buffer      Buffer to free.
+     */
+    static inline void deallocate(Type *buffer);
+};
+
+} // namespace remotePortMapper
+
+#include <common/types/ring_buffer.hpp>
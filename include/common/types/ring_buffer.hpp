@@ -0,0 +1,250 @@
+#pragma once
+
+#include <algorithm>
+#include <new>
+#include <utility>
+
+#include <common/logger/logger.h>
+
+#include <common/types/ring_buffer.h>
+
+namespace remotePortMapper {
+
+/**
+ * @brief       Constructor.
+ */
+template<typename Type>
+    requires ::std::is_move_constructible<Type>::value
+inline RingBuffer<Type>::RingBuffer() :
+    m_buffer(nullptr, &RingBuffer::deallocate), m_capacity(0), m_head(0),
+    m_size(0)
+{}
+
+/**
+ * @brief       Move constructor.
+ */
+template<typename Type>
+    requires ::std::is_move_constructible<Type>::value
+inline RingBuffer<Type>::RingBuffer(RingBuffer &&buffer) :
+    m_buffer(::std::move(buffer.m_buffer)), m_capacity(buffer.m_capacity),
+    m_head(buffer.m_head), m_size(buffer.m_size)
+{
+    buffer.m_capacity = 0;
+    buffer.m_head     = 0;
+    buffer.m_size     = 0;
+}
+
+/**
+ * @brief       Destructor.
+ */
+template<typename Type>
+    requires ::std::is_move_constructible<Type>::value
+inline RingBuffer<Type>::~RingBuffer()
+{
+    this->clear();
+}
+
+/**
+ * @brief       Check if the buffer is empty.
+ */
+template<typename Type>
+    requires ::std::is_move_constructible<Type>::value
+inline bool RingBuffer<Type>::empty() const
+{
+    return m_size == 0;
+}
+
+/**
+ * @brief       Get count of elements.
+ */
+template<typename Type>
+    requires ::std::is_move_constructible<Type>::value
+inline ::std::size_t RingBuffer<Type>::size() const
+{
+    return m_size;
+}
+
+/**
+ * @brief       Get capacity.
+ */
+template<typename Type>
+    requires ::std::is_move_constructible<Type>::value
+inline ::std::size_t RingBuffer<Type>::capacity() const
+{
+    return m_capacity;
+}
+
+/**
+ * @brief       Reserve space, the buffer never shrinks.
+ */
+template<typename Type>
+    requires ::std::is_move_constructible<Type>::value
+inline void RingBuffer<Type>::reserve(::std::size_t capacity)
+{
+    if (capacity <= m_capacity) {
+        return;
+    }
+
+    // Compute new capacity.
+    ::std::size_t newCapacity = ::std::max(m_capacity, initialCapacity);
+    while (newCapacity < capacity) {
+        newCapacity <<= 1;
+    }
+
+    // Move elements.
+    auto newBuffer = RingBuffer::allocate(newCapacity);
+    for (::std::size_t i = 0; i < m_size; ++i) {
+        Type *value = this->at(i);
+        new (newBuffer.get() + i) Type(::std::move(*value));
+        value->~Type();
+    }
+
+    m_buffer   = ::std::move(newBuffer);
+    m_capacity = newCapacity;
+    m_head     = 0;
+}
+
+/**
+ * @brief       Get the first element.
+ */
+template<typename Type>
+    requires ::std::is_move_constructible<Type>::value
+inline Type &RingBuffer<Type>::front()
+{
+    if (m_size == 0) {
+        panic("Trying to access an empty ring buffer!");
+    }
+
+    return *this->at(0);
+}
+
+/**
+ * @brief       Get the last element.
+ */
+template<typename Type>
+    requires ::std::is_move_constructible<Type>::value
+inline Type &RingBuffer<Type>::back()
+{
+    if (m_size == 0) {
+        panic("Trying to access an empty ring buffer!");
+    }
+
+    return *this->at(m_size - 1);
+}
+
+/**
+ * @brief       Append an element to the end.
+ */
+template<typename Type>
+    requires ::std::is_move_constructible<Type>::value
+inline void RingBuffer<Type>::pushBack(Type &&value)
+{
+    if (m_size == m_capacity) {
+        this->reserve(m_capacity + 1);
+    }
+
+    new (this->at(m_size)) Type(::std::move(value));
+    ++m_size;
+}
+
+/**
+ * @brief       Take the first element.
+ */
+template<typename Type>
+    requires ::std::is_move_constructible<Type>::value
+inline Type RingBuffer<Type>::popFront()
+{
+    Type *value = &this->front();
+    Type  ret(::std::move(*value));
+    value->~Type();
+    m_head = (m_head + 1) & (m_capacity - 1);
+    --m_size;
+
+    return ret;
+}
+
+/**
+ * @brief       Take the last element.
+ */
+template<typename Type>
+    requires ::std::is_move_constructible<Type>::value
+inline Type RingBuffer<Type>::popBack()
+{
+    Type *value = &this->back();
+    Type  ret(::std::move(*value));
+    value->~Type();
+    --m_size;
+
+    return ret;
+}
+
+/**
+ * @brief       Remove all elements.
+ */
+template<typename Type>
+    requires ::std::is_move_constructible<Type>::value
+inline void RingBuffer<Type>::clear()
+{
+    for (::std::size_t i = 0; i < m_size; ++i) {
+        this->at(i)->~Type();
+    }
+    m_head = 0;
+    m_size = 0;
+}
+
+/**
+ * @brief       Operator=.
+ */
+template<typename Type>
+    requires ::std::is_move_constructible<Type>::value
+inline RingBuffer<Type> &RingBuffer<Type>::operator=(RingBuffer &&buffer)
+{
+    if (this != &buffer) {
+        this->clear();
+        m_buffer          = ::std::move(buffer.m_buffer);
+        m_capacity        = buffer.m_capacity;
+        m_head            = buffer.m_head;
+        m_size            = buffer.m_size;
+        buffer.m_capacity = 0;
+        buffer.m_head     = 0;
+        buffer.m_size     = 0;
+    }
+
+    return *this;
+}
+
+/**
+ * @brief       Get the element at the position.
+ */
+template<typename Type>
+    requires ::std::is_move_constructible<Type>::value
+inline Type *RingBuffer<Type>::at(::std::size_t index)
+{
+    return m_buffer.get() + ((m_head + index) & (m_capacity - 1));
+}
+
+/**
+ * @brief       Allocate uninitialized buffer.
+ */
+template<typename Type>
+    requires ::std::is_move_constructible<Type>::value
+inline ::std::unique_ptr<Type[], void (*)(Type *)>
+    RingBuffer<Type>::allocate(::std::size_t capacity)
+{
+    return ::std::unique_ptr<Type[], void (*)(Type *)>(
+        reinterpret_cast<Type *>(::operator new(
+            sizeof(Type) * capacity, ::std::align_val_t(alignof(Type)))),
+        &RingBuffer::deallocate);
+}
+
+/**
+ * @brief       Free the buffer.
+ */
+template<typename Type>
+    requires ::std::is_move_constructible<Type>::value
+inline void RingBuffer<Type>::deallocate(Type *buffer)
+{
+    ::operator delete(buffer, ::std::align_val_t(alignof(Type)));
+}
+
+} // namespace remotePortMapper
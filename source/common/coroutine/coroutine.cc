@@ -0,0 +1,15 @@
+#include <common/logger/logger.h>
+
+#include <common/coroutine/coroutine.h>
+
+namespace remotePortMapper {
+
+/**
+ * @brief       Handle unhandled exception.
+ */
+void CoroutinePromiseBase::unhandled_exception() noexcept
+{
+    panic("Unhandled exception in coroutine.");
+}
+
+} // namespace remotePortMapper
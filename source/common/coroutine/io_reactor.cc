@@ -0,0 +1,279 @@
+#if defined(OS_LINUX)
+
+    #include <cerrno>
+    #include <cstring>
+    #include <sstream>
+
+    #include <sys/epoll.h>
+    #include <sys/eventfd.h>
+    #include <unistd.h>
+
+    #include <common/logger/logger.h>
+
+    #include <common/coroutine/io_reactor.h>
+
+namespace remotePortMapper {
+
+/**
+ * @brief       Constructor.
+ */
+IoReactor::IoReactor(::std::shared_ptr<ThreadPool> threadPool) :
+    m_threadPool(threadPool), m_epollFd(-1), m_wakeupFd(-1), m_running(false)
+{
+    if (threadPool == nullptr) {
+        this->setInitializeResult(Result<void, Error>::makeError(
+            Error {ErrorCode::InvalidValue, "Thread pool is null."}));
+        return;
+    }
+
+    m_epollFd  = ::epoll_create1(EPOLL_CLOEXEC);
+    m_wakeupFd = ::eventfd(0, EFD_CLOEXEC | EFD_NONBLOCK);
+    if (m_epollFd < 0 || m_wakeupFd < 0) {
+        ::std::ostringstream ss;
+        ss << "Failed to create reactor, errno: " << errno << ".";
+        this->setInitializeResult(Result<void, Error>::makeError(
+            Error {ErrorCode::InvalidValue, ss.str()}));
+        return;
+    }
+
+    ::epoll_event event = {};
+    event.events        = EPOLLIN;
+    event.data.fd       = m_wakeupFd;
+    if (::epoll_ctl(m_epollFd, EPOLL_CTL_ADD, m_wakeupFd, &event) != 0) {
+        ::std::ostringstream ss;
+        ss << "Failed to register wakeup fd, errno: " << errno << ".";
+        this->setInitializeResult(Result<void, Error>::makeError(
+            Error {ErrorCode::InvalidValue, ss.str()}));
+        return;
+    }
+
+    m_running = true;
+    m_thread  = ::std::thread(&IoReactor::reactorThread, this);
+
+    this->setInitializeResult(Result<void, Error>::makeOk());
+}
+
+/**
+ * @brief       Destructor, awaiting coroutines are resumed with an error.
+ */
+IoReactor::~IoReactor()
+{
+    if (m_thread.joinable()) {
+        {
+            ::std::lock_guard<::std::mutex> lock(m_lock);
+            m_running = false;
+        }
+        uint64_t value = 1;
+        if (::write(m_wakeupFd, &value, sizeof(value)) < 0) {
+            panic("Failed to wake up reactor thread, errno: " << errno
+                                                               << ".");
+        }
+        m_thread.join();
+    }
+
+    for (auto &[fd, waiters] : m_waiters) {
+        for (WaitAwaiter *awaiter : {waiters.readable, waiters.writeable}) {
+            if (awaiter != nullptr) {
+                this->resume(awaiter,
+                             Result<void, StaticError>::makeError(StaticError {
+                                 ErrorCode::InvalidValue,
+                                 "Reactor destroyed while awaiting."}));
+            }
+        }
+    }
+    m_waiters.clear();
+
+    if (m_wakeupFd >= 0) {
+        ::close(m_wakeupFd);
+    }
+    if (m_epollFd >= 0) {
+        ::close(m_epollFd);
+    }
+}
+
+/**
+ * @brief       Await an event of a fd.
+ */
+IoReactor::WaitAwaiter IoReactor::wait(int fd, EventLoop::Event event)
+{
+    return WaitAwaiter(this, fd, event);
+}
+
+/**
+ * @brief       Register an awaiter.
+ */
+Result<void, StaticError> IoReactor::addWaiter(WaitAwaiter *awaiter)
+{
+    // Errors are returned on every await, none of them allocates.
+    ::std::lock_guard<::std::mutex> lock(m_lock);
+    if (! m_running) {
+        return Result<void, StaticError>::makeError(
+            StaticError {ErrorCode::InvalidValue, "Reactor is not running."});
+    }
+
+    auto [iter, inserted] = m_waiters.try_emplace(awaiter->m_fd,
+                                                  Waiters {nullptr, nullptr});
+    Waiters      &waiters = iter->second;
+    WaitAwaiter *&slot    = awaiter->m_event == EventLoop::Event::Readable
+                                ? waiters.readable
+                                : waiters.writeable;
+    if (slot != nullptr) {
+        return Result<void, StaticError>::makeError(StaticError {
+            ErrorCode::InvalidValue, "Event of fd is already awaited."});
+    }
+    slot = awaiter;
+
+    ::epoll_event event = {};
+    event.events        = IoReactor::epollEvents(waiters);
+    event.data.fd       = awaiter->m_fd;
+    if (::epoll_ctl(m_epollFd, inserted ? EPOLL_CTL_ADD : EPOLL_CTL_MOD,
+                    awaiter->m_fd, &event)
+        != 0) {
+        int error = errno;
+        slot      = nullptr;
+        if (inserted) {
+            m_waiters.erase(iter);
+        }
+        return Result<void, StaticError>::makeError(StaticError {
+            ErrorCode::InvalidValue, "Failed to register fd.", error});
+    }
+
+    return Result<void, StaticError>::makeOk();
+}
+
+/**
+ * @brief       Get epoll events of waiters.
+ */
+uint32_t IoReactor::epollEvents(const Waiters &waiters)
+{
+    uint32_t events = EPOLLONESHOT;
+    if (waiters.readable != nullptr) {
+        events |= EPOLLIN | EPOLLRDHUP;
+    }
+    if (waiters.writeable != nullptr) {
+        events |= EPOLLOUT;
+    }
+
+    return events;
+}
+
+/**
+ * @brief       Resume an awaiter on the thread pool.
+ */
+void IoReactor::resume(WaitAwaiter              *awaiter,
+                       Result<void, StaticError> result)
+{
+    awaiter->m_result = ::std::move(result);
+    m_threadPool->addTask([handle = awaiter->m_handle]() -> void {
+        handle.resume();
+    });
+}
+
+/**
+ * @brief       Reactor thread function.
+ */
+void IoReactor::reactorThread()
+{
+    ::epoll_event events[_maxEvents];
+    while (true) {
+        int count = ::epoll_wait(m_epollFd, events, _maxEvents, -1);
+        if (count < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            panic("Failed to wait for events, errno: " << errno << ".");
+        }
+
+        ::std::lock_guard<::std::mutex> lock(m_lock);
+        if (! m_running) {
+            return;
+        }
+
+        for (int i = 0; i < count; ++i) {
+            auto iter = m_waiters.find(events[i].data.fd);
+            if (iter == m_waiters.end()) {
+                continue;
+            }
+
+            // Errors and hangups wake up all waiters, the following I/O
+            // reports the error.
+            Waiters &waiters = iter->second;
+            uint32_t ready   = events[i].events;
+            if (waiters.readable != nullptr
+                && (ready & (EPOLLIN | EPOLLRDHUP | EPOLLERR | EPOLLHUP))) {
+                this->resume(waiters.readable,
+                             Result<void, StaticError>::makeOk());
+                waiters.readable = nullptr;
+            }
+            if (waiters.writeable != nullptr
+                && (ready & (EPOLLOUT | EPOLLERR | EPOLLHUP))) {
+                this->resume(waiters.writeable,
+                             Result<void, StaticError>::makeOk());
+                waiters.writeable = nullptr;
+            }
+
+            // Rearm for events still awaited.
+            int fd = iter->first;
+            if (waiters.readable == nullptr && waiters.writeable == nullptr) {
+                m_waiters.erase(iter);
+                ::epoll_ctl(m_epollFd, EPOLL_CTL_DEL, fd, nullptr);
+            } else {
+                ::epoll_event event = {};
+                event.events        = IoReactor::epollEvents(waiters);
+                event.data.fd       = fd;
+                if (::epoll_ctl(m_epollFd, EPOLL_CTL_MOD, fd, &event) != 0) {
+                    log_warning("Failed to rearm fd " << fd
+                                                      << ", errno: " << errno
+                                                      << ".");
+                }
+            }
+        }
+    }
+}
+
+/**
+ * @brief       Constructor.
+ */
+IoReactor::WaitAwaiter::WaitAwaiter(IoReactor       *reactor,
+                                    int              fd,
+                                    EventLoop::Event event) :
+    m_reactor(reactor),
+    m_fd(fd), m_event(event), m_handle(nullptr)
+{}
+
+/**
+ * @brief       Check if ready.
+ */
+bool IoReactor::WaitAwaiter::await_ready() const noexcept
+{
+    return false;
+}
+
+/**
+ * @brief       Register the awaiting coroutine.
+ */
+bool IoReactor::WaitAwaiter::await_suspend(::std::coroutine_handle<> handle)
+{
+    // The coroutine may be resumed on another thread as soon as it is
+    // registered, the awaiter must not be touched after success.
+    m_handle                         = handle;
+    Result<void, StaticError> result = m_reactor->addWaiter(this);
+    if (result.ok()) {
+        return true;
+    }
+
+    m_result = ::std::move(result);
+    return false;
+}
+
+/**
+ * @brief       Resume.
+ */
+Result<void, StaticError> IoReactor::WaitAwaiter::await_resume()
+{
+    return ::std::move(m_result);
+}
+
+} // namespace remotePortMapper
+
+#endif
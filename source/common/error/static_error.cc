@@ -0,0 +1,32 @@
+#include <system_error>
+
+#include <common/error/static_error.h>
+
+namespace remotePortMapper {
+
+/**
+ * @brief       Build the message with the detail.
+ */
+::std::string StaticError::detail() const
+{
+    ::std::string ret(message);
+    if (systemError != 0) {
+        ret += " errno ";
+        ret += ::std::to_string(systemError);
+        ret += ": ";
+        ret += ::std::system_category().message(systemError);
+        ret += ".";
+    }
+
+    return ret;
+}
+
+/**
+ * @brief       Convert to \c Error.
+ */
+StaticError::operator Error() const
+{
+    return Error {errCode, this->detail()};
+}
+
+} // namespace remotePortMapper
@@ -17,7 +17,8 @@ namespace remotePortMapper {
 /**
  * @brief       Fill the socket address.
  */
-Result<void, Error> SocketAddress::fill(const ::std::string &ip, uint16_t port)
+Result<void, StaticError> SocketAddress::fill(const ::std::string &ip,
+                                              uint16_t             port)
 {
     static ::std::regex ipv4Exp("\\d{1,3}\\.\\d{1,3}\\.\\d{1,3}\\.\\d{1,3}");
 
@@ -29,7 +30,7 @@ Result<void, Error> SocketAddress::fill(const ::std::string &ip, uint16_t port)
             m_data.addr4.sin_family = AF_INET;
             m_data.addr4.sin_port   = htons(port);
 
-            return Result<void, Error>::makeOk();
+            return Result<void, StaticError>::makeOk();
         }
 
     } else {
@@ -39,18 +40,14 @@ Result<void, Error> SocketAddress::fill(const ::std::string &ip, uint16_t port)
             m_data.addr6.sin6_family = AF_INET6;
             m_data.addr6.sin6_port   = htons(port);
 
-            return Result<void, Error>::makeOk();
+            return Result<void, StaticError>::makeOk();
         }
     }
 
-    // Error.
+    // Error, the address is known to the caller.
     m_type = Type::Unknow;
-    ::std::ostringstream ss;
-
-    ss << "Illegal IP address \"" << ip << "\".";
-
-    return Result<void, Error>::makeError(
-        Error {ErrorCode::InvalidValue, ss.str()});
+    return Result<void, StaticError>::makeError(
+        StaticError {ErrorCode::InvalidValue, "Illegal IP address."});
 }
 
 /**
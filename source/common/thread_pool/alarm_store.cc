@@ -0,0 +1,296 @@
+#include <algorithm>
+
+#include <common/logger/logger.h>
+
+#include <common/thread_pool/thread_pool.h>
+
+namespace remotePortMapper {
+
+/**
+ * @brief       Check if the store is empty.
+ */
+bool ThreadPool::SortedAlarmStore::empty() const
+{
+    return m_alarmMap.empty();
+}
+
+/**
+ * @brief       Insert an alarm.
+ */
+void ThreadPool::SortedAlarmStore::insert(
+    const ::std::shared_ptr<AsyncAlarm> &alarm)
+{
+    m_alarmMap[alarm->m_deadline].insert(alarm);
+}
+
+/**
+ * @brief       Remove an alarm.
+ */
+void ThreadPool::SortedAlarmStore::remove(
+    const ::std::shared_ptr<AsyncAlarm> &alarm)
+{
+    auto iter = m_alarmMap.find(alarm->m_deadline);
+    if (iter == m_alarmMap.end()) {
+        return;
+    }
+
+    iter->second.erase(alarm);
+    if (iter->second.empty()) {
+        m_alarmMap.erase(iter);
+    }
+}
+
+/**
+ * @brief       Get the timepoint the store needs to be checked.
+ */
+::std::chrono::steady_clock::time_point
+    ThreadPool::SortedAlarmStore::nextTimepoint() const
+{
+    return m_alarmMap.begin()->first;
+}
+
+/**
+ * @brief       Take expired alarms.
+ */
+void ThreadPool::SortedAlarmStore::takeExpired(
+    ::std::chrono::steady_clock::time_point       now,
+    ::std::vector<::std::shared_ptr<AsyncAlarm>> &alarms)
+{
+    while (! m_alarmMap.empty() && m_alarmMap.begin()->first <= now) {
+        auto iter = m_alarmMap.begin();
+        alarms.insert(alarms.end(), iter->second.begin(), iter->second.end());
+        m_alarmMap.erase(iter);
+    }
+}
+
+/**
+ * @brief       Constructor.
+ */
+ThreadPool::TimingWheelAlarmStore::TimingWheelAlarmStore(
+    ::std::chrono::steady_clock::time_point start,
+    ::std::chrono::steady_clock::duration   tick) :
+    m_start(start),
+    m_tick(::std::max(tick, ::std::chrono::steady_clock::duration(1))),
+    m_wheel(0)
+{}
+
+/**
+ * @brief       Destructor.
+ */
+ThreadPool::TimingWheelAlarmStore::~TimingWheelAlarmStore()
+{
+    // Drop references held by the alarms still in the wheel.
+    m_wheel.clear(m_expired);
+    for (auto node : m_expired) {
+        static_cast<AsyncAlarm *>(node)->m_storeRef.reset();
+    }
+}
+
+/**
+ * @brief       Check if the store is empty.
+ */
+bool ThreadPool::TimingWheelAlarmStore::empty() const
+{
+    return m_wheel.empty();
+}
+
+/**
+ * @brief       Insert an alarm.
+ */
+void ThreadPool::TimingWheelAlarmStore::insert(
+    const ::std::shared_ptr<AsyncAlarm> &alarm)
+{
+    // Round up, an alarm never fires before its timepoint.
+    auto     offset = alarm->m_deadline - m_start;
+    uint64_t tick   = 0;
+    if (offset.count() > 0) {
+        tick = static_cast<uint64_t>((offset + m_tick - decltype(offset)(1))
+                                     / m_tick);
+    }
+
+    alarm->m_storeRef = alarm;
+    m_wheel.insert(alarm.get(), tick);
+}
+
+/**
+ * @brief       Remove an alarm.
+ */
+void ThreadPool::TimingWheelAlarmStore::remove(
+    const ::std::shared_ptr<AsyncAlarm> &alarm)
+{
+    if (static_cast<TimingWheelNode *>(alarm.get())->linked()) {
+        m_wheel.remove(alarm.get());
+        alarm->m_storeRef.reset();
+    }
+}
+
+/**
+ * @brief       Get the timepoint the store needs to be checked.
+ */
+::std::chrono::steady_clock::time_point
+    ThreadPool::TimingWheelAlarmStore::nextTimepoint() const
+{
+    return m_start
+           + m_tick * static_cast<decltype(m_tick)::rep>(m_wheel.nextTick());
+}
+
+/**
+ * @brief       Take expired alarms.
+ */
+void ThreadPool::TimingWheelAlarmStore::takeExpired(
+    ::std::chrono::steady_clock::time_point       now,
+    ::std::vector<::std::shared_ptr<AsyncAlarm>> &alarms)
+{
+    if (now < m_start) {
+        return;
+    }
+
+    m_wheel.advance(static_cast<uint64_t>((now - m_start) / m_tick),
+                    m_expired);
+    for (auto node : m_expired) {
+        alarms.push_back(
+            ::std::move(static_cast<AsyncAlarm *>(node)->m_storeRef));
+    }
+    m_expired.clear();
+}
+
+/**
+ * @brief       Constructor.
+ */
+ThreadPool::TimerStore::TimerStore(
+    ::std::chrono::steady_clock::time_point start,
+    ::std::chrono::steady_clock::duration   tick) :
+    m_freeSlot(_noSlot),
+    m_start(start),
+    m_tick(::std::max(tick, ::std::chrono::steady_clock::duration(1))),
+    m_wheel(0)
+{}
+
+/**
+ * @brief       Destructor.
+ */
+ThreadPool::TimerStore::~TimerStore()
+{
+    // Unlink slots before the chunks are freed.
+    m_wheel.clear(m_expired);
+}
+
+/**
+ * @brief       Check if the store is empty.
+ */
+bool ThreadPool::TimerStore::empty() const
+{
+    return m_wheel.empty();
+}
+
+/**
+ * @brief       Insert a timer.
+ */
+ThreadPool::TimerHandle ThreadPool::TimerStore::insert(
+    ::std::chrono::steady_clock::time_point deadline, Task task)
+{
+    // Grow by a chunk, the only allocation of timers.
+    if (m_freeSlot == _noSlot) {
+        uint32_t base = static_cast<uint32_t>(m_chunks.size()) * _chunkSize;
+        if (base > _noSlot - _chunkSize) {
+            panic("Too many pending timers.");
+        }
+        m_chunks.push_back(::std::make_unique<TimerSlot[]>(_chunkSize));
+        auto &chunk = m_chunks.back();
+        for (uint32_t i = 0; i < _chunkSize; ++i) {
+            chunk[i].index      = base + i;
+            chunk[i].generation = 1;
+            chunk[i].nextFree   = i + 1 < _chunkSize ? base + i + 1 : _noSlot;
+        }
+        m_freeSlot = base;
+    }
+
+    TimerSlot &slot = this->slot(m_freeSlot);
+    m_freeSlot      = slot.nextFree;
+    slot.task       = ::std::move(task);
+    slot.deadline   = deadline;
+
+    // Round up, a timer never fires before its timepoint.
+    auto     offset = deadline - m_start;
+    uint64_t tick   = 0;
+    if (offset.count() > 0) {
+        tick = static_cast<uint64_t>((offset + m_tick - decltype(offset)(1))
+                                     / m_tick);
+    }
+    m_wheel.insert(&slot, tick);
+
+    return TimerHandle {.index = slot.index, .generation = slot.generation};
+}
+
+/**
+ * @brief       Remove a timer.
+ */
+bool ThreadPool::TimerStore::remove(TimerHandle handle, Task &task)
+{
+    if (handle.generation == 0
+        || handle.index >= m_chunks.size() * _chunkSize) {
+        return false;
+    }
+
+    // A slot fired or canceled has a newer generation.
+    TimerSlot &slot = this->slot(handle.index);
+    if (slot.generation != handle.generation || ! slot.linked()) {
+        return false;
+    }
+
+    m_wheel.remove(&slot);
+    task = ::std::move(slot.task);
+    this->freeSlot(slot);
+
+    return true;
+}
+
+/**
+ * @brief       Get the timepoint the store needs to be checked.
+ */
+::std::chrono::steady_clock::time_point
+    ThreadPool::TimerStore::nextTimepoint() const
+{
+    return m_start
+           + m_tick * static_cast<decltype(m_tick)::rep>(m_wheel.nextTick());
+}
+
+/**
+ * @brief       Take tasks of expired timers and free their slots.
+ */
+void ThreadPool::TimerStore::takeExpired(
+    ::std::chrono::steady_clock::time_point now,
+    ::std::vector<Task>                    &tasks,
+    Histogram                              *lateness)
+{
+    if (now < m_start) {
+        return;
+    }
+
+    m_wheel.advance(static_cast<uint64_t>((now - m_start) / m_tick),
+                    m_expired);
+    for (auto node : m_expired) {
+        auto &slot = *static_cast<TimerSlot *>(node);
+        if (lateness != nullptr) {
+            lateness->record(ThreadPool::nanoseconds(now - slot.deadline));
+        }
+        tasks.push_back(::std::move(slot.task));
+        this->freeSlot(slot);
+    }
+    m_expired.clear();
+}
+
+/**
+ * @brief       Free a slot.
+ */
+void ThreadPool::TimerStore::freeSlot(TimerSlot &slot)
+{
+    // Generation 0 marks invalid handles and is never used.
+    if (++slot.generation == 0) {
+        slot.generation = 1;
+    }
+    slot.nextFree = m_freeSlot;
+    m_freeSlot    = slot.index;
+}
+
+} // namespace remotePortMapper
@@ -0,0 +1,100 @@
+#include <algorithm>
+
+#include <common/logger/logger.h>
+
+#include <common/thread_pool/blocking_pool.h>
+
+namespace remotePortMapper {
+
+/**
+ * @brief       Constructor.
+ */
+BlockingPool::BlockingPool(::std::shared_ptr<ThreadPool> threadPool,
+                           BlockingPoolOptions           options) :
+    m_threadPool(threadPool),
+    m_maxTasks(::std::max(options.maxThreads, static_cast<::std::size_t>(1))
+               + options.maxQueued),
+    m_tasks(0)
+{
+    if (threadPool == nullptr) {
+        this->setInitializeResult(Result<void, Error>::makeError(
+            Error {ErrorCode::InvalidValue, "Thread pool is null."}));
+        return;
+    }
+
+    // An elastic pool spawns a thread only when all threads are blocked.
+    auto result = ThreadPool::create(ThreadPoolOptions {
+        .workers                 = 1,
+        .maxWorkers              = options.maxThreads,
+        .workerIdleTimeout       = options.idleTimeout,
+        .telemetrySampleInterval = 0});
+    if (! result) {
+        this->setInitializeResult(
+            Result<void, Error>::makeError(result.value<Error>()));
+        return;
+    }
+    m_threads = result.value<::std::shared_ptr<ThreadPool>>();
+
+    this->setInitializeResult(Result<void, Error>::makeOk());
+    log_info("\"BlockingPool\" at " << this << " initialized with up to "
+                                    << options.maxThreads << " threads and "
+                                    << options.maxQueued << " queued tasks.");
+}
+
+/**
+ * @brief       Destructor.
+ */
+BlockingPool::~BlockingPool()
+{
+    log_info("\"BlockingPool\" at " << this << " destroyed.");
+}
+
+/**
+ * @brief       Get main thread pool.
+ */
+::std::shared_ptr<ThreadPool> BlockingPool::threadPool() const
+{
+    return m_threadPool.lock();
+}
+
+/**
+ * @brief       Get count of threads.
+ */
+::std::size_t BlockingPool::threadCount() const
+{
+    return m_threads->workerCount();
+}
+
+/**
+ * @brief       Get count of tasks running or waiting for a thread.
+ */
+::std::size_t BlockingPool::pendingTasks() const
+{
+    return m_tasks.load(::std::memory_order_relaxed);
+}
+
+/**
+ * @brief       Take a place for a task.
+ */
+bool BlockingPool::acquire()
+{
+    ::std::size_t tasks = m_tasks.load(::std::memory_order_relaxed);
+    do {
+        if (tasks >= m_maxTasks) {
+            return false;
+        }
+    } while (! m_tasks.compare_exchange_weak(tasks, tasks + 1,
+                                             ::std::memory_order_relaxed));
+
+    return true;
+}
+
+/**
+ * @brief       Release the place of a finished task.
+ */
+void BlockingPool::release()
+{
+    m_tasks.fetch_sub(1, ::std::memory_order_relaxed);
+}
+
+} // namespace remotePortMapper
@@ -0,0 +1,358 @@
+#include <algorithm>
+#include <cctype>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include <thread>
+
+#if defined(OS_LINUX)
+    #include <pthread.h>
+    #include <sched.h>
+
+#elif defined(OS_WINDOWS)
+    #include <windows.h>
+
+#endif
+
+#include <common/logger/logger.h>
+
+#include <common/thread_pool/cpu_topology.h>
+
+namespace remotePortMapper {
+
+/**
+ * @brief       Detect NUMA nodes.
+ *
+ * @return      NUMA nodes which have usable CPUs.
+ */
+static ::std::vector<NumaNode> detectNumaNodes()
+{
+    ::std::vector<uint32_t> allowed = CpuTopology::allowedCpus();
+    ::std::vector<NumaNode> ret;
+
+#if defined(OS_LINUX)
+    ::std::error_code error;
+    for (auto &entry : ::std::filesystem::directory_iterator(
+             "/sys/devices/system/node", error)) {
+        ::std::string name = entry.path().filename().string();
+        if (name.size() <= 4 || name.compare(0, 4, "node") != 0
+            || ! ::std::all_of(name.begin() + 4, name.end(), ::isdigit)) {
+            continue;
+        }
+
+        ::std::ifstream    file(entry.path() / "cpulist");
+        ::std::string      list;
+        ::std::getline(file, list);
+        auto result = CpuTopology::parseCpuList(list);
+        if (! result) {
+            log_warning("Failed to parse CPU list of NUMA node \""
+                        << name << "\": "
+                        << result.value<Error>().message);
+            continue;
+        }
+
+        NumaNode node {.id = static_cast<uint32_t>(::std::stoul(
+                           name.substr(4))),
+                       .cpus = {}};
+        for (uint32_t cpu : result.value<::std::vector<uint32_t>>()) {
+            if (::std::binary_search(allowed.begin(), allowed.end(), cpu)) {
+                node.cpus.push_back(cpu);
+            }
+        }
+        if (! node.cpus.empty()) {
+            ret.push_back(::std::move(node));
+        }
+    }
+    ::std::sort(ret.begin(), ret.end(),
+                [](const NumaNode &a, const NumaNode &b) -> bool {
+                    return a.id < b.id;
+                });
+
+#endif
+
+    if (ret.empty()) {
+        ret.push_back(NumaNode {.id = 0, .cpus = ::std::move(allowed)});
+    }
+
+    return ret;
+}
+
+/**
+ * @brief       Get NUMA nodes, detected once.
+ */
+const ::std::vector<NumaNode> &CpuTopology::numaNodes()
+{
+    static const ::std::vector<NumaNode> nodes = detectNumaNodes();
+
+    return nodes;
+}
+
+/**
+ * @brief       Get all usable CPUs, ordered by NUMA node.
+ */
+::std::vector<uint32_t> CpuTopology::cpus()
+{
+    ::std::vector<uint32_t> ret;
+    for (auto &node : CpuTopology::numaNodes()) {
+        ret.insert(ret.end(), node.cpus.begin(), node.cpus.end());
+    }
+
+    return ret;
+}
+
+/**
+ * @brief       Get CPUs the process may run on.
+ */
+::std::vector<uint32_t> CpuTopology::allowedCpus()
+{
+    ::std::vector<uint32_t> ret;
+
+#if defined(OS_LINUX)
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    if (::sched_getaffinity(0, sizeof(set), &set) == 0) {
+        for (uint32_t cpu = 0; cpu < CPU_SETSIZE; ++cpu) {
+            if (CPU_ISSET(cpu, &set)) {
+                ret.push_back(cpu);
+            }
+        }
+    }
+
+#endif
+
+    if (ret.empty()) {
+        uint32_t count = ::std::max(::std::thread::hardware_concurrency(), 1U);
+        for (uint32_t cpu = 0; cpu < count; ++cpu) {
+            ret.push_back(cpu);
+        }
+    }
+
+    return ret;
+}
+
+/**
+ * @brief       Get count of CPUs the CPU quota of the process allows.
+ */
+uint32_t CpuTopology::cpuQuota()
+{
+#if defined(OS_LINUX)
+    ::std::ifstream     file("/proc/self/cgroup");
+    ::std::stringstream cgroups;
+    cgroups << file.rdbuf();
+
+    return CpuTopology::cpuQuota("/sys/fs/cgroup", cgroups.str());
+
+#else
+    return 0;
+
+#endif
+}
+
+/**
+ * @brief       Get count of CPUs a quota allows.
+ *
+ * @param[in]   quota       Quota of CPU time in each period, negative if
+ *                          unlimited.
+ * @param[in]   period      Period.
+ *
+ * @return      CPUs rounded up, \c 0 if unlimited.
+ */
+static uint32_t quotaCpus(long long quota, long long period)
+{
+    if (quota <= 0 || period <= 0) {
+        return 0;
+    }
+
+    return static_cast<uint32_t>(
+        ::std::max((quota + period - 1) / period, 1LL));
+}
+
+/**
+ * @brief       Read first line of a file.
+ *
+ * @param[in]   path        Path of the file.
+ * @param[out]  line        Line read.
+ *
+ * @return      \c true if read, \c false if not.
+ */
+static bool readLine(const ::std::filesystem::path &path, ::std::string &line)
+{
+    ::std::ifstream file(path);
+
+    return static_cast<bool>(::std::getline(file, line));
+}
+
+/**
+ * @brief       Get count of CPUs a CPU quota allows.
+ */
+uint32_t CpuTopology::cpuQuota(const ::std::string &cgroupRoot,
+                               const ::std::string &cgroups)
+{
+    uint32_t             ret = 0;
+    ::std::istringstream stream(cgroups);
+    ::std::string        entry;
+    while (::std::getline(stream, entry)) {
+        // "id:controllers:path", cgroup v2 has ID 0 and no controllers.
+        auto first  = entry.find(':');
+        auto second = entry.find(':', first + 1);
+        if (first == ::std::string::npos || second == ::std::string::npos) {
+            continue;
+        }
+        ::std::string controllers
+            = entry.substr(first + 1, second - first - 1);
+        ::std::filesystem::path path
+            = ::std::filesystem::path(entry.substr(second + 1))
+                  .relative_path();
+
+        ::std::filesystem::path mount;
+        if (controllers.empty()) {
+            mount = cgroupRoot;
+        } else {
+            ::std::istringstream names(controllers);
+            ::std::string        name;
+            bool                 cpu = false;
+            while (::std::getline(names, name, ',')) {
+                cpu = cpu || name == "cpu";
+            }
+            if (! cpu) {
+                continue;
+            }
+            mount = ::std::filesystem::path(cgroupRoot) / controllers;
+        }
+
+        // Limits of ancestors apply too. Without a cgroup namespace the
+        // path is the one on the host, only its tail may be mounted.
+        while (true) {
+            ::std::filesystem::path directory = mount / path;
+            ::std::string           line;
+            long long               quota  = -1;
+            long long               period = 0;
+            if (controllers.empty()) {
+                if (readLine(directory / "cpu.max", line)) {
+                    ::sscanf(line.c_str(), "%lld %lld", &quota, &period);
+                }
+            } else if (readLine(directory / "cpu.cfs_quota_us", line)) {
+                ::sscanf(line.c_str(), "%lld", &quota);
+                if (readLine(directory / "cpu.cfs_period_us", line)) {
+                    ::sscanf(line.c_str(), "%lld", &period);
+                }
+            }
+
+            uint32_t cpus = quotaCpus(quota, period);
+            if (cpus != 0 && (ret == 0 || cpus < ret)) {
+                ret = cpus;
+            }
+
+            if (path.empty()) {
+                break;
+            }
+            path = path.parent_path();
+        }
+    }
+
+    return ret;
+}
+
+/**
+ * @brief       Get count of CPUs the process can use.
+ */
+uint32_t CpuTopology::availableCpuCount()
+{
+    uint32_t ret   = static_cast<uint32_t>(CpuTopology::allowedCpus().size());
+    uint32_t quota = CpuTopology::cpuQuota();
+    if (quota != 0) {
+        ret = ::std::min(ret, quota);
+    }
+
+    return ::std::max(ret, 1U);
+}
+
+/**
+ * @brief       Pin current thread to a CPU.
+ */
+Result<void, Error> CpuTopology::pinCurrentThread(uint32_t cpu)
+{
+    ::std::ostringstream ss;
+
+#if defined(OS_LINUX)
+    if (cpu >= CPU_SETSIZE) {
+        ss << "CPU " << cpu << " is out of range.";
+        return Result<void, Error>::makeError(
+            Error {ErrorCode::InvalidValue, ss.str()});
+    }
+
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    CPU_SET(cpu, &set);
+    int error = ::pthread_setaffinity_np(::pthread_self(), sizeof(set), &set);
+    if (error == 0) {
+        return Result<void, Error>::makeOk();
+    }
+    ss << "Failed to pin thread to CPU " << cpu << ", errno: " << error
+       << ".";
+
+#elif defined(OS_WINDOWS)
+    if (cpu < sizeof(DWORD_PTR) * 8
+        && ::SetThreadAffinityMask(::GetCurrentThread(),
+                                   static_cast<DWORD_PTR>(1) << cpu)
+               != 0) {
+        return Result<void, Error>::makeOk();
+    }
+    ss << "Failed to pin thread to CPU " << cpu << ".";
+
+#else
+    #error Target platform not supported.
+
+#endif
+
+    return Result<void, Error>::makeError(
+        Error {ErrorCode::InvalidValue, ss.str()});
+}
+
+/**
+ * @brief       Parse CPU list like "0-3,8,10-11".
+ */
+Result<::std::vector<uint32_t>, Error>
+    CpuTopology::parseCpuList(const ::std::string &list)
+{
+    ::std::vector<uint32_t> ret;
+    ::std::istringstream    stream(list);
+    ::std::string           range;
+    while (::std::getline(stream, range, ',')) {
+        // Trim.
+        range.erase(0, range.find_first_not_of(" \t\r\n"));
+        range.erase(range.find_last_not_of(" \t\r\n") + 1);
+        if (range.empty()) {
+            continue;
+        }
+
+        unsigned long first = 0;
+        unsigned long last  = 0;
+        char          dash  = '\0';
+        char          rest  = '\0';
+        int           count = ::sscanf(range.c_str(), "%lu%c%lu%c", &first,
+                                       &dash, &last, &rest);
+        if (count == 1
+            && range.find_first_not_of("0123456789") == ::std::string::npos) {
+            last = first;
+        } else if (count != 3 || dash != '-' || first > last
+                   || range.find_first_not_of("0123456789-")
+                          != ::std::string::npos) {
+            return Result<::std::vector<uint32_t>, Error>::makeError(
+                Error {ErrorCode::InvalidValue,
+                       "Illegal CPU list \"" + list + "\"."});
+        }
+
+        for (unsigned long cpu = first; cpu <= last; ++cpu) {
+            ret.push_back(static_cast<uint32_t>(cpu));
+        }
+    }
+
+    ::std::sort(ret.begin(), ret.end());
+    ret.erase(::std::unique(ret.begin(), ret.end()), ret.end());
+
+    return Result<::std::vector<uint32_t>, Error>::makeOk(::std::move(ret));
+}
+
+} // namespace remotePortMapper
@@ -0,0 +1,86 @@
+#include <algorithm>
+#include <cmath>
+
+#include <common/thread_pool/histogram.h>
+
+namespace remotePortMapper {
+
+/**
+ * @brief       Get mean value.
+ */
+double HistogramSnapshot::mean() const
+{
+    if (count == 0) {
+        return 0;
+    }
+
+    return static_cast<double>(sum) / static_cast<double>(count);
+}
+
+/**
+ * @brief       Get a percentile.
+ */
+uint64_t HistogramSnapshot::percentile(double percentile) const
+{
+    if (count == 0) {
+        return 0;
+    }
+
+    // Rank of the value, 1-based.
+    double   clamped = ::std::clamp(percentile, 0.0, 100.0);
+    uint64_t rank    = static_cast<uint64_t>(
+        ::std::ceil(clamped / 100.0 * static_cast<double>(count)));
+    rank             = ::std::max<uint64_t>(rank, 1);
+
+    uint64_t seen = 0;
+    for (unsigned int i = 0; i < bucketCount; ++i) {
+        seen += buckets[i];
+        if (seen >= rank) {
+            uint64_t upper = i == 0    ? 0
+                             : i == 64 ? UINT64_MAX
+                                       : (static_cast<uint64_t>(1) << i) - 1;
+            return ::std::min(upper, max);
+        }
+    }
+
+    return max;
+}
+
+/**
+ * @brief       Merge another snapshot.
+ */
+HistogramSnapshot &
+    HistogramSnapshot::operator+=(const HistogramSnapshot &snapshot)
+{
+    count += snapshot.count;
+    sum += snapshot.sum;
+    max = ::std::max(max, snapshot.max);
+    for (unsigned int i = 0; i < bucketCount; ++i) {
+        buckets[i] += snapshot.buckets[i];
+    }
+
+    return *this;
+}
+
+/**
+ * @brief       Constructor.
+ */
+Histogram::Histogram() : m_buckets {}, m_sum(0), m_max(0) {}
+
+/**
+ * @brief       Take a snapshot.
+ */
+HistogramSnapshot Histogram::snapshot() const
+{
+    HistogramSnapshot ret = {};
+    for (unsigned int i = 0; i < HistogramSnapshot::bucketCount; ++i) {
+        ret.buckets[i] = m_buckets[i].load(::std::memory_order_relaxed);
+        ret.count += ret.buckets[i];
+    }
+    ret.sum = m_sum.load(::std::memory_order_relaxed);
+    ret.max = m_max.load(::std::memory_order_relaxed);
+
+    return ret;
+}
+
+} // namespace remotePortMapper
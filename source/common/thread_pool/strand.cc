@@ -0,0 +1,153 @@
+#include <common/logger/logger.h>
+
+#include <common/thread_pool/strand.h>
+
+namespace remotePortMapper {
+
+/**
+ * @brief       Node of queued task.
+ */
+struct Strand::Node {
+    Node *next; ///< Next node.
+    Task  task; ///< Task.
+};
+
+thread_local Strand *Strand::_currentStrand = nullptr;
+
+/**
+ * @brief       Constructor.
+ */
+Strand::Strand(::std::shared_ptr<ThreadPool> threadPool) :
+    m_threadPool(threadPool), m_incoming(nullptr), m_ready(nullptr),
+    m_pendingTasks(0)
+{
+    if (threadPool == nullptr) {
+        this->setInitializeResult(Result<void, Error>::makeError(
+            Error {ErrorCode::InvalidValue, "Thread pool is null."}));
+        return;
+    }
+
+    this->setInitializeResult(Result<void, Error>::makeOk());
+}
+
+/**
+ * @brief       Destructor.
+ */
+Strand::~Strand()
+{
+    // Tasks never run, only possible if the pool stopped before draining.
+    Node *lists[] = {m_ready, m_incoming.load(::std::memory_order_acquire)};
+    for (Node *node : lists) {
+        while (node != nullptr) {
+            Node *next = node->next;
+            delete node;
+            node = next;
+        }
+    }
+}
+
+/**
+ * @brief       Get thread pool.
+ */
+::std::shared_ptr<ThreadPool> Strand::threadPool() const
+{
+    return m_threadPool.lock();
+}
+
+/**
+ * @brief       Post a task.
+ */
+void Strand::post(Task task)
+{
+    Node *node = new Node {nullptr, ::std::move(task)};
+
+    // Push.
+    Node *head = m_incoming.load(::std::memory_order_relaxed);
+    do {
+        node->next = head;
+    } while (! m_incoming.compare_exchange_weak(head, node,
+                                                ::std::memory_order_release,
+                                                ::std::memory_order_relaxed));
+
+    // The producer who makes the strand non-empty schedules the drain.
+    if (m_pendingTasks.fetch_add(1, ::std::memory_order_acq_rel) == 0) {
+        this->schedule();
+    }
+}
+
+/**
+ * @brief       Check if current thread is running a task of the strand.
+ */
+bool Strand::runningInThisThread() const
+{
+    return _currentStrand == this;
+}
+
+/**
+ * @brief       Schedule a drain task on the pool.
+ */
+void Strand::schedule()
+{
+    auto threadPool = m_threadPool.lock();
+    if (threadPool == nullptr) {
+        log_warning("Thread pool of \"Strand\" at " << this
+                                                   << " has been destroyed.");
+        return;
+    }
+
+    threadPool->addTask([self = this->shared_from_this()]() -> void {
+        self->drain();
+    });
+}
+
+/**
+ * @brief       Run queued tasks.
+ */
+void Strand::drain()
+{
+    Strand *previous = _currentStrand;
+    _currentStrand   = this;
+    for (::std::size_t i = 0; i < _drainBatch; ++i) {
+        Node *node = this->takeNode();
+        node->task();
+        delete node;
+
+        if (m_pendingTasks.fetch_sub(1, ::std::memory_order_acq_rel) == 1) {
+            _currentStrand = previous;
+            return;
+        }
+    }
+    _currentStrand = previous;
+
+    // Give the worker to other tasks, the strand is still owned by this
+    // drain so nobody else schedules it.
+    this->schedule();
+}
+
+/**
+ * @brief       Take the next task to run.
+ */
+Strand::Node *Strand::takeNode()
+{
+    if (m_ready == nullptr) {
+        // Take all posted tasks and reverse them to FIFO order.
+        Node *node = m_incoming.exchange(nullptr, ::std::memory_order_acquire);
+        while (node != nullptr) {
+            Node *next = node->next;
+            node->next = m_ready;
+            m_ready    = node;
+            node       = next;
+        }
+
+        if (m_ready == nullptr) {
+            panic("Strand at " << this << " is corrupted.");
+        }
+    }
+
+    Node *ret = m_ready;
+    m_ready   = ret->next;
+
+    return ret;
+}
+
+} // namespace remotePortMapper
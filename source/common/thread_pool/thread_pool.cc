@@ -1,25 +1,150 @@
 #include <algorithm>
 
+#if defined(_MSC_VER)
+    #include <intrin.h>
+
+#endif
+
 #include <common/logger/logger.h>
 
 #include <common/thread_pool/thread_pool.h>
 
 namespace remotePortMapper {
 
+/**
+ * @brief       Hint the CPU that we are spinning.
+ */
+static inline void cpuRelax()
+{
+#if defined(__x86_64__) || defined(__i386__)
+    __builtin_ia32_pause();
+#elif defined(__aarch64__) || defined(__arm__)
+    asm volatile("yield" ::: "memory");
+#elif defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+    _mm_pause();
+#endif
+}
+
+/**
+ * @brief       Get default count of workers.
+ *
+ * @return      Count of workers.
+ */
+static ::std::size_t defaultWorkerCount()
+{
+    auto     allowed = CpuTopology::allowedCpus().size();
+    uint32_t quota   = CpuTopology::cpuQuota();
+    uint32_t cpus    = CpuTopology::availableCpuCount();
+    log_info("Default count of workers of \"ThreadPool\" is "
+             << cpus + 1 << ", " << allowed << " CPUs allowed, CPU quota: "
+             << (quota == 0 ? ::std::string("unlimited")
+                            : ::std::to_string(quota) + " CPUs")
+             << ".");
+
+    return cpus + 1;
+}
+
+thread_local ThreadPool::Worker *ThreadPool::_currentWorker   = nullptr;
+thread_local uint32_t            ThreadPool::_sampleCountdown = 0;
+
 /**
  * @brief       Constructor.
  */
-ThreadPool::ThreadPool(::std::size_t workers) : m_running(true)
+ThreadPool::ThreadPool(::std::size_t workers) :
+    ThreadPool(ThreadPoolOptions {.workers = workers})
+{}
+
+/**
+ * @brief       Constructor.
+ */
+ThreadPool::ThreadPool(ThreadPoolOptions options) :
+    m_scheduler(options.scheduler), m_idlePolicy(options.idlePolicy),
+    m_highPriorityBurst(options.highPriorityBurst),
+    m_lifoSlot(options.lifoSlot), m_lifoSlotBurst(options.lifoSlotBurst),
+    m_injectionQueueInterval(options.injectionQueueInterval),
+    m_cpus(::std::move(options.cpus)),
+    m_minWorkers(options.workers != 0 ? options.workers
+                                      : defaultWorkerCount()),
+    m_maxWorkers(::std::max(options.maxWorkers, m_minWorkers)),
+    m_workerIdleTimeout(options.workerIdleTimeout),
+    m_telemetrySampleInterval(options.telemetrySampleInterval),
+    m_taskQueueSizes {},
+    m_pendingTasks(0), m_idleWorkers(0), m_alarmInbox(nullptr),
+    m_alarmWakeup(::std::chrono::steady_clock::time_point::min()
+                      .time_since_epoch()
+                      .count()),
+    m_alarmSlack(::std::max(options.alarmSlack,
+                            ::std::chrono::steady_clock::duration::zero())),
+    m_clock(::std::move(options.clock)),
+    m_activeWorkers(0), m_busyWorkers(0),
+    m_spawnedWorkers(0), m_retiredWorkers(0), m_running(true)
 {
-    workers = ::std::max(workers, static_cast<::std::size_t>(1));
-    for (::std::size_t i = 0; i < workers; ++i) {
-        m_workers.push_back(::std::thread(&ThreadPool::workerThread, this));
+    // Alarm store.
+    switch (options.alarmStore) {
+        case ThreadPoolAlarmStore::SortedMap: {
+            m_alarmStore = ::std::make_unique<SortedAlarmStore>();
+        } break;
+        case ThreadPoolAlarmStore::TimingWheel: {
+            m_alarmStore = ::std::make_unique<TimingWheelAlarmStore>(
+                this->now(), options.alarmTick);
+        } break;
+        default: {
+            panic("Illegal alarm store!");
+        }
+    }
+    m_timerStore
+        = ::std::make_unique<TimerStore>(this->now(), options.alarmTick);
+
+    // Create all worker slots before starting any thread, thieves iterate
+    // over all of them.
+    for (::std::size_t i = 0; i < m_maxWorkers; ++i) {
+        auto worker        = ::std::make_unique<Worker>();
+        worker->threadPool = this;
+        worker->index      = i;
+        worker->cpu        = -1;
+        worker->active     = false;
+        worker->dequeSize  = 0;
+        worker->random     = static_cast<uint32_t>(i * 2654435761U + 1);
+        worker->highStreak = 0;
+        worker->lifoStreak = 0;
+        worker->lookups    = 0;
+        worker->idleTime   = 0;
+        if (! m_cpus.empty()) {
+            worker->cpu = static_cast<int64_t>(m_cpus[i % m_cpus.size()]);
+        }
+        m_workers.push_back(::std::move(worker));
+    }
+
+    {
+        ::std::unique_lock lock(m_workersLock);
+        for (::std::size_t i = 0; i < m_minWorkers; ++i) {
+            this->startWorker(m_workers[i].get());
+        }
     }
 
     m_alarmThread = ::std::thread(&ThreadPool::alarmThread, this);
+    if (m_clock != nullptr) {
+        m_clock->attach(this);
+    }
 
     this->setInitializeResult(Result<void, Error>::makeOk());
-    log_info("\"ThreadPool\" at " << this << " initialized.");
+    log_info("\"ThreadPool\" at " << this << " initialized with "
+                                  << m_minWorkers << " to " << m_maxWorkers
+                                  << " workers, scheduler: "
+                                  << (m_scheduler
+                                              == ThreadPoolScheduler::Global
+                                          ? "global"
+                                          : "work-stealing")
+                                  << ", alarm store: "
+                                  << (options.alarmStore
+                                              == ThreadPoolAlarmStore::SortedMap
+                                          ? "sorted map"
+                                          : "timing wheel")
+                                  << ", pinned: "
+                                  << (m_cpus.empty() ? "no" : "yes")
+                                  << ", clock: "
+                                  << (m_clock == nullptr ? "steady" : "virtual")
+                                  << ".");
 }
 
 /**
@@ -28,31 +153,329 @@ ThreadPool::ThreadPool(::std::size_t workers) : m_running(true)
 ThreadPool::~ThreadPool()
 {
     log_info("Destroying \"ThreadPool\" at " << this << ".");
+    if (m_clock != nullptr) {
+        m_clock->detach(this);
+    }
+
     // Change status.
-    m_running = false;
-    ::std::atomic_thread_fence(::std::memory_order_seq_cst);
+    {
+        ::std::unique_lock taskLock(m_taskQueueLock);
+        ::std::unique_lock alarmLock(m_alarmLock);
+        ::std::unique_lock workersLock(m_workersLock);
+        m_running = false;
+
+        // When destroyed on a worker, the task in its slot is left to other
+        // workers.
+        Worker *current = this->currentWorker();
+        if (current != nullptr && current->lifoTask.task) {
+            constexpr auto lane
+                = static_cast<::std::size_t>(ThreadPoolPriority::Normal);
+            m_taskQueues[lane].pushBack(::std::move(current->lifoTask));
+            m_taskQueueSizes[lane].store(m_taskQueues[lane].size(),
+                                         ::std::memory_order_relaxed);
+            m_pendingTasks.fetch_add(1);
+        }
+
+        // Periodic alarms never expire, they stop with the pool.
+        this->drainAlarmInbox();
+        for (auto &alarm : m_periodicAlarms) {
+            m_alarmStore->remove(alarm);
+            alarm->m_stored = false;
+        }
+        m_periodicAlarms.clear();
+    }
 
     // Awake all.
     m_alarmCond.notify_one();
     m_taskQueueCond.notify_all();
 
-    // Join.
+    // Join. When the last reference is dropped by a task, the pool is
+    // destroyed on one of its workers, which is detached and returns as soon
+    // as the task finishes.
+    Worker *current = this->currentWorker();
     m_alarmThread.join();
     for (auto &worker : m_workers) {
-        worker.join();
+        if (worker.get() == current) {
+            worker->thread.detach();
+            _currentWorker = nullptr;
+        } else if (worker->thread.joinable()) {
+            worker->thread.join();
+        }
     }
 
     log_info("\"ThreadPool\" at " << this << " destroyed.");
 }
 
+/**
+ * @brief       Create a pool on each NUMA node.
+ */
+Result<::std::vector<::std::shared_ptr<ThreadPool>>, Error>
+    ThreadPool::createPerNumaNode(ThreadPoolOptions options)
+{
+    ::std::vector<::std::shared_ptr<ThreadPool>> ret;
+    for (auto &node : CpuTopology::numaNodes()) {
+        options.workers = node.cpus.size();
+        options.cpus    = node.cpus;
+        auto result     = ThreadPool::create(options);
+        if (! result) {
+            return Result<::std::vector<::std::shared_ptr<ThreadPool>>,
+                          Error>::makeError(result.value<Error>());
+        }
+        ret.push_back(result.value<::std::shared_ptr<ThreadPool>>());
+        log_info("\"ThreadPool\" at " << ret.back().get()
+                                      << " runs on NUMA node " << node.id
+                                      << ".");
+    }
+
+    return Result<::std::vector<::std::shared_ptr<ThreadPool>>,
+                  Error>::makeOk(::std::move(ret));
+}
+
+/**
+ * @brief       Get CPU map of workers.
+ */
+const ::std::vector<uint32_t> &ThreadPool::cpus() const
+{
+    return m_cpus;
+}
+
+/**
+ * @brief       Get count of workers.
+ */
+::std::size_t ThreadPool::workerCount() const
+{
+    return m_activeWorkers.load(::std::memory_order_relaxed);
+}
+
+/**
+ * @brief       Get worker metrics.
+ */
+ThreadPoolWorkerMetrics ThreadPool::workerMetrics() const
+{
+    return ThreadPoolWorkerMetrics {
+        .workers        = m_activeWorkers.load(::std::memory_order_relaxed),
+        .busyWorkers    = m_busyWorkers.load(::std::memory_order_relaxed),
+        .idleWorkers    = m_idleWorkers.load(::std::memory_order_relaxed),
+        .minWorkers     = m_minWorkers,
+        .maxWorkers     = m_maxWorkers,
+        .spawnedWorkers = m_spawnedWorkers.load(::std::memory_order_relaxed),
+        .retiredWorkers = m_retiredWorkers.load(::std::memory_order_relaxed)};
+}
+
+/**
+ * @brief       Get telemetry.
+ */
+ThreadPoolTelemetry ThreadPool::telemetry() const
+{
+    ThreadPoolTelemetry ret = {};
+    ret.alarmLateness       = m_alarmLateness.snapshot();
+    if (m_telemetrySampleInterval == 0) {
+        return ret;
+    }
+
+    // Histograms of retired workers stay in their slots.
+    auto now = ::std::chrono::steady_clock::now();
+    for (auto &worker : m_workers) {
+        ret.queueDepth += worker->queueDepth.snapshot();
+        ret.waitTime += worker->waitTime.snapshot();
+        ret.runTime += worker->runTime.snapshot();
+        if (! worker->active.load(::std::memory_order_relaxed)) {
+            continue;
+        }
+
+        uint64_t lifetime = ThreadPool::nanoseconds(
+            now - worker->startTime.load(::std::memory_order_relaxed));
+        uint64_t idle = worker->idleTime.load(::std::memory_order_relaxed);
+        auto idleSince = worker->idleSince.load(::std::memory_order_relaxed);
+        if (idleSince != ::std::chrono::steady_clock::time_point()) {
+            idle += ThreadPool::nanoseconds(now - idleSince);
+        }
+        idle          = ::std::min(idle, lifetime);
+        uint64_t busy = lifetime - idle;
+        ret.workers.push_back(ThreadPoolWorkerTelemetry {
+            .index     = worker->index,
+            .busyTime  = ::std::chrono::nanoseconds(busy),
+            .idleTime  = ::std::chrono::nanoseconds(idle),
+            .busyRatio = lifetime == 0 ? 0.0
+                                       : static_cast<double>(busy)
+                                             / static_cast<double>(lifetime)});
+    }
+
+    return ret;
+}
+
+/**
+ * @brief       Get scheduler.
+ */
+ThreadPoolScheduler ThreadPool::scheduler() const
+{
+    return m_scheduler;
+}
+
+/**
+ * @brief       Get count of queued tasks of a priority.
+ */
+::std::size_t ThreadPool::queueDepth(ThreadPoolPriority priority) const
+{
+    ::std::size_t depth = m_taskQueueSizes[static_cast<::std::size_t>(priority)]
+                              .load(::std::memory_order_relaxed);
+    if (priority == ThreadPoolPriority::Normal) {
+        for (auto &worker : m_workers) {
+            depth += worker->dequeSize.load(::std::memory_order_relaxed);
+        }
+    }
+
+    return depth;
+}
+
 /**
  * @brief       Add task.
  */
-void ThreadPool::addTask(Task task)
+void ThreadPool::addTask(Task task, ThreadPoolPriority priority)
 {
-    ::std::unique_lock lock(m_taskQueueLock);
-    m_taskQueue.push(::std::move(task));
-    m_taskQueueCond.notify_one();
+    QueuedTask queued = {::std::move(task), this->enqueueTime()};
+    Worker    *worker = this->currentWorker();
+
+    // Next task of the worker, the task displaced from the slot is queued.
+    if (m_lifoSlot && worker != nullptr
+        && priority == ThreadPoolPriority::Normal
+        && (m_lifoSlotBurst == 0 || worker->lifoStreak < m_lifoSlotBurst)) {
+        ::std::swap(queued, worker->lifoTask);
+        if (! queued.task) {
+            return;
+        }
+    }
+
+    if (m_scheduler == ThreadPoolScheduler::WorkStealing && worker != nullptr
+        && priority == ThreadPoolPriority::Normal) {
+        // Push to local deque.
+        {
+            ::std::unique_lock lock(worker->dequeLock);
+            worker->deque.pushBack(::std::move(queued));
+            worker->dequeSize.store(worker->deque.size(),
+                                    ::std::memory_order_relaxed);
+        }
+        m_pendingTasks.fetch_add(1);
+        this->wakeWorkers(1);
+
+    } else {
+        // Push to shared task queue.
+        auto               lane = static_cast<::std::size_t>(priority);
+        ::std::unique_lock lock(m_taskQueueLock);
+        m_taskQueues[lane].pushBack(::std::move(queued));
+        m_taskQueueSizes[lane].store(m_taskQueues[lane].size(),
+                                     ::std::memory_order_relaxed);
+        m_pendingTasks.fetch_add(1);
+        this->wakeWorkersLocked(1);
+    }
+
+    this->growWorkers();
+}
+
+/**
+ * @brief       Add tasks in one batch.
+ */
+void ThreadPool::addTasks(::std::span<Task> tasks)
+{
+    this->addTasks(tasks.begin(), tasks.end());
+}
+
+/**
+ * @brief       Run a type-erased parallel loop and wait.
+ */
+void ThreadPool::runParallelFor(
+    ::std::size_t                                    begin,
+    ::std::size_t                                    end,
+    ::std::size_t                                    grain,
+    FunctionRef<void(::std::size_t, ::std::size_t)> function)
+{
+    if (begin >= end) {
+        return;
+    }
+
+    // Split.
+    ::std::size_t size    = end - begin;
+    ::std::size_t workers = ::std::max<::std::size_t>(this->workerCount(), 1);
+    if (grain == 0) {
+        grain = ::std::max<::std::size_t>(size / (workers * 4), 1);
+    }
+    ::std::size_t chunks = (size - 1) / grain + 1;
+    if (chunks == 1) {
+        function(begin, end);
+        return;
+    }
+
+    // Counters start at zero.
+    auto state = ::std::make_shared<ParallelForState>(function, begin, end,
+                                                      grain, chunks);
+
+    // Fork, the caller runs chunks too, so one helper less is needed.
+    ::std::size_t      helpers = ::std::min(chunks - 1, workers);
+    ::std::vector<Task> tasks;
+    tasks.reserve(helpers);
+    for (::std::size_t i = 0; i < helpers; ++i) {
+        tasks.emplace_back([state]() -> void {
+            ThreadPool::runChunks(*state);
+        });
+    }
+    this->addTasks(tasks.begin(), tasks.end());
+    ThreadPool::runChunks(*state);
+
+    // Join. Chunks left are running on other threads, a worker runs other
+    // tasks meanwhile, its slot first since nobody else takes it. Only the
+    // last chunk notifies. Once a task destroyed the pool, the destructor has
+    // joined the other workers and only the state may be touched.
+    Worker *worker = this->currentWorker();
+    while (true) {
+        ::std::size_t finished = state->finishedChunks.load();
+        if (finished == chunks) {
+            break;
+        }
+
+        if (worker != nullptr) {
+            WorkerRun run = this->runWorkerTask(worker, true);
+            if (run == WorkerRun::Detached) {
+                worker = nullptr;
+                continue;
+            } else if (run == WorkerRun::Ran || worker->lifoTask.task) {
+                // The slot waits for high priority tasks taken by others.
+                continue;
+            }
+        }
+        state->finishedChunks.wait(finished);
+    }
+}
+
+/**
+ * @brief       Claim and run chunks of a parallel loop until none is left.
+ */
+void ThreadPool::runChunks(ParallelForState &state)
+{
+    while (true) {
+        ::std::size_t chunk = state.nextChunk.fetch_add(1);
+        if (chunk >= state.chunks) {
+            return;
+        }
+
+        ::std::size_t first = state.begin + chunk * state.grain;
+        ::std::size_t last  = ::std::min(first + state.grain, state.end);
+        state.function(first, last);
+        if (state.finishedChunks.fetch_add(1) + 1 == state.chunks) {
+            state.finishedChunks.notify_all();
+        }
+    }
+}
+
+/**
+ * @brief       Get current time of alarms and pooled timers.
+ */
+::std::chrono::steady_clock::time_point ThreadPool::now() const
+{
+    if (m_clock != nullptr) {
+        return m_clock->now();
+    } else {
+        return ::std::chrono::steady_clock::now();
+    }
 }
 
 /**
@@ -62,39 +485,219 @@ void ThreadPool::addTask(Task task)
     ThreadPool::addAlarm(::std::chrono::steady_clock::time_point timepoint,
                          Task                                    task)
 {
-    ::std::unique_lock lock(m_alarmLock);
-    auto               iter = m_alarmMap.find(timepoint);
-    if (iter == m_alarmMap.end()) {
-        // Create a new set.
-        auto result = m_alarmMap.emplace(::std::make_pair(
-            ::std::chrono::steady_clock::time_point(timepoint),
-            ::std::set<::std::shared_ptr<ThreadPool::AsyncAlarm>>()));
-        iter        = result.first;
+    auto result = AsyncAlarm::create(
+        timepoint, ::std::chrono::steady_clock::duration::zero(),
+        ::std::move(task), this->shared_from_this());
+    auto alarm = result.value<::std::shared_ptr<AsyncAlarm>>();
+
+    this->postAlarm(alarm, timepoint);
+
+    return alarm;
+}
+
+/**
+ * @brief       Add periodic alarm.
+ */
+::std::shared_ptr<ThreadPool::AsyncAlarm>
+    ThreadPool::addPeriodicAlarm(
+        ::std::chrono::steady_clock::time_point timepoint,
+        ::std::chrono::steady_clock::duration   period,
+        Task                                    task)
+{
+    if (period <= ::std::chrono::steady_clock::duration::zero()) {
+        panic("Period of alarm must be positive.");
     }
 
-    // Add alarm.
-    auto result = AsyncAlarm::create(timepoint, ::std::move(task),
+    auto result = AsyncAlarm::create(timepoint, period, ::std::move(task),
                                      this->shared_from_this());
     auto alarm  = result.value<::std::shared_ptr<AsyncAlarm>>();
-    iter->second.insert(alarm);
-    m_alarmCond.notify_one();
+
+    this->postAlarm(alarm, timepoint);
 
     return alarm;
 }
 
+/**
+ * @brief       Add pooled timer.
+ */
+ThreadPool::TimerHandle
+    ThreadPool::addTimer(::std::chrono::steady_clock::time_point timepoint,
+                         Task                                    task)
+{
+    ::std::unique_lock lock(m_alarmLock);
+    this->notifyAlarmThread(timepoint);
+
+    return m_timerStore->insert(timepoint, ::std::move(task));
+}
+
+/**
+ * @brief       Cancel pooled timer.
+ */
+bool ThreadPool::cancelTimer(TimerHandle handle)
+{
+    Task task;
+    {
+        ::std::unique_lock lock(m_alarmLock);
+        if (! m_timerStore->remove(handle, task)) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+/**
+ * @brief       Get the timepoint the alarm thread needs to wake up.
+ */
+bool ThreadPool::nextAlarmTimepoint(
+    ::std::chrono::steady_clock::time_point &timepoint) const
+{
+    if (m_alarmStore->empty()) {
+        if (m_timerStore->empty()) {
+            return false;
+        }
+        timepoint = m_timerStore->nextTimepoint();
+    } else if (m_timerStore->empty()) {
+        timepoint = m_alarmStore->nextTimepoint();
+    } else {
+        timepoint = ::std::min(m_alarmStore->nextTimepoint(),
+                               m_timerStore->nextTimepoint());
+    }
+
+    return true;
+}
+
+/**
+ * @brief       Wake the alarm thread if a new deadline is the earliest.
+ */
+void ThreadPool::notifyAlarmThread(
+    ::std::chrono::steady_clock::time_point deadline)
+{
+    // Only an earlier deadline changes how long the alarm thread sleeps.
+    ::std::chrono::steady_clock::time_point timepoint;
+    if (! this->nextAlarmTimepoint(timepoint) || deadline < timepoint) {
+        m_alarmCond.notify_one();
+    }
+}
+
+/**
+ * @brief       Wake the alarm thread to check the time again.
+ */
+void ThreadPool::wakeAlarmThread()
+{
+    ::std::unique_lock lock(m_alarmLock);
+    m_alarmCond.notify_one();
+}
+
+/**
+ * @brief       Post an alarm scheduled or canceled to the alarm thread.
+ */
+void ThreadPool::postAlarm(const ::std::shared_ptr<AsyncAlarm>    &alarm,
+                           ::std::chrono::steady_clock::time_point deadline)
+{
+    // An alarm is posted at most once at a time, the alarm thread acts on
+    // its status when it takes it.
+    if (! alarm->m_posted.exchange(true)) {
+        alarm->m_inboxRef = alarm;
+        AsyncAlarm *head  = m_alarmInbox.load(::std::memory_order_relaxed);
+        do {
+            alarm->m_inboxNext = head;
+        } while (! m_alarmInbox.compare_exchange_weak(head, alarm.get()));
+    }
+
+    // Only an earlier deadline changes how long the sleeping alarm thread
+    // sleeps, even if the alarm is already in the inbox with a later one.
+    // It publishes the wakeup before checking the inbox, so either it sees
+    // this alarm or this sees its wakeup.
+    if (deadline.time_since_epoch().count() < m_alarmWakeup.load()) {
+        ::std::unique_lock lock(m_alarmLock);
+        m_alarmCond.notify_one();
+    }
+}
+
+/**
+ * @brief       Apply alarms posted to the inbox to the store.
+ */
+void ThreadPool::drainAlarmInbox()
+{
+    AsyncAlarm *node = m_alarmInbox.exchange(nullptr);
+    while (node != nullptr) {
+        AsyncAlarm *next  = node->m_inboxNext;
+        auto        alarm = ::std::move(node->m_inboxRef);
+        node->m_posted    = false;
+
+        // Periodic alarms stop with the pool.
+        bool periodic
+            = alarm->m_period > ::std::chrono::steady_clock::duration::zero();
+        switch (alarm->m_status.load()) {
+            case AsyncAlarm::Status::Ready: {
+                // A one-shot alarm moves to the deadline requested last.
+                if (! periodic) {
+                    auto next = alarm->m_nextDeadline.load();
+                    if (next == AsyncAlarm::_fired) {
+                        break;
+                    }
+                    ::std::chrono::steady_clock::time_point deadline(
+                        ::std::chrono::steady_clock::duration {next});
+                    if (alarm->m_stored && deadline != alarm->m_deadline) {
+                        m_alarmStore->remove(alarm);
+                        alarm->m_stored = false;
+                    }
+                    alarm->m_deadline = deadline;
+                }
+                if (! alarm->m_stored && (m_running || ! periodic)) {
+                    if (periodic) {
+                        m_periodicAlarms.insert(alarm);
+                    }
+                    m_alarmStore->insert(alarm);
+                    alarm->m_stored = true;
+                }
+            } break;
+            case AsyncAlarm::Status::Canceled: {
+                if (alarm->m_stored) {
+                    m_alarmStore->remove(alarm);
+                    alarm->m_stored = false;
+                }
+                if (periodic) {
+                    m_periodicAlarms.erase(alarm);
+                }
+            } break;
+            default: {
+            }
+        }
+        node = next;
+    }
+}
+
 /**
  * @brief       Remove alarm.
  */
 void ThreadPool::removeAlarm(::std::shared_ptr<AsyncAlarm> &alarm)
 {
-    ::std::unique_lock lock(m_alarmLock);
-    auto               iter = m_alarmMap.find(alarm->timepoint());
-    if (iter == m_alarmMap.end()) {
+    this->postAlarm(alarm, ::std::chrono::steady_clock::time_point::max());
+}
+
+/**
+ * @brief       Insert a periodic alarm again for its next period.
+ */
+void ThreadPool::rearmAlarm(::std::shared_ptr<AsyncAlarm> &alarm)
+{
+    // A concurrent cancel posts the alarm too, the alarm thread sees it
+    // canceled and never inserts it.
+    if (! m_running || alarm->m_status != AsyncAlarm::Status::Ready) {
         return;
     }
 
-    iter->second.erase(alarm);
-    m_alarmCond.notify_one();
+    // The next deadline follows the previous one instead of the actual run,
+    // so lateness never accumulates.
+    auto now = this->now();
+    alarm->m_deadline += alarm->m_period;
+    if (alarm->m_deadline <= now) {
+        alarm->m_deadline
+            += alarm->m_period
+               * ((now - alarm->m_deadline) / alarm->m_period + 1);
+    }
+    this->postAlarm(alarm, alarm->m_deadline);
 }
 
 /**
@@ -102,68 +705,516 @@ void ThreadPool::removeAlarm(::std::shared_ptr<AsyncAlarm> &alarm)
  */
 void ThreadPool::alarmThread()
 {
+    ::std::vector<::std::shared_ptr<AsyncAlarm>> alarms;
+    ::std::vector<Task>                          timerTasks;
     while (true) {
         ::std::unique_lock lock(m_alarmLock);
+        this->drainAlarmInbox();
 
         // Check empty.
-        if (m_alarmMap.empty()) {
+        ::std::chrono::steady_clock::time_point timepoint;
+        if (! this->nextAlarmTimepoint(timepoint)) {
             if (m_running) {
                 // Wait.
-                m_alarmCond.wait(lock);
+                m_alarmWakeup = ::std::chrono::steady_clock::time_point::max()
+                                    .time_since_epoch()
+                                    .count();
+                if (m_alarmInbox.load() == nullptr) {
+                    m_alarmCond.wait(lock);
+                }
+                m_alarmWakeup = ::std::chrono::steady_clock::time_point::min()
+                                    .time_since_epoch()
+                                    .count();
                 continue;
             } else {
                 break;
             }
         }
 
-        // Check time.
-        auto currentTime = ::std::chrono::steady_clock::now();
-        auto iter        = m_alarmMap.begin();
-        if (currentTime >= iter->first) {
-            // Alarm.
-            auto alarms = ::std::move(iter->second);
-            m_alarmMap.erase(iter->first);
+        // Check time. The earliest alarm may wait for the slack, all alarms
+        // due by then fire in this wakeup.
+        auto currentTime = this->now();
+        timepoint += m_alarmSlack;
+        if (currentTime >= timepoint) {
+            // Alarm. Tasks of timers are queued as they are, the buffers
+            // keep their capacity so firing allocates nothing.
+            m_alarmStore->takeExpired(currentTime, alarms);
+            ::std::size_t fired = 0;
+            for (auto &alarm : alarms) {
+                alarm->m_stored = false;
+                if (alarm->takeLaterDeadline(currentTime)) {
+                    m_alarmStore->insert(alarm);
+                    alarm->m_stored = true;
+                } else if (&alarm != &alarms[fired]) {
+                    alarms[fired++] = ::std::move(alarm);
+                } else {
+                    ++fired;
+                }
+            }
+            alarms.resize(fired);
+            m_timerStore->takeExpired(
+                currentTime, timerTasks,
+                m_telemetrySampleInterval != 0 ? &m_alarmLateness : nullptr);
             lock.unlock();
             for (auto &alarm : alarms) {
-                this->addTask(AlarmTask(alarm));
+                this->addTask(AlarmTask(::std::move(alarm)),
+                              ThreadPoolPriority::High);
+            }
+            for (auto &task : timerTasks) {
+                this->addTask(::std::move(task), ThreadPoolPriority::High);
             }
+            alarms.clear();
+            timerTasks.clear();
             continue;
 
         } else {
             // Wait.
-            m_alarmCond.wait_until(lock, iter->first);
+            m_alarmWakeup = timepoint.time_since_epoch().count();
+            // A virtual clock wakes the thread when it is advanced.
+            if (m_alarmInbox.load() == nullptr) {
+                if (m_clock != nullptr) {
+                    m_alarmCond.wait(lock);
+                } else {
+                    m_alarmCond.wait_until(lock, timepoint);
+                }
+            }
+            m_alarmWakeup = ::std::chrono::steady_clock::time_point::min()
+                                .time_since_epoch()
+                                .count();
             continue;
         }
     }
 }
 
 /**
- * @brief   Worker thread function.
+ * @brief       Start a worker in a slot.
+ */
+void ThreadPool::startWorker(Worker *worker)
+{
+    // The thread of a retired worker may still be returning.
+    if (worker->thread.joinable()) {
+        worker->thread.join();
+    }
+
+    worker->active = true;
+    m_activeWorkers.fetch_add(1);
+    worker->thread = ::std::thread(&ThreadPool::workerThread, this, worker);
+}
+
+/**
+ * @brief       Spawn a worker if the pool is elastic, all workers are busy and
+ *              tasks are queued.
+ */
+void ThreadPool::growWorkers()
+{
+    if (m_maxWorkers <= m_minWorkers || m_pendingTasks.load() == 0) {
+        return;
+    }
+    ::std::size_t active = m_activeWorkers.load();
+    if (active >= m_maxWorkers || m_busyWorkers.load() < active) {
+        return;
+    }
+
+    ::std::unique_lock lock(m_workersLock);
+    if (! m_running || m_activeWorkers.load() >= m_maxWorkers) {
+        return;
+    }
+
+    // A retiring worker leaves the count before its slot, try later if no
+    // slot is free yet.
+    for (auto &worker : m_workers) {
+        if (! worker->active.load()) {
+            this->startWorker(worker.get());
+            m_spawnedWorkers.fetch_add(1, ::std::memory_order_relaxed);
+            log_debug("\"ThreadPool\" at " << this << " spawned worker "
+                                           << worker->index << ".");
+            return;
+        }
+    }
+}
+
+/**
+ * @brief       Retire current worker if the pool has more workers than the
+ *              minimum.
  */
-void ThreadPool::workerThread()
+bool ThreadPool::retireWorker()
 {
+    ::std::size_t active = m_activeWorkers.load();
+    while (active > m_minWorkers) {
+        if (m_activeWorkers.compare_exchange_weak(active, active - 1)) {
+            m_retiredWorkers.fetch_add(1, ::std::memory_order_relaxed);
+            return true;
+        }
+    }
+
+    return false;
+}
+
+/**
+ * @brief       Worker thread function.
+ */
+void ThreadPool::workerThread(Worker *worker)
+{
+    _currentWorker = worker;
+
+    // Pin before touching per-worker memory, so the pages are allocated on
+    // the local NUMA node.
+    if (worker->cpu >= 0) {
+        auto result
+            = CpuTopology::pinCurrentThread(static_cast<uint32_t>(worker->cpu));
+        if (! result) {
+            log_warning("Worker " << worker->index << " of \"ThreadPool\" at "
+                                  << this << ": "
+                                  << result.value<Error>().message);
+        }
+    }
+    {
+        ::std::unique_lock lock(worker->dequeLock);
+        worker->deque.reserve(_localDequeCapacity);
+    }
+
+    // Busy and idle time only need the clock when the worker goes idle or
+    // back to work, not for each task.
+    bool telemetry = m_telemetrySampleInterval != 0;
+    if (telemetry) {
+        worker->startTime.store(::std::chrono::steady_clock::now(),
+                                ::std::memory_order_relaxed);
+        worker->idleSince.store(::std::chrono::steady_clock::time_point(),
+                                ::std::memory_order_relaxed);
+        worker->idleTime.store(0, ::std::memory_order_relaxed);
+    }
+
     while (true) {
+        WorkerRun run = this->runWorkerTask(worker, false);
+        if (run == WorkerRun::Detached) {
+            return;
+        } else if (run == WorkerRun::Ran) {
+            continue;
+        }
+
+        // The high priority task which preempted the slot was taken by
+        // another worker.
+        if (worker->lifoTask.task) {
+            continue;
+        }
+
+        if (telemetry
+            && worker->idleSince.load(::std::memory_order_relaxed)
+                   == ::std::chrono::steady_clock::time_point()) {
+            worker->idleSince.store(::std::chrono::steady_clock::now(),
+                                    ::std::memory_order_relaxed);
+        }
+        if (this->spinWorker()) {
+            continue;
+        }
+
+        if (! this->parkWorker()) {
+            break;
+        }
+    }
+    _currentWorker = nullptr;
+    worker->active = false;
+}
+
+/**
+ * @brief       Take a task from the slot or the queues of a worker and run it.
+ */
+ThreadPool::WorkerRun ThreadPool::runWorkerTask(Worker *worker, bool nested)
+{
+    QueuedTask task;
+    bool       lifo = this->takeLifoTask(worker, task);
+    if (! lifo && ! this->findTask(worker, task)) {
+        return WorkerRun::Idle;
+    }
+
+    // Tasks in slots are not pending, no other worker can take them.
+    ::std::size_t depth;
+    if (lifo) {
+        depth = m_pendingTasks.load(::std::memory_order_relaxed);
+    } else {
+        depth              = m_pendingTasks.fetch_sub(1);
+        worker->lifoStreak = 0;
+    }
+
+    // Run, only elastic pools need to know if all workers are busy. Tasks
+    // still queued when the last idle worker gets busy need a new worker. A
+    // nested task runs while the worker is already counted busy.
+    bool elastic = ! nested && m_maxWorkers > m_minWorkers;
+    if (elastic) {
+        m_busyWorkers.fetch_add(1);
+        this->growWorkers();
+    }
+    if (m_telemetrySampleInterval != 0) {
+        this->finishIdle(worker);
+    }
+    bool sampled
+        = task.enqueueTime != ::std::chrono::steady_clock::time_point();
+    ::std::chrono::steady_clock::time_point start;
+    if (sampled) {
+        start = ::std::chrono::steady_clock::now();
+        worker->queueDepth.record(depth);
+        worker->waitTime.record(
+            ThreadPool::nanoseconds(start - task.enqueueTime));
+    }
+    task.task();
+    task.task = Task();
+
+    // The task dropped the last reference to the pool, nothing of it may be
+    // touched.
+    if (_currentWorker != worker) {
+        return WorkerRun::Detached;
+    }
+    if (sampled) {
+        worker->runTime.record(ThreadPool::nanoseconds(
+            ::std::chrono::steady_clock::now() - start));
+    }
+    if (elastic) {
+        m_busyWorkers.fetch_sub(1);
+    }
+    return WorkerRun::Ran;
+}
+
+/**
+ * @brief       Add the idle period of a worker which got a task.
+ */
+void ThreadPool::finishIdle(Worker *worker)
+{
+    auto idleSince = worker->idleSince.load(::std::memory_order_relaxed);
+    if (idleSince == ::std::chrono::steady_clock::time_point()) {
+        return;
+    }
+
+    worker->idleTime.store(
+        worker->idleTime.load(::std::memory_order_relaxed)
+            + ThreadPool::nanoseconds(::std::chrono::steady_clock::now()
+                                      - idleSince),
+        ::std::memory_order_relaxed);
+    worker->idleSince.store(::std::chrono::steady_clock::time_point(),
+                            ::std::memory_order_relaxed);
+}
+
+/**
+ * @brief       Get the worker of current thread if it belongs to this pool.
+ */
+ThreadPool::Worker *ThreadPool::currentWorker() const
+{
+    Worker *worker = _currentWorker;
+    if (worker != nullptr && worker->threadPool == this) {
+        return worker;
+    } else {
+        return nullptr;
+    }
+}
+
+/**
+ * @brief       Take the task in the slot of a worker.
+ */
+bool ThreadPool::takeLifoTask(Worker *worker, QueuedTask &task)
+{
+    constexpr auto high = static_cast<::std::size_t>(ThreadPoolPriority::High);
+    if (! worker->lifoTask.task
+        || m_taskQueueSizes[high].load(::std::memory_order_relaxed) > 0) {
+        return false;
+    }
+
+    task = ::std::move(worker->lifoTask);
+    ++worker->lifoStreak;
+    return true;
+}
+
+/**
+ * @brief       Find a task to run.
+ */
+bool ThreadPool::findTask(Worker *worker, QueuedTask &task)
+{
+    // High priority first, unless the worker has run too many of them in a
+    // row, then normal priority tasks get their turn.
+    bool starving = m_highPriorityBurst > 0
+                    && worker->highStreak >= m_highPriorityBurst;
+    if (! starving && this->takeSharedTask(ThreadPoolPriority::High, task)) {
+        ++worker->highStreak;
+        return true;
+    }
+
+    if (this->findNormalTask(worker, task)) {
+        worker->highStreak = 0;
+        return true;
+    }
+
+    if (starving && this->takeSharedTask(ThreadPoolPriority::High, task)) {
+        return true;
+    }
+
+    return false;
+}
+
+/**
+ * @brief       Find a normal priority task to run.
+ */
+bool ThreadPool::findNormalTask(Worker *worker, QueuedTask &task)
+{
+    if (m_scheduler == ThreadPoolScheduler::Global) {
+        return this->takeSharedTask(ThreadPoolPriority::Normal, task);
+    }
+
+    // Injection queue first once in a while.
+    if (m_injectionQueueInterval > 0
+        && ++worker->lookups % m_injectionQueueInterval == 0
+        && this->takeSharedTask(ThreadPoolPriority::Normal, task)) {
+        return true;
+    }
+
+    // Local deque, newest first for a warm cache.
+    if (worker->dequeSize.load(::std::memory_order_relaxed) > 0) {
+        ::std::unique_lock lock(worker->dequeLock);
+        if (! worker->deque.empty()) {
+            task = worker->deque.popBack();
+            worker->dequeSize.store(worker->deque.size(),
+                                    ::std::memory_order_relaxed);
+            return true;
+        }
+    }
+
+    // Injection queue, then other workers.
+    return this->takeSharedTask(ThreadPoolPriority::Normal, task)
+           || this->stealTask(worker, task);
+}
+
+/**
+ * @brief       Take a task from a shared task queue.
+ */
+bool ThreadPool::takeSharedTask(ThreadPoolPriority priority, QueuedTask &task)
+{
+    auto lane = static_cast<::std::size_t>(priority);
+    if (m_taskQueueSizes[lane].load(::std::memory_order_relaxed) == 0) {
+        return false;
+    }
+
+    ::std::unique_lock lock(m_taskQueueLock);
+    if (m_taskQueues[lane].empty()) {
+        return false;
+    }
+
+    task = m_taskQueues[lane].popFront();
+    m_taskQueueSizes[lane].store(m_taskQueues[lane].size(),
+                                 ::std::memory_order_relaxed);
+    return true;
+}
+
+/**
+ * @brief       Steal a task from other workers.
+ */
+bool ThreadPool::stealTask(Worker *thief, QueuedTask &task)
+{
+    ::std::size_t count = m_workers.size();
+    if (count < 2) {
+        return false;
+    }
+
+    // Start from a random victim so thieves spread out.
+    thief->random ^= thief->random << 13;
+    thief->random ^= thief->random >> 17;
+    thief->random ^= thief->random << 5;
+    ::std::size_t start = thief->random % count;
+
+    for (::std::size_t i = 0; i < count; ++i) {
+        Worker *victim = m_workers[(start + i) % count].get();
+        if (victim == thief
+            || victim->dequeSize.load(::std::memory_order_relaxed) == 0) {
+            continue;
+        }
+
+        ::std::unique_lock lock(victim->dequeLock);
+        if (! victim->deque.empty()) {
+            task = victim->deque.popFront();
+            victim->dequeSize.store(victim->deque.size(),
+                                    ::std::memory_order_relaxed);
+            return true;
+        }
+    }
+
+    return false;
+}
+
+/**
+ * @brief       Wake parked workers.
+ */
+void ThreadPool::wakeWorkers(::std::size_t count)
+{
+    // Pairs with the sequence in parkWorker(), either the parked worker sees
+    // the pending task or we see the parked worker.
+    if (m_idleWorkers.load() > 0) {
         ::std::unique_lock lock(m_taskQueueLock);
+        this->wakeWorkersLocked(count);
+    }
+}
 
-        // Check empty.
-        if (m_taskQueue.empty()) {
-            if (m_running) {
-                // Wait.
-                m_taskQueueCond.wait(lock);
-                continue;
-            } else {
-                break;
-            }
+/**
+ * @brief       Wake parked workers with \c m_taskQueueLock held.
+ */
+void ThreadPool::wakeWorkersLocked(::std::size_t count)
+{
+    ::std::size_t idle = m_idleWorkers.load();
+    if (idle == 0 || count == 0) {
+        return;
+    } else if (count >= idle) {
+        m_taskQueueCond.notify_all();
+    } else {
+        for (::std::size_t i = 0; i < count; ++i) {
+            m_taskQueueCond.notify_one();
+        }
+    }
+}
+
+/**
+ * @brief       Spin and yield as the idle policy says until there are tasks
+ *              to run.
+ */
+bool ThreadPool::spinWorker()
+{
+    for (uint32_t i = 0; i < m_idlePolicy.spins; ++i) {
+        if (m_pendingTasks.load(::std::memory_order_relaxed) > 0) {
+            return true;
         }
+        cpuRelax();
+    }
+
+    for (uint32_t i = 0; i < m_idlePolicy.yields; ++i) {
+        if (m_pendingTasks.load(::std::memory_order_relaxed) > 0) {
+            return true;
+        }
+        ::std::this_thread::yield();
+    }
+
+    return false;
+}
 
-        // Take task.
-        Task task = ::std::move(m_taskQueue.front());
-        m_taskQueue.pop();
+/**
+ * @brief       Park current worker until there are tasks to run.
+ */
+bool ThreadPool::parkWorker()
+{
+    ::std::unique_lock lock(m_taskQueueLock);
+    m_idleWorkers.fetch_add(1);
+    while (m_pendingTasks.load() == 0) {
+        if (! m_running) {
+            m_idleWorkers.fetch_sub(1);
+            return false;
+        }
 
-        // Run.
-        lock.unlock();
-        task();
+        // Wait.
+        if (m_maxWorkers <= m_minWorkers) {
+            m_taskQueueCond.wait(lock);
+        } else if (m_taskQueueCond.wait_for(lock, m_workerIdleTimeout)
+                       == ::std::cv_status::timeout
+                   && m_pendingTasks.load() == 0 && this->retireWorker()) {
+            m_idleWorkers.fetch_sub(1);
+            return false;
+        }
     }
+    m_idleWorkers.fetch_sub(1);
+
+    return true;
 }
 
 /**
@@ -171,10 +1222,15 @@ void ThreadPool::workerThread()
  */
 ThreadPool::AsyncAlarm::AsyncAlarm(
     ::std::chrono::steady_clock::time_point timepoint,
+    ::std::chrono::steady_clock::duration   period,
     Task                                    task,
     ::std::weak_ptr<ThreadPool>             threadPool) :
     m_timepoint(timepoint),
-    m_task(::std::move(task)), m_status(Status::Ready), m_threadPool(threadPool)
+    m_period(period), m_deadline(timepoint),
+    m_nextDeadline(timepoint.time_since_epoch().count()),
+    m_task(::std::move(task)),
+    m_status(Status::Ready), m_threadPool(threadPool), m_inboxNext(nullptr),
+    m_posted(false), m_stored(false)
 {
     this->setInitializeResult(Result<void, Error>::makeOk());
 }
@@ -188,6 +1244,15 @@ const ::std::chrono::steady_clock::time_point &
     return m_timepoint;
 }
 
+/**
+ * @brief   Get period.
+ */
+const ::std::chrono::steady_clock::duration &
+    ThreadPool::AsyncAlarm::period() const
+{
+    return m_period;
+}
+
 /**
  * @brief   Cancel the alarm.
  */
@@ -212,17 +1277,91 @@ bool ThreadPool::AsyncAlarm::cancel()
     }
 }
 
+/**
+ * @brief   Move the deadline of a one-shot alarm.
+ */
+bool ThreadPool::AsyncAlarm::reschedule(
+    ::std::chrono::steady_clock::time_point timepoint, bool lazy)
+{
+    if (m_period > ::std::chrono::steady_clock::duration::zero()
+        || m_status != Status::Ready) {
+        return false;
+    }
+
+    // Firing swaps the deadline for "fired", so either the alarm thread sees
+    // the new deadline or this sees the alarm fired.
+    auto previous = m_nextDeadline.load();
+    do {
+        if (previous == _fired) {
+            return false;
+        }
+    } while (! m_nextDeadline.compare_exchange_weak(
+        previous, timepoint.time_since_epoch().count()));
+
+    // Later deadlines are checked when the earlier one comes.
+    if (lazy && timepoint.time_since_epoch().count() >= previous) {
+        return true;
+    }
+
+    auto threadPool = m_threadPool.lock();
+    if (threadPool != nullptr) {
+        threadPool->postAlarm(this->shared_from_this(), timepoint);
+    }
+
+    return true;
+}
+
+/**
+ * @brief   Check a one-shot alarm whose deadline has come.
+ */
+bool ThreadPool::AsyncAlarm::takeLaterDeadline(
+    ::std::chrono::steady_clock::time_point now)
+{
+    if (m_period > ::std::chrono::steady_clock::duration::zero()) {
+        return false;
+    }
+
+    auto next = m_nextDeadline.load();
+    do {
+        if (next != _fired && next > now.time_since_epoch().count()) {
+            m_deadline = ::std::chrono::steady_clock::time_point(
+                ::std::chrono::steady_clock::duration {next});
+            return true;
+        }
+    } while (! m_nextDeadline.compare_exchange_weak(next, _fired));
+
+    return false;
+}
+
 /**
  * @brief   Run alarm task if not canceled or alarmed.
  */
 void ThreadPool::AsyncAlarm::alarm()
 {
+    // A periodic alarm stays ready until canceled, it is rearmed after the
+    // task returns so runs never overlap.
+    if (m_period > ::std::chrono::steady_clock::duration::zero()) {
+        if (m_status == Status::Ready) {
+            this->recordLateness();
+            m_task();
+            auto threadPool = m_threadPool.lock();
+            if (threadPool != nullptr) {
+                auto thisPtr = this->shared_from_this();
+                threadPool->rearmAlarm(thisPtr);
+            }
+        }
+
+        return;
+    }
+
     // Set status.
     Status expected = Status::Ready;
     bool   exchanged
         = m_status.compare_exchange_strong(expected, Status::Alarmed);
 
     if (exchanged) {
+        m_nextDeadline = _fired;
+        this->recordLateness();
         m_task();
     } else {
         if (m_status == Status::Alarmed) {
@@ -232,6 +1371,18 @@ void ThreadPool::AsyncAlarm::alarm()
     }
 }
 
+/**
+ * @brief   Record lateness of the alarm to the pool.
+ */
+void ThreadPool::AsyncAlarm::recordLateness()
+{
+    auto threadPool = m_threadPool.lock();
+    if (threadPool != nullptr && threadPool->m_telemetrySampleInterval != 0) {
+        threadPool->m_alarmLateness.record(
+            ThreadPool::nanoseconds(threadPool->now() - m_deadline));
+    }
+}
+
 /**
  * @brief       Constructor.
  */
@@ -0,0 +1,231 @@
+#include <algorithm>
+#include <bit>
+
+#include <common/logger/logger.h>
+
+#include <common/thread_pool/timing_wheel.h>
+
+namespace remotePortMapper {
+
+/**
+ * @brief       Get the index of a tick in the level.
+ *
+ * @param[in]   tick        Tick.
+ * @param[in]   level       Level.
+ *
+ * @return      Index.
+ */
+static inline unsigned int slotIndex(uint64_t tick, unsigned int level)
+{
+    return static_cast<unsigned int>((tick >> (level * TimingWheel::slotBits))
+                                     & (TimingWheel::slotCount - 1));
+}
+
+/**
+ * @brief       Clear the bits of a tick lower than the level.
+ *
+ * @param[in]   tick        Tick.
+ * @param[in]   bits        Count of bits to clear.
+ *
+ * @return      Tick with lower bits cleared.
+ */
+static inline uint64_t clearLowBits(uint64_t tick, unsigned int bits)
+{
+    return bits >= 64 ? 0 : (tick >> bits) << bits;
+}
+
+/**
+ * @brief       Constructor.
+ */
+TimingWheel::TimingWheel(uint64_t currentTick) :
+    m_bitmaps {}, m_currentTick(currentTick), m_size(0)
+{
+    for (auto &level : m_slots) {
+        level.fill(nullptr);
+    }
+}
+
+/**
+ * @brief       Destructor, unlinks all nodes.
+ */
+TimingWheel::~TimingWheel()
+{
+    ::std::vector<TimingWheelNode *> nodes;
+    this->clear(nodes);
+}
+
+/**
+ * @brief       Insert a node.
+ */
+void TimingWheel::insert(TimingWheelNode *node, uint64_t expireTick)
+{
+    if (node->linked()) {
+        panic("TimingWheelNode at " << node << " has already been inserted.");
+    }
+
+    node->m_expireTick = ::std::max(expireTick, m_currentTick + 1);
+    this->link(node);
+    ++m_size;
+}
+
+/**
+ * @brief       Remove a node.
+ */
+void TimingWheel::remove(TimingWheelNode *node)
+{
+    if (! node->linked()) {
+        return;
+    }
+
+    // Unlink.
+    *(node->m_pprev) = node->m_next;
+    if (node->m_next != nullptr) {
+        node->m_next->m_pprev = node->m_pprev;
+    }
+    if (m_slots[node->m_level][node->m_slot] == nullptr) {
+        m_bitmaps[node->m_level]
+            &= ~(static_cast<uint64_t>(1) << node->m_slot);
+    }
+
+    node->m_next  = nullptr;
+    node->m_pprev = nullptr;
+    --m_size;
+}
+
+/**
+ * @brief       Get the next tick the wheel has work to do.
+ */
+uint64_t TimingWheel::nextTick() const
+{
+    // Nodes in lower levels always expire before the next slot of upper
+    // levels, so the first occupied level decides.
+    for (unsigned int level = 0; level < levelCount; ++level) {
+        uint64_t bitmap = m_bitmaps[level];
+        if (bitmap == 0) {
+            continue;
+        }
+
+        // Nodes are always in slots after the current one.
+        unsigned int current = slotIndex(m_currentTick, level);
+        if (current == slotCount - 1) {
+            bitmap = 0;
+        } else {
+            bitmap &= ~((static_cast<uint64_t>(2) << current) - 1);
+        }
+        if (bitmap == 0) {
+            panic("Timing wheel is corrupted.");
+        }
+
+        unsigned int slot
+            = static_cast<unsigned int>(::std::countr_zero(bitmap));
+        return clearLowBits(m_currentTick, (level + 1) * slotBits)
+               | (static_cast<uint64_t>(slot) << (level * slotBits));
+    }
+
+    return noTick;
+}
+
+/**
+ * @brief       Advance the wheel.
+ */
+void TimingWheel::advance(uint64_t                          tick,
+                          ::std::vector<TimingWheelNode *> &expired)
+{
+    while (true) {
+        uint64_t next = this->nextTick();
+        if (next > tick) {
+            m_currentTick = ::std::max(m_currentTick, tick);
+            return;
+        }
+        m_currentTick = next;
+
+        // Cascade upper levels which reach the beginning of a slot.
+        for (unsigned int level = levelCount - 1; level > 0; --level) {
+            if (clearLowBits(next, level * slotBits) != next) {
+                continue;
+            }
+
+            TimingWheelNode *node
+                = this->takeSlot(level, slotIndex(next, level));
+            while (node != nullptr) {
+                TimingWheelNode *nextNode = node->m_next;
+                this->link(node);
+                node = nextNode;
+            }
+        }
+
+        // Expire.
+        TimingWheelNode *node = this->takeSlot(0, slotIndex(next, 0));
+        while (node != nullptr) {
+            TimingWheelNode *nextNode = node->m_next;
+            node->m_next              = nullptr;
+            node->m_pprev             = nullptr;
+            --m_size;
+            expired.push_back(node);
+            node = nextNode;
+        }
+    }
+}
+
+/**
+ * @brief       Unlink all nodes.
+ */
+void TimingWheel::clear(::std::vector<TimingWheelNode *> &nodes)
+{
+    for (unsigned int level = 0; level < levelCount; ++level) {
+        while (m_bitmaps[level] != 0) {
+            TimingWheelNode *node = this->takeSlot(
+                level,
+                static_cast<unsigned int>(
+                    ::std::countr_zero(m_bitmaps[level])));
+            while (node != nullptr) {
+                TimingWheelNode *nextNode = node->m_next;
+                node->m_next              = nullptr;
+                node->m_pprev             = nullptr;
+                nodes.push_back(node);
+                node = nextNode;
+            }
+        }
+    }
+    m_size = 0;
+}
+
+/**
+ * @brief       Link a node to the slot matching its expire tick.
+ */
+void TimingWheel::link(TimingWheelNode *node)
+{
+    // The lowest level where the expire tick shares all upper bits with the
+    // current tick.
+    uint64_t     diff  = node->m_expireTick ^ m_currentTick;
+    unsigned int level = diff == 0 ? 0
+                                   : static_cast<unsigned int>(
+                                         63 - ::std::countl_zero(diff))
+                                         / slotBits;
+    unsigned int slot  = slotIndex(node->m_expireTick, level);
+
+    TimingWheelNode *&head = m_slots[level][slot];
+    node->m_next           = head;
+    node->m_pprev          = &head;
+    if (head != nullptr) {
+        head->m_pprev = &(node->m_next);
+    }
+    head          = node;
+    node->m_level = static_cast<uint8_t>(level);
+    node->m_slot  = static_cast<uint8_t>(slot);
+    m_bitmaps[level] |= static_cast<uint64_t>(1) << slot;
+}
+
+/**
+ * @brief       Take all nodes in a slot.
+ */
+TimingWheelNode *TimingWheel::takeSlot(unsigned int level, unsigned int slot)
+{
+    TimingWheelNode *ret = m_slots[level][slot];
+    m_slots[level][slot] = nullptr;
+    m_bitmaps[level] &= ~(static_cast<uint64_t>(1) << slot);
+
+    return ret;
+}
+
+} // namespace remotePortMapper
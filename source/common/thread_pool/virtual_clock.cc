@@ -0,0 +1,80 @@
+#include <algorithm>
+
+#include <common/thread_pool/thread_pool.h>
+#include <common/thread_pool/virtual_clock.h>
+
+namespace remotePortMapper {
+
+/**
+ * @brief       Constructor.
+ */
+VirtualClock::VirtualClock(::std::chrono::steady_clock::time_point start) :
+    m_now(start.time_since_epoch().count())
+{
+    this->setInitializeResult(Result<void, Error>::makeOk());
+}
+
+/**
+ * @brief       Get current time.
+ */
+::std::chrono::steady_clock::time_point VirtualClock::now() const
+{
+    return ::std::chrono::steady_clock::time_point(
+        ::std::chrono::steady_clock::duration(m_now.load()));
+}
+
+/**
+ * @brief       Advance the clock.
+ */
+void VirtualClock::advance(::std::chrono::steady_clock::duration duration)
+{
+    if (duration <= ::std::chrono::steady_clock::duration::zero()) {
+        return;
+    }
+
+    ::std::unique_lock lock(m_lock);
+    m_now.fetch_add(duration.count());
+    for (auto threadPool : m_threadPools) {
+        threadPool->wakeAlarmThread();
+    }
+}
+
+/**
+ * @brief       Advance the clock to a timepoint.
+ */
+void VirtualClock::advanceTo(
+    ::std::chrono::steady_clock::time_point timepoint)
+{
+    ::std::unique_lock lock(m_lock);
+    auto               now = m_now.load();
+    if (timepoint.time_since_epoch().count() <= now) {
+        return;
+    }
+
+    m_now.store(timepoint.time_since_epoch().count());
+    for (auto threadPool : m_threadPools) {
+        threadPool->wakeAlarmThread();
+    }
+}
+
+/**
+ * @brief       Wake a thread pool when the clock advances.
+ */
+void VirtualClock::attach(ThreadPool *threadPool)
+{
+    ::std::unique_lock lock(m_lock);
+    m_threadPools.push_back(threadPool);
+}
+
+/**
+ * @brief       Stop waking a thread pool.
+ */
+void VirtualClock::detach(ThreadPool *threadPool)
+{
+    ::std::unique_lock lock(m_lock);
+    m_threadPools.erase(
+        ::std::remove(m_threadPools.begin(), m_threadPools.end(), threadPool),
+        m_threadPools.end());
+}
+
+} // namespace remotePortMapper
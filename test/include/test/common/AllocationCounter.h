@@ -0,0 +1,107 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <cstdlib>
+#include <new>
+
+/**
+ * @brief   Counter of allocations by the global \c operator new.
+ *
+ * Including this header replaces the global \c operator new and
+ * \c operator delete of the test, so only the one source file of a test
+ * which checks allocation counts includes it. Allocations of all threads
+ * are counted while a counter exists, the replacement only forwards to
+ * \c malloc and \c free otherwise.
+ */
+class AllocationCounter {
+  private:
+    static inline ::std::atomic<uint32_t> _counters    = 0; ///< Counters.
+    static inline ::std::atomic<uint64_t> _allocations = 0; ///< Allocations.
+
+  private:
+    uint64_t m_begin; ///< Allocations when created.
+
+  public:
+    /**
+     * @brief       Constructor, start counting.
+     */
+    AllocationCounter()
+    {
+        _counters.fetch_add(1);
+        m_begin = _allocations.load();
+    }
+
+    /**
+     * @brief       Destructor, stop counting.
+     */
+    ~AllocationCounter()
+    {
+        _counters.fetch_sub(1);
+    }
+
+    AllocationCounter(const AllocationCounter &)            = delete;
+    AllocationCounter &operator=(const AllocationCounter &) = delete;
+
+  public:
+    /**
+     * @brief       Get allocations since the counter was created or reset.
+     *
+     * @return      Count of allocations.
+     */
+    uint64_t allocations() const
+    {
+        return _allocations.load() - m_begin;
+    }
+
+    /**
+     * @brief       Count from zero again.
+     */
+    void reset()
+    {
+        m_begin = _allocations.load();
+    }
+
+    /**
+     * @brief       Count an allocation if any counter exists.
+     */
+    static void count()
+    {
+        if (_counters.load(::std::memory_order_relaxed) > 0) {
+            _allocations.fetch_add(1, ::std::memory_order_relaxed);
+        }
+    }
+};
+
+// The replacements are never inlined, GCC would pair inlined calls of them
+// with allocations of the default operators and warn about mismatches.
+
+/**
+ * @brief       Allocate and count.
+ */
+[[gnu::noinline]] void *operator new(::std::size_t size)
+{
+    AllocationCounter::count();
+    void *ret = ::std::malloc(size == 0 ? 1 : size);
+    if (ret == nullptr) {
+        throw ::std::bad_alloc();
+    }
+
+    return ret;
+}
+
+/**
+ * @brief       Free.
+ */
+[[gnu::noinline]] void operator delete(void *ptr) noexcept
+{
+    ::std::free(ptr);
+}
+
+/**
+ * @brief       Free.
+ */
+[[gnu::noinline]] void operator delete(void *ptr, ::std::size_t) noexcept
+{
+    ::std::free(ptr);
+}
@@ -0,0 +1,217 @@
+#include <chrono>
+#include <future>
+#include <thread>
+
+#include <gtest/gtest.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <common/coroutine/coroutine.h>
+#include <common/coroutine/io_reactor.h>
+#include <common/coroutine/thread_pool_awaiter.h>
+
+namespace {
+
+using ::remotePortMapper::Coroutine;
+using ::remotePortMapper::EventLoop;
+using ::remotePortMapper::IoReactor;
+using ::remotePortMapper::ThreadPool;
+
+/**
+ * @brief       Create a thread pool.
+ */
+::std::shared_ptr<ThreadPool> createThreadPool()
+{
+    auto result = ThreadPool::create(
+        ::remotePortMapper::ThreadPoolOptions {.workers = 2});
+    EXPECT_TRUE(result);
+    return result.value<::std::shared_ptr<ThreadPool>>();
+}
+
+/**
+ * @brief       Add two values.
+ */
+Coroutine<int> add(int a, int b)
+{
+    co_return a + b;
+}
+
+/**
+ * @brief       Sum with nested coroutines.
+ */
+Coroutine<int> sum(int count)
+{
+    int ret = 0;
+    for (int i = 0; i < count; ++i) {
+        ret = co_await add(ret, i);
+    }
+    co_return ret;
+}
+
+/**
+ * @brief       Set the value of a promise.
+ */
+Coroutine<> setSum(int count, ::std::promise<int> &promise)
+{
+    promise.set_value(co_await sum(count));
+}
+
+/**
+ * @brief       Set a flag.
+ */
+Coroutine<> setFlag(bool &flag)
+{
+    flag = true;
+    co_return;
+}
+
+/**
+ * @brief       Continue on a thread pool and report the thread.
+ */
+Coroutine<> getThread(ThreadPool                        &threadPool,
+                      ::std::promise<::std::thread::id> &promise)
+{
+    co_await ::remotePortMapper::schedule(threadPool);
+    promise.set_value(::std::this_thread::get_id());
+}
+
+/**
+ * @brief       Sleep on a thread pool.
+ */
+Coroutine<> sleep(ThreadPool                           &threadPool,
+                  ::std::chrono::steady_clock::duration duration,
+                  ::std::promise<void>                 &promise)
+{
+    co_await ::remotePortMapper::sleepFor(threadPool, duration);
+    promise.set_value();
+}
+
+/**
+ * @brief       Wait for writeable, write to peer and read it back.
+ */
+Coroutine<> echo(IoReactor &reactor, int fd, ::std::promise<char> &promise)
+{
+    auto result = co_await reactor.wait(fd, EventLoop::Event::Writeable);
+    EXPECT_TRUE(result.ok());
+    char c = 'a';
+    EXPECT_EQ(::write(fd, &c, 1), 1);
+
+    c      = '\0';
+    result = co_await reactor.wait(fd, EventLoop::Event::Readable);
+    EXPECT_TRUE(result.ok());
+    EXPECT_EQ(::read(fd, &c, 1), 1);
+    promise.set_value(c);
+}
+
+/**
+ * @brief       Wait for readable and report if succeeded.
+ */
+Coroutine<> waitReadable(IoReactor            &reactor,
+                         int                   fd,
+                         ::std::promise<bool> &promise)
+{
+    auto result = co_await reactor.wait(fd, EventLoop::Event::Readable);
+    promise.set_value(result.ok());
+}
+
+} // namespace
+
+TEST(Coroutine, value)
+{
+    ::std::promise<int> promise;
+    setSum(100, promise).start();
+
+    auto future = promise.get_future();
+    ASSERT_EQ(future.wait_for(::std::chrono::seconds(0)),
+              ::std::future_status::ready);
+    ASSERT_EQ(future.get(), 4950);
+}
+
+TEST(Coroutine, lazy)
+{
+    bool started   = false;
+    auto coroutine = setFlag(started);
+    ASSERT_FALSE(started);
+    ASSERT_FALSE(coroutine.done());
+
+    ::std::move(coroutine).start();
+    ASSERT_TRUE(started);
+}
+
+TEST(Coroutine, schedule)
+{
+    auto threadPool = createThreadPool();
+
+    ::std::promise<::std::thread::id> promise;
+    getThread(*threadPool, promise).start();
+
+    auto future = promise.get_future();
+    ASSERT_EQ(future.wait_for(::std::chrono::seconds(10)),
+              ::std::future_status::ready);
+    ASSERT_NE(future.get(), ::std::this_thread::get_id());
+    threadPool.reset();
+}
+
+TEST(Coroutine, sleep)
+{
+    auto threadPool = createThreadPool();
+
+    auto                 duration = ::std::chrono::milliseconds(50);
+    auto                 begin    = ::std::chrono::steady_clock::now();
+    ::std::promise<void> promise;
+    sleep(*threadPool, duration, promise).start(*threadPool);
+
+    auto future = promise.get_future();
+    ASSERT_EQ(future.wait_for(::std::chrono::seconds(10)),
+              ::std::future_status::ready);
+    ASSERT_GE(::std::chrono::steady_clock::now() - begin, duration);
+    threadPool.reset();
+}
+
+TEST(Coroutine, ioReactor)
+{
+    auto threadPool = createThreadPool();
+    auto result     = IoReactor::create(threadPool);
+    ASSERT_TRUE(result);
+    auto reactor
+        = ::std::move(result.value<::std::shared_ptr<IoReactor>>());
+
+    int fds[2];
+    ASSERT_EQ(::socketpair(AF_UNIX, SOCK_STREAM, 0, fds), 0);
+
+    // Peer echoes what it reads.
+    ::std::thread peer([&]() -> void {
+        char c;
+        if (::read(fds[1], &c, 1) == 1) {
+            EXPECT_EQ(::write(fds[1], &c, 1), 1);
+        }
+    });
+
+    ::std::promise<char> promise;
+    echo(*reactor, fds[0], promise).start();
+
+    auto future = promise.get_future();
+    ASSERT_EQ(future.wait_for(::std::chrono::seconds(10)),
+              ::std::future_status::ready);
+    ASSERT_EQ(future.get(), 'a');
+    peer.join();
+
+    // Destroying the reactor wakes up the waiter with an error.
+    ::std::promise<bool> errorPromise;
+    waitReadable(*reactor, fds[0], errorPromise).start();
+    reactor.reset();
+
+    auto errorFuture = errorPromise.get_future();
+    ASSERT_EQ(errorFuture.wait_for(::std::chrono::seconds(10)),
+              ::std::future_status::ready);
+    ASSERT_FALSE(errorFuture.get());
+
+    threadPool.reset();
+    ::close(fds[0]);
+    ::close(fds[1]);
+}
+
+TEST(Coroutine, ioReactorNullThreadPool)
+{
+    ASSERT_FALSE(IoReactor::create(nullptr));
+}
@@ -0,0 +1,97 @@
+#include <memory>
+#include <type_traits>
+
+#include <gtest/gtest.h>
+
+#include <common/functional/function_ref.h>
+
+/**
+ * @brief       Add two numbers.
+ */
+static int add(int a, int b)
+{
+    return a + b;
+}
+
+/**
+ * @brief   Counter of calls.
+ */
+struct Counter {
+    int count = 0; ///< Count of calls.
+
+    /**
+     * @brief       Count a call.
+     */
+    void operator()(int)
+    {
+        ++count;
+    }
+
+    /**
+     * @brief       Get count of calls.
+     */
+    int get() const
+    {
+        return count;
+    }
+};
+
+/**
+ * @brief       Call a callback with each number in a range.
+ */
+static void forEach(int                                        begin,
+                    int                                        end,
+                    ::remotePortMapper::FunctionRef<void(int)> callback)
+{
+    for (int i = begin; i < end; ++i) {
+        callback(i);
+    }
+}
+
+TEST(FunctionRef, size)
+{
+    using Ref = ::remotePortMapper::FunctionRef<int(int, int)>;
+    ASSERT_EQ(sizeof(Ref), 2 * sizeof(void *));
+    ASSERT_TRUE(::std::is_trivially_copyable<Ref>::value);
+    ASSERT_FALSE(::std::is_default_constructible<Ref>::value);
+}
+
+TEST(FunctionRef, functionRef)
+{
+    // Lambda, state changes are seen by the referenced object.
+    int sum = 0;
+    forEach(0, 5, [&sum](int n) -> void {
+        sum += n;
+    });
+    ASSERT_EQ(sum, 10);
+
+    Counter counter;
+    forEach(0, 3, counter);
+    forEach(0, 3, counter);
+    ASSERT_EQ(counter.count, 6);
+
+    // Functions and function pointers.
+    ::remotePortMapper::FunctionRef<int(int, int)> function = add;
+    ASSERT_EQ(function(1, 2), 3);
+    int (*pointer)(int, int) = &add;
+    function                 = pointer;
+    pointer                  = nullptr;
+    ASSERT_EQ(function(3, 4), 7);
+
+    // Copies refer to the same callable, return values are converted.
+    ::remotePortMapper::FunctionRef<long(int, int)> converted = function;
+    ASSERT_EQ(converted(5, 6), 11L);
+
+    // Member functions.
+    auto member = &Counter::get;
+    ::remotePortMapper::FunctionRef<int(const Counter &)> get = member;
+    ASSERT_EQ(get(counter), 6);
+
+    // Const callables and move-only arguments.
+    const auto constant = [](::std::unique_ptr<int> value) -> int {
+        return *value;
+    };
+    ::remotePortMapper::FunctionRef<int(::std::unique_ptr<int>)> unique
+        = constant;
+    ASSERT_EQ(unique(::std::make_unique<int>(42)), 42);
+}
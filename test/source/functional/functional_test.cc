@@ -1,7 +1,13 @@
+#include <array>
+#include <atomic>
 #include <cstdint>
+#include <functional>
+#include <memory>
+#include <memory_resource>
 
 #include <gtest/gtest.h>
 
+#include <test/common/AllocationCounter.h>
 #include <test/common/TestClass.h>
 
 #include <common/functional/move_only_function.h>
@@ -18,7 +24,7 @@ class FunctionalTestClass {
 TEST(Functional, functional)
 {
     {
-        volatile bool flag = flag;
+        volatile bool flag = false;
 
         ::remotePortMapper::MoveOnlyFunction<void()> func([&]() -> void {
             flag = true;
@@ -40,3 +46,228 @@ TEST(Functional, functional)
         ASSERT_EQ(func(789), 123 + 456 + 789);
     }
 }
+
+TEST(Functional, lvalue)
+{
+    // Lvalues are copied, the original stays usable.
+    int                     count = 0;
+    ::std::function<void()> function([&]() -> void {
+        ++count;
+    });
+    ::remotePortMapper::MoveOnlyFunction<void()> func(function);
+    func();
+    function();
+    ASSERT_EQ(count, 2);
+
+    auto lambda = [&count](int n) -> int {
+        return count + n;
+    };
+    ::remotePortMapper::MoveOnlyFunction<int(int)> funcLambda(lambda);
+    ASSERT_EQ(funcLambda(1), 3);
+    ASSERT_EQ(lambda(1), 3);
+}
+
+TEST(Functional, inlineStorage)
+{
+    // Small captures are stored in place.
+    auto              shared = ::std::make_shared<int>(1);
+    AllocationCounter counter;
+    {
+        ::remotePortMapper::MoveOnlyFunction<int()> func(
+            [shared, ptr = shared.get()]() -> int {
+                return *shared + *ptr;
+            });
+        ::remotePortMapper::MoveOnlyFunction<int()> moved(::std::move(func));
+        ASSERT_FALSE(func);
+        ASSERT_EQ(moved(), 2);
+        ASSERT_EQ(shared.use_count(), 2);
+        func = ::std::move(moved);
+        ASSERT_EQ(func(), 2);
+    }
+    ASSERT_EQ(counter.allocations(), 0);
+    ASSERT_EQ(shared.use_count(), 1);
+
+    // Large captures are allocated unless the storage is large enough.
+    ::std::array<uint64_t, 8> array = {1, 2, 3, 4, 5, 6, 7, 8};
+    counter.reset();
+    {
+        ::remotePortMapper::MoveOnlyFunction<uint64_t()> func(
+            [array]() -> uint64_t {
+                return array[7];
+            });
+        ::remotePortMapper::MoveOnlyFunction<uint64_t()> moved(
+            ::std::move(func));
+        ASSERT_EQ(moved(), 8);
+    }
+    ASSERT_EQ(counter.allocations(), 1);
+    counter.reset();
+    {
+        ::remotePortMapper::MoveOnlyFunction<uint64_t(), sizeof(array)> func(
+            [array]() -> uint64_t {
+                return array[7];
+            });
+        ASSERT_EQ(func(), 8);
+    }
+    ASSERT_EQ(counter.allocations(), 0);
+}
+
+TEST(Functional, lifetime)
+{
+    // Every callable constructed is destroyed exactly once.
+    int constructed = 0;
+    int destructed  = 0;
+    {
+        TestClass object(
+            [&](TestClass *) -> void {
+                ++constructed;
+            },
+            [&](TestClass *) -> void {
+                ++destructed;
+            },
+            nullptr, nullptr);
+        ::remotePortMapper::MoveOnlyFunction<void()> func(
+            [object = ::std::move(object)]() -> void {});
+        ::remotePortMapper::MoveOnlyFunction<void()> moved(::std::move(func));
+        func = ::std::move(moved);
+        func = ::remotePortMapper::MoveOnlyFunction<void()>();
+        ASSERT_FALSE(func);
+        ASSERT_EQ(destructed, constructed - 1);
+    }
+    ASSERT_EQ(destructed, constructed);
+}
+
+/**
+ * @brief   Memory resource counting allocations from an upstream resource.
+ */
+class CountingResource : public ::std::pmr::memory_resource {
+  public:
+    ::std::pmr::memory_resource *upstream;         ///< Upstream resource.
+    ::std::atomic<int>           allocations   = 0; ///< Allocations.
+    ::std::atomic<int>           deallocations = 0; ///< Deallocations.
+
+  public:
+    /**
+     * @brief       Constructor.
+     *
+     * @param[in]   upstream        Upstream resource.
+     */
+    CountingResource(::std::pmr::memory_resource *upstream) :
+        upstream(upstream)
+    {}
+
+  private:
+    /**
+     * @brief       Allocate.
+     */
+    void *do_allocate(::std::size_t bytes, ::std::size_t alignment) override
+    {
+        allocations.fetch_add(1);
+        return upstream->allocate(bytes, alignment);
+    }
+
+    /**
+     * @brief       Deallocate.
+     */
+    void do_deallocate(void         *ptr,
+                       ::std::size_t bytes,
+                       ::std::size_t alignment) override
+    {
+        deallocations.fetch_add(1);
+        upstream->deallocate(ptr, bytes, alignment);
+    }
+
+    /**
+     * @brief       Compare.
+     */
+    bool do_is_equal(
+        const ::std::pmr::memory_resource &other) const noexcept override
+    {
+        return this == &other;
+    }
+};
+
+/**
+ * @brief   Allocator counting allocations.
+ */
+template<typename T>
+struct CountingAllocator {
+    using value_type = T;
+
+    int *allocations; ///< Count of allocations alive.
+
+    /**
+     * @brief       Constructor.
+     */
+    CountingAllocator(int *allocations) : allocations(allocations) {}
+
+    /**
+     * @brief       Constructor.
+     */
+    template<typename U>
+    CountingAllocator(const CountingAllocator<U> &allocator) :
+        allocations(allocator.allocations)
+    {}
+
+    /**
+     * @brief       Allocate.
+     */
+    T *allocate(::std::size_t count)
+    {
+        ++*allocations;
+        return ::std::allocator<T>().allocate(count);
+    }
+
+    /**
+     * @brief       Deallocate.
+     */
+    void deallocate(T *ptr, ::std::size_t count)
+    {
+        --*allocations;
+        ::std::allocator<T>().deallocate(ptr, count);
+    }
+};
+
+TEST(Functional, allocator)
+{
+    // Large captures come from the arena, nothing from the global heap.
+    ::std::array<::std::byte, 1024>       buffer;
+    ::std::pmr::monotonic_buffer_resource arena(
+        buffer.data(), buffer.size(), ::std::pmr::null_memory_resource());
+    CountingResource          resource(&arena);
+    ::std::array<uint64_t, 8> array = {1, 2, 3, 4, 5, 6, 7, 8};
+    AllocationCounter         counter;
+    {
+        ::remotePortMapper::MoveOnlyFunction<uint64_t()> func(
+            ::std::allocator_arg, &resource, [array]() -> uint64_t {
+                return array[7];
+            });
+        ::remotePortMapper::MoveOnlyFunction<uint64_t()> moved(
+            ::std::move(func));
+        ASSERT_EQ(moved(), 8);
+        ASSERT_EQ(resource.allocations.load(), 1);
+        ASSERT_EQ(resource.deallocations.load(), 0);
+
+        // Small captures stay in place.
+        ::remotePortMapper::MoveOnlyFunction<int()> small(
+            ::std::allocator_arg, &resource, []() -> int {
+                return 1;
+            });
+        ASSERT_EQ(small(), 1);
+        ASSERT_EQ(resource.allocations.load(), 1);
+    }
+    ASSERT_EQ(resource.deallocations.load(), 1);
+    ASSERT_EQ(counter.allocations(), 0);
+
+    // Custom allocators.
+    int allocations = 0;
+    {
+        ::remotePortMapper::MoveOnlyFunction<uint64_t()> func(
+            ::std::allocator_arg, CountingAllocator<int>(&allocations),
+            [array]() -> uint64_t {
+                return array[0];
+            });
+        ASSERT_EQ(func(), 1);
+        ASSERT_EQ(allocations, 1);
+    }
+    ASSERT_EQ(allocations, 0);
+}
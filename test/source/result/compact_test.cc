@@ -0,0 +1,89 @@
+#include <cstdint>
+#include <string>
+#include <type_traits>
+
+#include <gtest/gtest.h>
+
+#include <common/error/static_error.h>
+#include <common/types/result.h>
+
+TEST(Result, compact)
+{
+    using ErrorCode = ::remotePortMapper::ErrorCode;
+
+    // Trivially copyable values give trivially copyable results.
+    using Size = ::remotePortMapper::Result<::std::size_t, ErrorCode>;
+    ASSERT_TRUE(::std::is_trivially_copyable<Size>::value);
+    ASSERT_EQ(sizeof(Size), 2 * sizeof(::std::size_t));
+    ASSERT_EQ(sizeof(::remotePortMapper::Result<uint32_t, ErrorCode>), 8);
+    using String    = ::remotePortMapper::Result<::std::string, ErrorCode>;
+    using Reference = ::remotePortMapper::Result<int &, ErrorCode>;
+    ASSERT_FALSE(::std::is_trivially_copyable<String>::value);
+    ASSERT_FALSE(::std::is_trivially_copyable<Reference>::value);
+
+    {
+        Size value;
+        ASSERT_DEATH(value.value<::std::size_t>(), ".*");
+        ASSERT_FALSE(value.good());
+        ASSERT_FALSE(value);
+
+        value = Size::makeOk(1024);
+        ASSERT_TRUE(value.ok());
+        ASSERT_DEATH(value.value<ErrorCode>(), ".*");
+        value.value<::std::size_t>() += 1;
+
+        // Moving copies the value.
+        Size moved = ::std::move(value);
+        ASSERT_EQ(moved.value<::std::size_t>(), 1025);
+        ASSERT_EQ(value.value<::std::size_t>(), 1025);
+
+        const Size error = Size::makeError(ErrorCode::Busy);
+        ASSERT_TRUE(error.good());
+        ASSERT_FALSE(error.ok());
+        ASSERT_EQ(error.value<ErrorCode>(), ErrorCode::Busy);
+
+        value.clear();
+        ASSERT_FALSE(value.good());
+    }
+
+    // The status of a void result is kept in the error code.
+    {
+        using Void = ::remotePortMapper::Result<void, ErrorCode>;
+        ASSERT_EQ(sizeof(Void), sizeof(ErrorCode));
+        ASSERT_TRUE(::std::is_trivially_copyable<Void>::value);
+
+        Void value;
+        ASSERT_DEATH(value.value<ErrorCode>(), ".*");
+        ASSERT_FALSE(value.good());
+
+        value = Void::makeOk();
+        ASSERT_TRUE(value.good());
+        ASSERT_TRUE(value.ok());
+        ASSERT_TRUE(value);
+        ASSERT_DEATH(value.value<ErrorCode>(), ".*");
+
+        value = Void::makeError(ErrorCode::InvalidValue);
+        ASSERT_TRUE(value.good());
+        ASSERT_FALSE(value);
+        ASSERT_EQ(value.value<ErrorCode>(), ErrorCode::InvalidValue);
+        ASSERT_DEATH(Void::makeError(ErrorCode::Success), ".*");
+
+        value.clear();
+        ASSERT_FALSE(value.good());
+    }
+
+    {
+        using StaticError = ::remotePortMapper::StaticError;
+        using Void        = ::remotePortMapper::Result<void, StaticError>;
+        ASSERT_EQ(sizeof(Void), sizeof(StaticError));
+
+        Void value = Void::makeOk();
+        ASSERT_TRUE(value);
+
+        value = Void::makeError(ErrorCode::Busy, "Try again.");
+        ASSERT_FALSE(value);
+        const Void &error = value;
+        ASSERT_EQ(error.value<StaticError>().errCode, ErrorCode::Busy);
+        ASSERT_STREQ(error.value<StaticError>().message, "Try again.");
+    }
+}
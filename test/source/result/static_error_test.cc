@@ -0,0 +1,41 @@
+#include <cerrno>
+#include <cstring>
+#include <string>
+#include <type_traits>
+
+#include <gtest/gtest.h>
+
+#include <common/error/static_error.h>
+#include <common/types/result.h>
+
+TEST(Result, staticError)
+{
+    using StaticError = ::remotePortMapper::StaticError;
+    ASSERT_TRUE(::std::is_trivially_copyable<StaticError>::value);
+
+    // The common case copies a code and a pointer.
+    auto result = ::remotePortMapper::Result<int, StaticError>::makeError(
+        StaticError {::remotePortMapper::ErrorCode::Busy, "Try again."});
+    ASSERT_FALSE(result);
+    auto error = result.value<StaticError>();
+    ASSERT_EQ(error.errCode, ::remotePortMapper::ErrorCode::Busy);
+    ASSERT_STREQ(error.message, "Try again.");
+    ASSERT_EQ(error.systemError, 0);
+    ASSERT_EQ(error.detail(), "Try again.");
+
+    // The detail is built when asked for.
+    error = StaticError {::remotePortMapper::ErrorCode::InvalidValue,
+                         "Failed to send.", EAGAIN};
+    ASSERT_EQ(error.detail(), ::std::string("Failed to send. errno ")
+                                  + ::std::to_string(EAGAIN) + ": "
+                                  + ::std::strerror(EAGAIN) + ".");
+
+    // Slow paths keep using Error.
+    ::remotePortMapper::Error converted = error;
+    ASSERT_EQ(converted.errCode, ::remotePortMapper::ErrorCode::InvalidValue);
+    ASSERT_EQ(converted.message, error.detail());
+    auto slow = ::remotePortMapper::Result<void, ::remotePortMapper::Error>::
+        makeError(error);
+    ASSERT_EQ(slow.value<::remotePortMapper::Error>().message,
+              error.detail());
+}
@@ -21,7 +21,10 @@ TEST(SocketAddress, all)
     ASSERT_EQ(addr.size(), sizeof(sockaddr_in));
     ASSERT_EQ(addr.toString(), "SocketAddress{\"0.0.0.0\", 8080}");
 
-    ASSERT_FALSE(addr.fill("1.0.0.0.0", 8080));
+    auto result = addr.fill("1.0.0.0.0", 8080);
+    ASSERT_FALSE(result);
+    ASSERT_EQ(result.value<::remotePortMapper::StaticError>().errCode,
+              ::remotePortMapper::ErrorCode::InvalidValue);
     ASSERT_EQ(addr.size(), 0);
     ASSERT_EQ(addr.type(), ::remotePortMapper::SocketAddress::Type::Unknow);
 
@@ -1,5 +1,9 @@
+#include <atomic>
+#include <chrono>
 #include <cstdint>
 #include <future>
+#include <thread>
+#include <vector>
 
 #include <gtest/gtest.h>
 
@@ -47,3 +51,166 @@ TEST(ThreadPoolDeathTest, alarm)
     alarm->alarm();
     ASSERT_FALSE(flag.load());
 }
+
+TEST(ThreadPool, alarmConcurrent)
+{
+    for (auto store : {::remotePortMapper::ThreadPoolAlarmStore::SortedMap,
+                       ::remotePortMapper::ThreadPoolAlarmStore::TimingWheel}) {
+        auto result = ::remotePortMapper::ThreadPool::create(
+            ::remotePortMapper::ThreadPoolOptions {.workers    = 2,
+                                                   .alarmStore = store});
+        ASSERT_TRUE(result);
+        auto threadPool
+            = result.value<::std::shared_ptr<::remotePortMapper::ThreadPool>>();
+
+        // Threads push back timeouts at once, only the last one of each
+        // fires, canceled ones never do.
+        constexpr int        threads = 4;
+        constexpr int        count   = 1000;
+        ::std::atomic<int>   fired(0);
+        ::std::atomic<int>   canceledFired(0);
+        ::std::promise<void> done;
+        ::std::vector<::std::thread> producers;
+        for (int i = 0; i < threads; ++i) {
+            producers.emplace_back([&]() -> void {
+                auto alarm = threadPool->addAlarm(
+                    ::std::chrono::steady_clock::now()
+                        + ::std::chrono::seconds(60),
+                    [&]() -> void {
+                        canceledFired.fetch_add(1);
+                    });
+                for (int j = 0; j < count; ++j) {
+                    EXPECT_TRUE(alarm->cancel());
+                    alarm = threadPool->addAlarm(
+                        ::std::chrono::steady_clock::now()
+                            + ::std::chrono::seconds(60),
+                        [&]() -> void {
+                            canceledFired.fetch_add(1);
+                        });
+                }
+                EXPECT_TRUE(alarm->cancel());
+                threadPool->addAlarm(::std::chrono::steady_clock::now()
+                                         + ::std::chrono::milliseconds(10),
+                                     [&]() -> void {
+                                         if (fired.fetch_add(1) + 1
+                                             == threads) {
+                                             done.set_value();
+                                         }
+                                     });
+            });
+        }
+        for (auto &producer : producers) {
+            producer.join();
+        }
+
+        auto future = done.get_future();
+        ASSERT_EQ(future.wait_for(::std::chrono::seconds(10)),
+                  ::std::future_status::ready);
+        ::std::this_thread::sleep_for(::std::chrono::milliseconds(20));
+        ASSERT_EQ(fired.load(), threads);
+        ASSERT_EQ(canceledFired.load(), 0);
+
+        threadPool.reset();
+    }
+}
+
+TEST(ThreadPool, alarmReschedule)
+{
+    for (auto store : {::remotePortMapper::ThreadPoolAlarmStore::SortedMap,
+                       ::remotePortMapper::ThreadPoolAlarmStore::TimingWheel}) {
+        for (bool lazy : {false, true}) {
+            auto result = ::remotePortMapper::ThreadPool::create(
+                ::remotePortMapper::ThreadPoolOptions {.workers    = 2,
+                                                       .alarmStore = store});
+            ASSERT_TRUE(result);
+            auto threadPool = result.value<
+                ::std::shared_ptr<::remotePortMapper::ThreadPool>>();
+
+            // Pushed back, never fires before the last deadline.
+            auto                 begin = ::std::chrono::steady_clock::now();
+            auto                 last  = begin;
+            ::std::promise<void> fired;
+            auto                 alarm = threadPool->addAlarm(
+                begin + ::std::chrono::milliseconds(200), [&]() -> void {
+                    EXPECT_GE(::std::chrono::steady_clock::now(), last);
+                    fired.set_value();
+                });
+            for (int i = 1; i <= 5; ++i) {
+                last = begin + ::std::chrono::milliseconds(200 + 10 * i);
+                ASSERT_TRUE(alarm->reschedule(last, lazy));
+            }
+            auto future = fired.get_future();
+            ASSERT_EQ(future.wait_for(::std::chrono::seconds(10)),
+                      ::std::future_status::ready);
+            ASSERT_FALSE(alarm->reschedule(last, lazy));
+
+            // Brought forward, fires at once.
+            ::std::promise<void> early;
+            alarm = threadPool->addAlarm(
+                ::std::chrono::steady_clock::now() + ::std::chrono::hours(1),
+                [&]() -> void {
+                    early.set_value();
+                });
+            ASSERT_TRUE(
+                alarm->reschedule(::std::chrono::steady_clock::now(), lazy));
+            future = early.get_future();
+            ASSERT_EQ(future.wait_for(::std::chrono::seconds(10)),
+                      ::std::future_status::ready);
+
+            // Canceled and periodic alarms are not rescheduled.
+            alarm = threadPool->addAlarm(
+                ::std::chrono::steady_clock::now() + ::std::chrono::hours(1),
+                []() -> void {});
+            ASSERT_TRUE(alarm->cancel());
+            ASSERT_FALSE(
+                alarm->reschedule(::std::chrono::steady_clock::now(), lazy));
+            auto periodic = threadPool->addPeriodicAlarm(
+                ::std::chrono::steady_clock::now() + ::std::chrono::hours(1),
+                ::std::chrono::hours(1), []() -> void {});
+            ASSERT_FALSE(periodic->reschedule(
+                ::std::chrono::steady_clock::now(), lazy));
+            ASSERT_TRUE(periodic->cancel());
+
+            threadPool.reset();
+        }
+    }
+}
+
+TEST(ThreadPool, alarmRescheduleInInbox)
+{
+    for (auto store : {::remotePortMapper::ThreadPoolAlarmStore::SortedMap,
+                       ::remotePortMapper::ThreadPoolAlarmStore::TimingWheel}) {
+        for (bool lazy : {false, true}) {
+            auto result = ::remotePortMapper::ThreadPool::create(
+                ::remotePortMapper::ThreadPoolOptions {.workers    = 2,
+                                                       .alarmStore = store});
+            ASSERT_TRUE(result);
+            auto threadPool = result.value<
+                ::std::shared_ptr<::remotePortMapper::ThreadPool>>();
+
+            // The alarm thread sleeps until the blocker.
+            auto blocker = threadPool->addAlarm(
+                ::std::chrono::steady_clock::now() + ::std::chrono::seconds(3),
+                []() -> void {});
+            ::std::this_thread::sleep_for(::std::chrono::milliseconds(50));
+
+            // A later alarm stays in the inbox, bringing it forward must
+            // still wake the alarm thread.
+            ::std::promise<void> fired;
+            auto                 alarm = threadPool->addAlarm(
+                ::std::chrono::steady_clock::now() + ::std::chrono::seconds(10),
+                [&]() -> void {
+                    fired.set_value();
+                });
+            auto deadline = ::std::chrono::steady_clock::now()
+                            + ::std::chrono::milliseconds(200);
+            ASSERT_TRUE(alarm->reschedule(deadline, lazy));
+            auto future = fired.get_future();
+            ASSERT_EQ(future.wait_for(::std::chrono::milliseconds(1500)),
+                      ::std::future_status::ready);
+
+            ASSERT_TRUE(blocker->cancel());
+            threadPool.reset();
+        }
+    }
+}
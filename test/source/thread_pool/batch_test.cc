@@ -0,0 +1,65 @@
+#include <cstdint>
+#include <future>
+#include <list>
+
+#include <gtest/gtest.h>
+
+#include <common/thread_pool/thread_pool.h>
+
+TEST(ThreadPool, addTasks)
+{
+    for (auto scheduler :
+         {::remotePortMapper::ThreadPoolScheduler::Global,
+          ::remotePortMapper::ThreadPoolScheduler::WorkStealing}) {
+        auto result = ::remotePortMapper::ThreadPool::create(
+            ::remotePortMapper::ThreadPoolOptions {.workers   = 3,
+                                                   .scheduler = scheduler});
+        ASSERT_TRUE(result);
+        auto threadPool
+            = result.value<::std::shared_ptr<::remotePortMapper::ThreadPool>>();
+
+        constexpr int        batchSize = 64;
+        constexpr int        total     = batchSize * 3;
+        ::std::atomic<int>   counter(0);
+        ::std::promise<void> done;
+        auto                 makeTask = [&]() {
+            return [&]() -> void {
+                if (counter.fetch_add(1) + 1 == total) {
+                    done.set_value();
+                }
+            };
+        };
+
+        // Span from outside of the pool.
+        ::std::vector<::remotePortMapper::ThreadPool::Task> tasks;
+        for (int i = 0; i < batchSize; ++i) {
+            tasks.push_back(makeTask());
+        }
+        threadPool->addTasks(tasks);
+
+        // Iterator range from outside of the pool.
+        ::std::list<::remotePortMapper::ThreadPool::Task> list;
+        for (int i = 0; i < batchSize; ++i) {
+            list.push_back(makeTask());
+        }
+        threadPool->addTasks(list.begin(), list.end());
+
+        // Batch from a worker.
+        threadPool->addTask([&]() -> void {
+            ::std::vector<::remotePortMapper::ThreadPool::Task> tasks;
+            for (int i = 0; i < batchSize; ++i) {
+                tasks.push_back(makeTask());
+            }
+            threadPool->addTasks(tasks.begin(), tasks.end());
+        });
+
+        // Empty batch.
+        threadPool->addTasks(
+            ::std::span<::remotePortMapper::ThreadPool::Task>());
+
+        auto future = done.get_future();
+        ASSERT_EQ(future.wait_for(::std::chrono::seconds(10)),
+                  ::std::future_status::ready);
+        ASSERT_EQ(counter.load(), total);
+    }
+}
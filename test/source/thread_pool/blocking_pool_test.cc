@@ -0,0 +1,145 @@
+#include <atomic>
+#include <chrono>
+#include <future>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <common/thread_pool/blocking_pool.h>
+#include <common/thread_pool/thread_pool.h>
+
+using IntResult  = ::remotePortMapper::Result<int, ::remotePortMapper::Error>;
+using VoidResult = ::remotePortMapper::Result<void, ::remotePortMapper::Error>;
+
+TEST(BlockingPool, submit)
+{
+    auto result = ::remotePortMapper::ThreadPool::create(1);
+    ASSERT_TRUE(result);
+    auto threadPool
+        = result.value<::std::shared_ptr<::remotePortMapper::ThreadPool>>();
+    auto blockingResult
+        = ::remotePortMapper::BlockingPool::create(threadPool);
+    ASSERT_TRUE(blockingResult);
+    auto blockingPool = blockingResult.value<
+        ::std::shared_ptr<::remotePortMapper::BlockingPool>>();
+    ASSERT_EQ(blockingPool->threadPool(), threadPool);
+
+    // The only worker of the main pool is free while the call blocks.
+    ::std::promise<void> gate;
+    auto                 gateFuture = gate.get_future().share();
+    ::std::thread::id    blockingThread;
+    auto future = blockingPool->submit([&, gateFuture]() -> IntResult {
+        blockingThread = ::std::this_thread::get_id();
+        gateFuture.wait();
+        return IntResult::makeOk(1);
+    });
+
+    ::std::promise<::std::thread::id> worker;
+    threadPool->addTask([&]() -> void {
+        worker.set_value(::std::this_thread::get_id());
+    });
+    auto workerFuture = worker.get_future();
+    ASSERT_EQ(workerFuture.wait_for(::std::chrono::seconds(10)),
+              ::std::future_status::ready);
+    auto workerThread = workerFuture.get();
+    ASSERT_EQ(blockingPool->pendingTasks(), 1);
+
+    // The result comes back on the main pool.
+    auto continued = future.then([&](IntResult result) -> IntResult {
+        EXPECT_EQ(::std::this_thread::get_id(), workerThread);
+        return IntResult::makeOk(result.value<int>() + 1);
+    });
+    gate.set_value();
+    auto value = continued.get();
+    ASSERT_TRUE(value);
+    ASSERT_EQ(value.value<int>(), 2);
+    ASSERT_NE(blockingThread, workerThread);
+    ASSERT_EQ(blockingPool->pendingTasks(), 0);
+
+    blockingPool.reset();
+    threadPool.reset();
+}
+
+TEST(BlockingPool, bounded)
+{
+    auto result = ::remotePortMapper::ThreadPool::create(1);
+    ASSERT_TRUE(result);
+    auto threadPool
+        = result.value<::std::shared_ptr<::remotePortMapper::ThreadPool>>();
+    auto blockingResult = ::remotePortMapper::BlockingPool::create(
+        threadPool,
+        ::remotePortMapper::BlockingPoolOptions {.maxThreads = 1,
+                                                 .maxQueued  = 1});
+    ASSERT_TRUE(blockingResult);
+    auto blockingPool = blockingResult.value<
+        ::std::shared_ptr<::remotePortMapper::BlockingPool>>();
+
+    // One running, one queued, the next one is refused at once.
+    ::std::promise<void> gate;
+    auto                 gateFuture = gate.get_future().share();
+    ::std::vector<::remotePortMapper::Future<void>> futures;
+    for (int i = 0; i < 2; ++i) {
+        futures.push_back(
+            blockingPool->submit([gateFuture]() -> VoidResult {
+                gateFuture.wait();
+                return VoidResult::makeOk();
+            }));
+    }
+    auto refused = blockingPool->submit([]() -> VoidResult {
+        return VoidResult::makeOk();
+    });
+    ASSERT_TRUE(refused.ready());
+    auto error = refused.get();
+    ASSERT_FALSE(error);
+    ASSERT_EQ(error.value<::remotePortMapper::Error>().errCode,
+              ::remotePortMapper::ErrorCode::Busy);
+
+    gate.set_value();
+    for (auto &future : futures) {
+        ASSERT_TRUE(future.get());
+    }
+    ASSERT_EQ(blockingPool->threadCount(), 1);
+
+    blockingPool.reset();
+    threadPool.reset();
+}
+
+TEST(BlockingPool, grows)
+{
+    auto result = ::remotePortMapper::ThreadPool::create(1);
+    ASSERT_TRUE(result);
+    auto threadPool
+        = result.value<::std::shared_ptr<::remotePortMapper::ThreadPool>>();
+    auto blockingResult = ::remotePortMapper::BlockingPool::create(
+        threadPool,
+        ::remotePortMapper::BlockingPoolOptions {.maxThreads = 4});
+    ASSERT_TRUE(blockingResult);
+    auto blockingPool = blockingResult.value<
+        ::std::shared_ptr<::remotePortMapper::BlockingPool>>();
+
+    // Blocked calls get threads of their own.
+    constexpr int      count = 4;
+    ::std::atomic<int> started(0);
+    ::std::vector<::remotePortMapper::Future<void>> futures;
+    for (int i = 0; i < count; ++i) {
+        futures.push_back(blockingPool->submit([&]() -> VoidResult {
+            started.fetch_add(1);
+            auto deadline = ::std::chrono::steady_clock::now()
+                            + ::std::chrono::seconds(10);
+            while (started.load() < count
+                   && ::std::chrono::steady_clock::now() < deadline) {
+                ::std::this_thread::sleep_for(::std::chrono::milliseconds(1));
+            }
+            return VoidResult::makeOk();
+        }));
+    }
+    for (auto &future : futures) {
+        ASSERT_TRUE(future.get());
+    }
+    ASSERT_EQ(started.load(), count);
+    ASSERT_EQ(blockingPool->threadCount(), count);
+
+    blockingPool.reset();
+    threadPool.reset();
+}
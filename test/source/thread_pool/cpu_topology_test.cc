@@ -0,0 +1,154 @@
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <future>
+
+#if defined(OS_LINUX)
+    #include <sched.h>
+
+#endif
+
+#include <gtest/gtest.h>
+
+#include <common/thread_pool/cpu_topology.h>
+#include <common/thread_pool/thread_pool.h>
+
+TEST(CpuTopology, parseCpuList)
+{
+    auto result
+        = ::remotePortMapper::CpuTopology::parseCpuList("0-3,8,10-11\n");
+    ASSERT_TRUE(result);
+    ASSERT_EQ(result.value<::std::vector<uint32_t>>(),
+              ::std::vector<uint32_t>({0, 1, 2, 3, 8, 10, 11}));
+
+    result = ::remotePortMapper::CpuTopology::parseCpuList("");
+    ASSERT_TRUE(result);
+    ASSERT_TRUE(result.value<::std::vector<uint32_t>>().empty());
+
+    for (auto list : {"a", "1-", "3-1", "1-2x", "-1"}) {
+        ASSERT_FALSE(::remotePortMapper::CpuTopology::parseCpuList(list))
+            << list;
+    }
+}
+
+TEST(CpuTopology, numaNodes)
+{
+    auto &nodes = ::remotePortMapper::CpuTopology::numaNodes();
+    ASSERT_FALSE(nodes.empty());
+
+    auto allowed = ::remotePortMapper::CpuTopology::allowedCpus();
+    auto cpus    = ::remotePortMapper::CpuTopology::cpus();
+    ASSERT_FALSE(cpus.empty());
+    for (auto cpu : cpus) {
+        ASSERT_NE(::std::find(allowed.begin(), allowed.end(), cpu),
+                  allowed.end());
+    }
+}
+
+/**
+ * @brief       Write a file of a fake cgroup filesystem.
+ *
+ * @param[in]   path        Path of the file.
+ * @param[in]   content     Content.
+ */
+static void writeCgroupFile(const ::std::filesystem::path &path,
+                            const ::std::string           &content)
+{
+    ::std::filesystem::create_directories(path.parent_path());
+    ::std::ofstream(path) << content << "\n";
+}
+
+TEST(CpuTopology, cpuQuota)
+{
+    ::std::filesystem::path root = "cgroup";
+    ::std::filesystem::remove_all(root);
+
+    // cgroup v2, the tightest ancestor wins, rounded up.
+    writeCgroupFile(root / "cpu.max", "max 100000");
+    writeCgroupFile(root / "a" / "cpu.max", "250000 100000");
+    writeCgroupFile(root / "a" / "b" / "cpu.max", "max 100000");
+    ASSERT_EQ(::remotePortMapper::CpuTopology::cpuQuota(root.string(),
+                                                        "0::/a/b\n"),
+              3);
+    writeCgroupFile(root / "a" / "b" / "cpu.max", "50000 100000");
+    ASSERT_EQ(::remotePortMapper::CpuTopology::cpuQuota(root.string(),
+                                                        "0::/a/b\n"),
+              1);
+    ASSERT_EQ(
+        ::remotePortMapper::CpuTopology::cpuQuota(root.string(), "0::/\n"),
+        0);
+
+    // cgroup v1, the path of the host is not mounted in the container.
+    writeCgroupFile(root / "cpu,cpuacct" / "cpu.cfs_quota_us", "200000");
+    writeCgroupFile(root / "cpu,cpuacct" / "cpu.cfs_period_us", "100000");
+    ASSERT_EQ(::remotePortMapper::CpuTopology::cpuQuota(
+                  root.string(), "4:memory:/docker/x\n"
+                                 "2:cpu,cpuacct:/docker/x\n"),
+              2);
+    writeCgroupFile(root / "cpu,cpuacct" / "cpu.cfs_quota_us", "-1");
+    ASSERT_EQ(::remotePortMapper::CpuTopology::cpuQuota(
+                  root.string(), "2:cpu,cpuacct:/docker/x\n"),
+              0);
+
+    ::std::filesystem::remove_all(root);
+}
+
+TEST(ThreadPool, defaultWorkers)
+{
+    uint32_t cpus = ::remotePortMapper::CpuTopology::availableCpuCount();
+    ASSERT_GE(cpus, 1);
+    ASSERT_LE(cpus, ::remotePortMapper::CpuTopology::allowedCpus().size());
+
+    auto result = ::remotePortMapper::ThreadPool::create();
+    ASSERT_TRUE(result);
+    auto threadPool
+        = result.value<::std::shared_ptr<::remotePortMapper::ThreadPool>>();
+    ASSERT_EQ(threadPool->workerCount(), cpus + 1);
+}
+
+TEST(ThreadPool, pinned)
+{
+    auto cpu    = ::remotePortMapper::CpuTopology::cpus().back();
+    auto result = ::remotePortMapper::ThreadPool::create(
+        ::remotePortMapper::ThreadPoolOptions {.workers = 2, .cpus = {cpu}});
+    ASSERT_TRUE(result);
+    auto threadPool
+        = result.value<::std::shared_ptr<::remotePortMapper::ThreadPool>>();
+    ASSERT_EQ(threadPool->cpus(), ::std::vector<uint32_t>({cpu}));
+
+    ::std::promise<int> ran;
+    threadPool->addTask([&]() -> void {
+#if defined(OS_LINUX)
+        ran.set_value(::sched_getcpu());
+#else
+        ran.set_value(static_cast<int>(cpu));
+#endif
+    });
+    auto future = ran.get_future();
+    ASSERT_EQ(future.wait_for(::std::chrono::seconds(10)),
+              ::std::future_status::ready);
+    ASSERT_EQ(future.get(), static_cast<int>(cpu));
+}
+
+TEST(ThreadPool, createPerNumaNode)
+{
+    auto result = ::remotePortMapper::ThreadPool::createPerNumaNode();
+    ASSERT_TRUE(result);
+    auto &pools = result.value<
+        ::std::vector<::std::shared_ptr<::remotePortMapper::ThreadPool>>>();
+
+    auto &nodes = ::remotePortMapper::CpuTopology::numaNodes();
+    ASSERT_EQ(pools.size(), nodes.size());
+    for (::std::size_t i = 0; i < pools.size(); ++i) {
+        ASSERT_EQ(pools[i]->cpus(), nodes[i].cpus);
+        ASSERT_EQ(pools[i]->workerCount(), nodes[i].cpus.size());
+
+        ::std::promise<void> ran;
+        pools[i]->addTask([&]() -> void {
+            ran.set_value();
+        });
+        auto future = ran.get_future();
+        ASSERT_EQ(future.wait_for(::std::chrono::seconds(10)),
+                  ::std::future_status::ready);
+    }
+}
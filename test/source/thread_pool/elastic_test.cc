@@ -0,0 +1,100 @@
+#include <cstdint>
+#include <future>
+
+#include <gtest/gtest.h>
+
+#include <common/thread_pool/thread_pool.h>
+
+TEST(ThreadPool, elastic)
+{
+    for (auto scheduler :
+         {::remotePortMapper::ThreadPoolScheduler::Global,
+          ::remotePortMapper::ThreadPoolScheduler::WorkStealing}) {
+        auto result = ::remotePortMapper::ThreadPool::create(
+            ::remotePortMapper::ThreadPoolOptions {
+                .workers           = 1,
+                .maxWorkers        = 4,
+                .workerIdleTimeout = ::std::chrono::milliseconds(50),
+                .scheduler         = scheduler});
+        ASSERT_TRUE(result);
+
+        // Take the only reference, so resetting it joins the workers.
+        auto threadPool = ::std::move(
+            result.value<::std::shared_ptr<::remotePortMapper::ThreadPool>>());
+        ASSERT_EQ(threadPool->workerCount(), 1);
+
+        // Blocking tasks which only finish when all of them run at the same
+        // time, the pool has to grow.
+        constexpr int        count = 4;
+        ::std::atomic<int>   running(0);
+        ::std::atomic<int>   finished(0);
+        ::std::promise<void> allRunning;
+        ::std::promise<void> done;
+        auto                 allRunningFuture = allRunning.get_future().share();
+        for (int i = 0; i < count; ++i) {
+            threadPool->addTask([&, allRunningFuture]() -> void {
+                if (running.fetch_add(1) + 1 == count) {
+                    allRunning.set_value();
+                }
+                allRunningFuture.wait();
+                if (finished.fetch_add(1) + 1 == count) {
+                    done.set_value();
+                }
+            });
+        }
+
+        auto future = done.get_future();
+        ASSERT_EQ(future.wait_for(::std::chrono::seconds(10)),
+                  ::std::future_status::ready);
+        auto metrics = threadPool->workerMetrics();
+        ASSERT_EQ(metrics.minWorkers, 1);
+        ASSERT_EQ(metrics.maxWorkers, count);
+        ASSERT_EQ(metrics.spawnedWorkers, count - 1);
+
+        // Shrink back to the minimum when idle.
+        auto deadline
+            = ::std::chrono::steady_clock::now() + ::std::chrono::seconds(10);
+        while (threadPool->workerCount() > 1
+               && ::std::chrono::steady_clock::now() < deadline) {
+            ::std::this_thread::sleep_for(::std::chrono::milliseconds(10));
+        }
+        metrics = threadPool->workerMetrics();
+        ASSERT_EQ(metrics.workers, 1);
+        ASSERT_EQ(metrics.retiredWorkers, count - 1);
+
+        // Grow again after shrinking.
+        ::std::promise<void> release;
+        ::std::promise<void> ran;
+        auto                 releaseFuture = release.get_future();
+        threadPool->addTask([&]() -> void {
+            releaseFuture.wait();
+        });
+        threadPool->addTask([&]() -> void {
+            ran.set_value();
+        });
+        auto ranFuture = ran.get_future();
+        ASSERT_EQ(ranFuture.wait_for(::std::chrono::seconds(10)),
+                  ::std::future_status::ready);
+        release.set_value();
+
+        // Workers may still be in the tasks referring to the promises, join
+        // them before the promises go away.
+        threadPool.reset();
+    }
+}
+
+TEST(ThreadPool, fixedWorkers)
+{
+    auto result = ::remotePortMapper::ThreadPool::create(
+        ::remotePortMapper::ThreadPoolOptions {.workers = 2});
+    ASSERT_TRUE(result);
+    auto threadPool
+        = result.value<::std::shared_ptr<::remotePortMapper::ThreadPool>>();
+
+    auto metrics = threadPool->workerMetrics();
+    ASSERT_EQ(metrics.workers, 2);
+    ASSERT_EQ(metrics.minWorkers, 2);
+    ASSERT_EQ(metrics.maxWorkers, 2);
+    ASSERT_EQ(metrics.spawnedWorkers, 0);
+    ASSERT_EQ(metrics.retiredWorkers, 0);
+}
@@ -0,0 +1,169 @@
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <common/thread_pool/future.h>
+#include <common/thread_pool/thread_pool.h>
+
+using IntResult  = ::remotePortMapper::Result<int, ::remotePortMapper::Error>;
+using VoidResult = ::remotePortMapper::Result<void, ::remotePortMapper::Error>;
+using StringResult
+    = ::remotePortMapper::Result<::std::string, ::remotePortMapper::Error>;
+
+TEST(Future, submitAndThen)
+{
+    auto result = ::remotePortMapper::ThreadPool::create(2);
+    ASSERT_TRUE(result);
+    auto threadPool
+        = result.value<::std::shared_ptr<::remotePortMapper::ThreadPool>>();
+
+    // Continuations of a pending future run on the pool.
+    ::remotePortMapper::Promise<int> promise(threadPool);
+    auto                             caller = ::std::this_thread::get_id();
+    auto future = promise.future().then([caller](IntResult result)
+                                            -> StringResult {
+        EXPECT_NE(::std::this_thread::get_id(), caller);
+        return StringResult::makeOk(::std::to_string(result.value<int>() + 1));
+    });
+    promise.setResult(IntResult::makeOk(20));
+    ASSERT_TRUE(future.valid());
+    auto value = future.get();
+    ASSERT_FALSE(future.valid());
+    ASSERT_TRUE(value);
+    ASSERT_EQ(value.value<::std::string>(), "21");
+
+    // Submit, errors pass through.
+    auto submitted = ::remotePortMapper::submit(threadPool, []() -> IntResult {
+        return IntResult::makeOk(1);
+    });
+    ASSERT_EQ(submitted.get().value<int>(), 1);
+    auto failed = ::remotePortMapper::submit(threadPool, []() -> VoidResult {
+        return VoidResult::makeError(::remotePortMapper::Error {
+            ::remotePortMapper::ErrorCode::InvalidValue, "failed"});
+    });
+    auto passed = failed.then([](VoidResult result) -> VoidResult {
+        return result;
+    });
+    auto error  = passed.get();
+    ASSERT_FALSE(error);
+    ASSERT_EQ(error.value<::remotePortMapper::Error>().message, "failed");
+
+    threadPool.reset();
+}
+
+TEST(Future, readySkipsScheduling)
+{
+    auto result = ::remotePortMapper::ThreadPool::create(1);
+    ASSERT_TRUE(result);
+    auto threadPool
+        = result.value<::std::shared_ptr<::remotePortMapper::ThreadPool>>();
+
+    // A ready future continues at once in the caller.
+    auto caller = ::std::this_thread::get_id();
+    bool ran    = false;
+    auto ready  = ::remotePortMapper::Future<int>::makeReady(
+        IntResult::makeOk(1), threadPool);
+    auto future = ready.then([&](IntResult result) -> IntResult {
+        EXPECT_EQ(::std::this_thread::get_id(), caller);
+        ran = true;
+        return IntResult::makeOk(result.value<int>() * 2);
+    });
+    ASSERT_TRUE(ran);
+    ASSERT_TRUE(future.ready());
+    ASSERT_EQ(future.get().value<int>(), 2);
+
+    threadPool.reset();
+}
+
+TEST(Future, brokenPromise)
+{
+    ::remotePortMapper::Future<int> future;
+    {
+        ::remotePortMapper::Promise<int> promise;
+        future = promise.future();
+        ASSERT_FALSE(future.ready());
+    }
+    IntResult result = future.get();
+    ASSERT_FALSE(result);
+    ASSERT_EQ(result.value<::remotePortMapper::Error>().errCode,
+              ::remotePortMapper::ErrorCode::BrokenPromise);
+}
+
+TEST(Future, whenAll)
+{
+    auto result = ::remotePortMapper::ThreadPool::create(4);
+    ASSERT_TRUE(result);
+    auto threadPool
+        = result.value<::std::shared_ptr<::remotePortMapper::ThreadPool>>();
+
+    ::std::vector<::remotePortMapper::Future<int>> futures;
+    for (int i = 0; i < 16; ++i) {
+        futures.push_back(
+            ::remotePortMapper::submit(threadPool, [i]() -> IntResult {
+                ::std::this_thread::sleep_for(
+                    ::std::chrono::milliseconds(16 - i));
+                if (i == 3) {
+                    return IntResult::makeError(::remotePortMapper::Error {
+                        ::remotePortMapper::ErrorCode::InvalidValue, "3"});
+                }
+                return IntResult::makeOk(i);
+            }));
+    }
+    auto all = ::remotePortMapper::whenAll(::std::move(futures)).get();
+    ASSERT_TRUE(all);
+    auto &results = all.value<::std::vector<IntResult>>();
+    ASSERT_EQ(results.size(), 16);
+    for (int i = 0; i < 16; ++i) {
+        ASSERT_EQ(static_cast<bool>(results[i]), i != 3);
+        if (i != 3) {
+            ASSERT_EQ(results[i].value<int>(), i);
+        }
+    }
+
+    // Empty.
+    auto empty = ::remotePortMapper::whenAll(
+                     ::std::vector<::remotePortMapper::Future<int>>())
+                     .get();
+    ASSERT_TRUE(empty);
+    ASSERT_TRUE(empty.value<::std::vector<IntResult>>().empty());
+
+    threadPool.reset();
+}
+
+TEST(Future, whenAny)
+{
+    auto result = ::remotePortMapper::ThreadPool::create(2);
+    ASSERT_TRUE(result);
+    auto threadPool
+        = result.value<::std::shared_ptr<::remotePortMapper::ThreadPool>>();
+
+    // The second promise is set first.
+    ::remotePortMapper::Promise<int>               first(threadPool);
+    ::remotePortMapper::Promise<int>               second(threadPool);
+    ::std::vector<::remotePortMapper::Future<int>> futures;
+    futures.push_back(first.future());
+    futures.push_back(second.future());
+    auto any = ::remotePortMapper::whenAny(::std::move(futures));
+    ASSERT_FALSE(any.ready());
+    second.setResult(IntResult::makeOk(2));
+    first.setResult(IntResult::makeOk(1));
+
+    auto value = any.get();
+    ASSERT_TRUE(value);
+    auto &pair = value.value<::std::pair<::std::size_t, IntResult>>();
+    ASSERT_EQ(pair.first, 1);
+    ASSERT_EQ(pair.second.value<int>(), 2);
+
+    // Empty.
+    auto empty = ::remotePortMapper::whenAny(
+                     ::std::vector<::remotePortMapper::Future<int>>())
+                     .get();
+    ASSERT_FALSE(empty);
+
+    threadPool.reset();
+}
@@ -0,0 +1,33 @@
+#include <cstdint>
+#include <future>
+
+#include <gtest/gtest.h>
+
+#include <common/thread_pool/thread_pool.h>
+
+TEST(ThreadPool, idlePolicy)
+{
+    for (auto idlePolicy :
+         {::remotePortMapper::ThreadPoolIdlePolicy::latencyOptimized(),
+          ::remotePortMapper::ThreadPoolIdlePolicy::powerSaving(),
+          ::remotePortMapper::ThreadPoolIdlePolicy {.spins = 16, .yields = 0},
+          ::remotePortMapper::ThreadPoolIdlePolicy {.spins = 0, .yields = 4}}) {
+        auto result = ::remotePortMapper::ThreadPool::create(
+            ::remotePortMapper::ThreadPoolOptions {.workers    = 2,
+                                                   .idlePolicy = idlePolicy});
+        ASSERT_TRUE(result);
+        auto threadPool
+            = result.value<::std::shared_ptr<::remotePortMapper::ThreadPool>>();
+
+        // Ping-pong, workers go idle between each task.
+        for (int i = 0; i < 200; ++i) {
+            ::std::promise<void> done;
+            threadPool->addTask([&]() -> void {
+                done.set_value();
+            });
+            auto future = done.get_future();
+            ASSERT_EQ(future.wait_for(::std::chrono::seconds(10)),
+                      ::std::future_status::ready);
+        }
+    }
+}
@@ -0,0 +1,143 @@
+#include <atomic>
+#include <chrono>
+#include <future>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <common/thread_pool/thread_pool.h>
+
+/**
+ * @brief       Chain of tasks, each adds the next one.
+ */
+struct Chain {
+    ::remotePortMapper::ThreadPool *threadPool; ///< Thread pool.
+    int                             length;     ///< Count of links.
+    ::std::atomic<int>              links;      ///< Links run.
+    ::std::vector<::std::thread::id> threads;   ///< Thread of each link.
+    ::std::chrono::microseconds     work;       ///< Time of each link.
+    ::std::promise<void>            done;       ///< Set by the last link.
+
+    /**
+     * @brief       Run a link and add the next one.
+     */
+    void link()
+    {
+        threads.push_back(::std::this_thread::get_id());
+        auto until = ::std::chrono::steady_clock::now() + work;
+        while (::std::chrono::steady_clock::now() < until) {
+        }
+        if (links.fetch_add(1) + 1 == length) {
+            done.set_value();
+        } else {
+            threadPool->addTask([this]() -> void {
+                this->link();
+            });
+        }
+    }
+};
+
+TEST(ThreadPool, lifoSlot)
+{
+    for (auto scheduler :
+         {::remotePortMapper::ThreadPoolScheduler::Global,
+          ::remotePortMapper::ThreadPoolScheduler::WorkStealing}) {
+        auto result = ::remotePortMapper::ThreadPool::create(
+            ::remotePortMapper::ThreadPoolOptions {.workers       = 4,
+                                                   .scheduler     = scheduler,
+                                                   .lifoSlot      = true,
+                                                   .lifoSlotBurst = 0});
+        ASSERT_TRUE(result);
+        auto threadPool
+            = result.value<::std::shared_ptr<::remotePortMapper::ThreadPool>>();
+
+        // Each follow-up runs on the worker which added it.
+        Chain chain {.threadPool = threadPool.get(),
+                     .length     = 100,
+                     .links      = 0,
+                     .threads    = {},
+                     .work       = ::std::chrono::microseconds(0),
+                     .done       = {}};
+        threadPool->addTask([&]() -> void {
+            chain.link();
+        });
+        chain.done.get_future().wait();
+        ASSERT_EQ(chain.threads.size(), 100);
+        for (auto &thread : chain.threads) {
+            ASSERT_EQ(thread, chain.threads.front());
+        }
+        ASSERT_EQ(threadPool->queueDepth(
+                      ::remotePortMapper::ThreadPoolPriority::Normal),
+                  0);
+
+        threadPool.reset();
+    }
+}
+
+TEST(ThreadPool, lifoSlotBurst)
+{
+    // A chain filling the slot of the only worker lets a queued task run
+    // after the burst, unless unlimited.
+    for (uint32_t burst : {3, 0}) {
+        auto result = ::remotePortMapper::ThreadPool::create(
+            ::remotePortMapper::ThreadPoolOptions {.workers       = 1,
+                                                   .lifoSlot      = true,
+                                                   .lifoSlotBurst = burst});
+        ASSERT_TRUE(result);
+        auto threadPool
+            = result.value<::std::shared_ptr<::remotePortMapper::ThreadPool>>();
+
+        Chain                chain {.threadPool = threadPool.get(),
+                                    .length     = 200,
+                                    .links      = 0,
+                                    .threads    = {},
+                                    .work = ::std::chrono::microseconds(200),
+                                    .done = {}};
+        ::std::atomic<int>   linksBefore(-1);
+        ::std::promise<void> queuedDone;
+        threadPool->addTask([&]() -> void {
+            chain.link();
+        });
+        while (chain.links.load() == 0) {
+            ::std::this_thread::yield();
+        }
+        threadPool->addTask([&]() -> void {
+            linksBefore = chain.links.load();
+            queuedDone.set_value();
+        });
+        chain.done.get_future().wait();
+        queuedDone.get_future().wait();
+        threadPool.reset();
+
+        if (burst == 0) {
+            ASSERT_EQ(linksBefore.load(), chain.length);
+        } else {
+            ASSERT_LT(linksBefore.load(), chain.length);
+        }
+    }
+}
+
+TEST(ThreadPool, lifoSlotPoolDestroyed)
+{
+    auto result = ::remotePortMapper::ThreadPool::create(
+        ::remotePortMapper::ThreadPoolOptions {.workers = 2, .lifoSlot = true});
+    ASSERT_TRUE(result);
+    auto threadPool
+        = result.value<::std::shared_ptr<::remotePortMapper::ThreadPool>>();
+
+    // The task in the slot runs on another worker when the last reference
+    // is dropped by the task which added it.
+    ::std::promise<void> done;
+    auto                 raw = threadPool.get();
+    raw->addTask([threadPool = ::std::move(threadPool), &done]() mutable
+                     -> void {
+        threadPool->addTask([&done]() -> void {
+            done.set_value();
+        });
+        threadPool.reset();
+    });
+    auto future = done.get_future();
+    ASSERT_EQ(future.wait_for(::std::chrono::seconds(10)),
+              ::std::future_status::ready);
+}
@@ -0,0 +1,156 @@
+#include <atomic>
+#include <cstdint>
+#include <future>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <common/thread_pool/thread_pool.h>
+
+TEST(ThreadPool, parallelFor)
+{
+    for (auto scheduler :
+         {::remotePortMapper::ThreadPoolScheduler::Global,
+          ::remotePortMapper::ThreadPoolScheduler::WorkStealing}) {
+        auto result = ::remotePortMapper::ThreadPool::create(
+            ::remotePortMapper::ThreadPoolOptions {.workers   = 4,
+                                                   .scheduler = scheduler});
+        ASSERT_TRUE(result);
+        auto threadPool
+            = result.value<::std::shared_ptr<::remotePortMapper::ThreadPool>>();
+
+        // Each index is visited once.
+        for (::std::size_t grain : {0, 1, 7, 1000, 5000}) {
+            ::std::vector<::std::atomic<int>> visits(1000);
+            threadPool->parallelFor(
+                10, 1000,
+                [&](::std::size_t first, ::std::size_t last) -> void {
+                    EXPECT_LT(first, last);
+                    if (grain != 0) {
+                        EXPECT_LE(last - first, grain);
+                    }
+                    for (::std::size_t i = first; i < last; ++i) {
+                        visits[i].fetch_add(1);
+                    }
+                },
+                grain);
+            for (::std::size_t i = 0; i < visits.size(); ++i) {
+                ASSERT_EQ(visits[i].load(), i < 10 ? 0 : 1);
+            }
+        }
+
+        // Empty range.
+        threadPool->parallelFor(
+            5, 5, [](::std::size_t, ::std::size_t) -> void {
+                ADD_FAILURE();
+            });
+
+        threadPool.reset();
+    }
+}
+
+TEST(ThreadPool, parallelForNested)
+{
+    // The caller helps, so a loop in a task of a single worker finishes and
+    // nested loops never deadlock.
+    auto result = ::remotePortMapper::ThreadPool::create(1);
+    ASSERT_TRUE(result);
+    auto threadPool
+        = result.value<::std::shared_ptr<::remotePortMapper::ThreadPool>>();
+
+    ::std::atomic<uint64_t> sum(0);
+    ::std::promise<void>    done;
+    threadPool->addTask([&]() -> void {
+        threadPool->parallelFor(
+            0, 100,
+            [&](::std::size_t first, ::std::size_t last) -> void {
+                threadPool->parallelFor(
+                    first * 100, last * 100,
+                    [&](::std::size_t from, ::std::size_t to) -> void {
+                        for (::std::size_t i = from; i < to; ++i) {
+                            sum.fetch_add(i);
+                        }
+                    },
+                    10);
+            },
+            1);
+        done.set_value();
+    });
+
+    auto future = done.get_future();
+    ASSERT_EQ(future.wait_for(::std::chrono::seconds(10)),
+              ::std::future_status::ready);
+    ASSERT_EQ(sum.load(), 9999ULL * 10000 / 2);
+    threadPool.reset();
+}
+
+TEST(ThreadPool, parallelForLifoSlot)
+{
+    // A chunk on another worker waits for the task in the slot of the
+    // caller, which only the caller runs.
+    auto result = ::remotePortMapper::ThreadPool::create(
+        ::remotePortMapper::ThreadPoolOptions {.workers = 2, .lifoSlot = true});
+    ASSERT_TRUE(result);
+    auto threadPool
+        = result.value<::std::shared_ptr<::remotePortMapper::ThreadPool>>();
+
+    ::std::atomic<bool>  helperStarted(false);
+    ::std::atomic<bool>  slotRan(false);
+    ::std::promise<void> done;
+    threadPool->addTask([&]() -> void {
+        auto caller = ::std::this_thread::get_id();
+        threadPool->addTask([&]() -> void {
+            slotRan = true;
+            slotRan.notify_all();
+        });
+        threadPool->parallelFor(
+            0, 2,
+            [&](::std::size_t, ::std::size_t) -> void {
+                if (::std::this_thread::get_id() == caller) {
+                    // Leave the other chunk to the helper.
+                    while (! helperStarted) {
+                        ::std::this_thread::yield();
+                    }
+                } else {
+                    helperStarted = true;
+                    slotRan.wait(false);
+                }
+            },
+            1);
+        done.set_value();
+    });
+
+    auto future = done.get_future();
+    ASSERT_EQ(future.wait_for(::std::chrono::seconds(10)),
+              ::std::future_status::ready);
+    ASSERT_TRUE(slotRan.load());
+    threadPool.reset();
+}
+
+TEST(ThreadPool, parallelInvoke)
+{
+    auto result = ::remotePortMapper::ThreadPool::create(2);
+    ASSERT_TRUE(result);
+    auto threadPool
+        = result.value<::std::shared_ptr<::remotePortMapper::ThreadPool>>();
+
+    int a = 0;
+    int b = 0;
+    int c = 0;
+    threadPool->parallelInvoke(
+        [&]() -> void {
+            a = 1;
+        },
+        [&]() -> void {
+            b = 2;
+        },
+        [&]() -> int {
+            c = 3;
+            return c;
+        });
+    ASSERT_EQ(a, 1);
+    ASSERT_EQ(b, 2);
+    ASSERT_EQ(c, 3);
+    threadPool.reset();
+}
@@ -0,0 +1,149 @@
+#include <chrono>
+#include <cstdint>
+#include <future>
+#include <mutex>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <common/thread_pool/thread_pool.h>
+
+TEST(ThreadPool, periodicAlarm)
+{
+    for (auto store : {::remotePortMapper::ThreadPoolAlarmStore::SortedMap,
+                       ::remotePortMapper::ThreadPoolAlarmStore::TimingWheel}) {
+        auto result = ::remotePortMapper::ThreadPool::create(
+            ::remotePortMapper::ThreadPoolOptions {.workers    = 2,
+                                                   .alarmStore = store});
+        ASSERT_TRUE(result);
+        auto threadPool
+            = result.value<::std::shared_ptr<::remotePortMapper::ThreadPool>>();
+
+        // Each run is at or after its own deadline, never drifting.
+        constexpr ::std::size_t count  = 5;
+        constexpr auto          period = ::std::chrono::milliseconds(20);
+        ::std::mutex            mutex;
+        ::std::vector<::std::chrono::steady_clock::time_point> runs;
+        ::std::promise<void>                                   done;
+        auto begin = ::std::chrono::steady_clock::now() + period;
+        auto alarm
+            = threadPool->addPeriodicAlarm(begin, period, [&]() -> void {
+                  ::std::unique_lock lock(mutex);
+                  runs.push_back(::std::chrono::steady_clock::now());
+                  if (runs.size() == count) {
+                      done.set_value();
+                  }
+              });
+        ASSERT_EQ(alarm->period(), period);
+
+        auto future = done.get_future();
+        ASSERT_EQ(future.wait_for(::std::chrono::seconds(10)),
+                  ::std::future_status::ready);
+        ASSERT_TRUE(alarm->cancel());
+        {
+            ::std::unique_lock lock(mutex);
+            for (::std::size_t i = 0; i < count; ++i) {
+                ASSERT_GE(runs[i], begin + period * i);
+            }
+        }
+
+        // No runs after canceled, beside one which may be running.
+        ::std::this_thread::sleep_for(period);
+        ::std::size_t canceledRuns;
+        {
+            ::std::unique_lock lock(mutex);
+            canceledRuns = runs.size();
+        }
+        ::std::this_thread::sleep_for(period * 5);
+        {
+            ::std::unique_lock lock(mutex);
+            ASSERT_EQ(runs.size(), canceledRuns);
+        }
+
+        threadPool.reset();
+    }
+}
+
+TEST(ThreadPool, periodicAlarmNoOverlap)
+{
+    auto result = ::remotePortMapper::ThreadPool::create(4);
+    ASSERT_TRUE(result);
+    auto threadPool
+        = result.value<::std::shared_ptr<::remotePortMapper::ThreadPool>>();
+
+    // Runs longer than the period skip the missed periods.
+    constexpr auto       period = ::std::chrono::milliseconds(5);
+    ::std::atomic<int>   running(0);
+    ::std::atomic<bool>  overlapped(false);
+    ::std::atomic<int>   runs(0);
+    ::std::promise<void> done;
+    auto                 alarm = threadPool->addPeriodicAlarm(
+        ::std::chrono::steady_clock::now(), period, [&]() -> void {
+            if (running.fetch_add(1) != 0) {
+                overlapped = true;
+            }
+            ::std::this_thread::sleep_for(period * 3);
+            running.fetch_sub(1);
+            if (runs.fetch_add(1) + 1 == 5) {
+                done.set_value();
+            }
+        });
+
+    auto future = done.get_future();
+    ASSERT_EQ(future.wait_for(::std::chrono::seconds(10)),
+              ::std::future_status::ready);
+    alarm->cancel();
+    ASSERT_FALSE(overlapped.load());
+    threadPool.reset();
+}
+
+TEST(ThreadPool, periodicAlarmStopsWithPool)
+{
+    auto result = ::remotePortMapper::ThreadPool::create(2);
+    ASSERT_TRUE(result);
+    auto threadPool
+        = result.value<::std::shared_ptr<::remotePortMapper::ThreadPool>>();
+
+    // The pool never waits for the next period when destroyed.
+    threadPool->addPeriodicAlarm(::std::chrono::steady_clock::now()
+                                     + ::std::chrono::hours(1),
+                                 ::std::chrono::hours(1), []() -> void {});
+    auto begin = ::std::chrono::steady_clock::now();
+    threadPool.reset();
+    ASSERT_LT(::std::chrono::steady_clock::now() - begin,
+              ::std::chrono::seconds(10));
+}
+
+TEST(ThreadPool, alarmSlack)
+{
+    auto result = ::remotePortMapper::ThreadPool::create(
+        ::remotePortMapper::ThreadPoolOptions {
+            .workers    = 2,
+            .alarmSlack = ::std::chrono::milliseconds(100)});
+    ASSERT_TRUE(result);
+    auto threadPool
+        = result.value<::std::shared_ptr<::remotePortMapper::ThreadPool>>();
+
+    // Alarms due within the slack fire together, after the last deadline.
+    constexpr int        count = 10;
+    ::std::atomic<int>   fired(0);
+    ::std::promise<void> done;
+    auto                 begin = ::std::chrono::steady_clock::now();
+    auto                 last  = begin + ::std::chrono::milliseconds(5 * count);
+    for (int i = 1; i <= count; ++i) {
+        auto timepoint = begin + ::std::chrono::milliseconds(5 * i);
+        threadPool->addAlarm(timepoint, [&, timepoint]() -> void {
+            auto now = ::std::chrono::steady_clock::now();
+            EXPECT_GE(now, timepoint);
+            EXPECT_GE(now, last);
+            if (fired.fetch_add(1) + 1 == count) {
+                done.set_value();
+            }
+        });
+    }
+
+    auto future = done.get_future();
+    ASSERT_EQ(future.wait_for(::std::chrono::seconds(10)),
+              ::std::future_status::ready);
+    threadPool.reset();
+}
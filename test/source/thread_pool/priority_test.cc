@@ -0,0 +1,120 @@
+#include <cstdint>
+#include <future>
+
+#include <gtest/gtest.h>
+
+#include <common/thread_pool/thread_pool.h>
+
+TEST(ThreadPool, priority)
+{
+    for (auto scheduler :
+         {::remotePortMapper::ThreadPoolScheduler::Global,
+          ::remotePortMapper::ThreadPoolScheduler::WorkStealing}) {
+        auto result = ::remotePortMapper::ThreadPool::create(
+            ::remotePortMapper::ThreadPoolOptions {.workers   = 1,
+                                                   .scheduler = scheduler});
+        ASSERT_TRUE(result);
+        auto threadPool
+            = result.value<::std::shared_ptr<::remotePortMapper::ThreadPool>>();
+
+        // Block the only worker.
+        ::std::promise<void> started;
+        ::std::promise<void> release;
+        auto                 releaseFuture = release.get_future();
+        threadPool->addTask([&]() -> void {
+            started.set_value();
+            releaseFuture.wait();
+        });
+        started.get_future().wait();
+
+        // A high priority task queued after normal ones runs first.
+        constexpr int        normalCount = 100;
+        ::std::vector<int>   order;
+        ::std::promise<void> done;
+        for (int i = 0; i < normalCount; ++i) {
+            threadPool->addTask([&, i]() -> void {
+                order.push_back(i);
+                if (i == normalCount - 1) {
+                    done.set_value();
+                }
+            });
+        }
+        threadPool->addTask(
+            [&]() -> void {
+                order.push_back(-1);
+            },
+            ::remotePortMapper::ThreadPoolPriority::High);
+
+        ASSERT_EQ(threadPool->queueDepth(
+                      ::remotePortMapper::ThreadPoolPriority::High),
+                  1);
+        ASSERT_EQ(threadPool->queueDepth(
+                      ::remotePortMapper::ThreadPoolPriority::Normal),
+                  normalCount);
+
+        release.set_value();
+        auto future = done.get_future();
+        ASSERT_EQ(future.wait_for(::std::chrono::seconds(10)),
+                  ::std::future_status::ready);
+        ASSERT_EQ(order.size(), normalCount + 1);
+        ASSERT_EQ(order[0], -1);
+        for (int i = 0; i < normalCount; ++i) {
+            ASSERT_EQ(order[i + 1], i);
+        }
+        ASSERT_EQ(threadPool->queueDepth(
+                      ::remotePortMapper::ThreadPoolPriority::High),
+                  0);
+        ASSERT_EQ(threadPool->queueDepth(
+                      ::remotePortMapper::ThreadPoolPriority::Normal),
+                  0);
+    }
+}
+
+TEST(ThreadPool, priorityStarvation)
+{
+    auto result = ::remotePortMapper::ThreadPool::create(
+        ::remotePortMapper::ThreadPoolOptions {.workers           = 1,
+                                               .highPriorityBurst = 4});
+    ASSERT_TRUE(result);
+    auto threadPool
+        = result.value<::std::shared_ptr<::remotePortMapper::ThreadPool>>();
+
+    // Block the only worker.
+    ::std::promise<void> started;
+    ::std::promise<void> release;
+    auto                 releaseFuture = release.get_future();
+    threadPool->addTask([&]() -> void {
+        started.set_value();
+        releaseFuture.wait();
+    });
+    started.get_future().wait();
+
+    // Normal priority tasks make progress under a flood of high priority
+    // ones.
+    constexpr int        highCount   = 20;
+    constexpr int        normalCount = 2;
+    ::std::vector<char>  order;
+    ::std::promise<void> done;
+    for (int i = 0; i < normalCount; ++i) {
+        threadPool->addTask([&]() -> void {
+            order.push_back('n');
+        });
+    }
+    for (int i = 0; i < highCount; ++i) {
+        threadPool->addTask(
+            [&, i]() -> void {
+                order.push_back('h');
+                if (i == highCount - 1) {
+                    done.set_value();
+                }
+            },
+            ::remotePortMapper::ThreadPoolPriority::High);
+    }
+
+    release.set_value();
+    auto future = done.get_future();
+    ASSERT_EQ(future.wait_for(::std::chrono::seconds(10)),
+              ::std::future_status::ready);
+    ASSERT_EQ(::std::string(order.begin(), order.end()),
+              "hhhhnhhhhnhhhhhhhhhhhh");
+}
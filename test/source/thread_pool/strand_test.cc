@@ -0,0 +1,152 @@
+#include <cstdint>
+#include <future>
+
+#include <gtest/gtest.h>
+
+#include <common/thread_pool/strand.h>
+#include <common/thread_pool/thread_pool.h>
+
+TEST(Strand, order)
+{
+    for (auto scheduler :
+         {::remotePortMapper::ThreadPoolScheduler::Global,
+          ::remotePortMapper::ThreadPoolScheduler::WorkStealing}) {
+        auto result = ::remotePortMapper::ThreadPool::create(
+            ::remotePortMapper::ThreadPoolOptions {.workers   = 4,
+                                                   .scheduler = scheduler});
+        ASSERT_TRUE(result);
+        auto threadPool
+            = result.value<::std::shared_ptr<::remotePortMapper::ThreadPool>>();
+
+        // Tasks of each strand run in order and never concurrently, posted
+        // from outside and from inside the pool.
+        constexpr int        strandCount = 8;
+        constexpr int        taskCount   = 1000;
+        ::std::atomic<int>   finished(0);
+        ::std::promise<void> done;
+
+        struct Context {
+            ::std::shared_ptr<::remotePortMapper::Strand> strand;
+            ::std::atomic<int>                            running;
+            int                                           next;
+        };
+        ::std::vector<Context> contexts(strandCount);
+        for (auto &context : contexts) {
+            auto strandResult = ::remotePortMapper::Strand::create(threadPool);
+            ASSERT_TRUE(strandResult);
+            context.strand  = strandResult.value<
+                 ::std::shared_ptr<::remotePortMapper::Strand>>();
+            context.running = 0;
+            context.next    = 0;
+        }
+
+        auto makeTask = [&](Context &context, int index) {
+            return [&, index]() -> void {
+                EXPECT_TRUE(context.strand->runningInThisThread());
+                EXPECT_EQ(context.running.fetch_add(1), 0);
+                EXPECT_EQ(context.next, index);
+                ++context.next;
+                context.running.fetch_sub(1);
+
+                if (finished.fetch_add(1) + 1 == strandCount * taskCount) {
+                    done.set_value();
+                }
+            };
+        };
+
+        for (auto &context : contexts) {
+            threadPool->addTask([&]() -> void {
+                for (int i = 0; i < taskCount / 2; ++i) {
+                    context.strand->post(makeTask(context, i));
+                }
+            });
+        }
+        auto future = done.get_future();
+        ASSERT_NE(future.wait_for(::std::chrono::milliseconds(0)),
+                  ::std::future_status::ready);
+
+        // Wait for the first half, the second half comes from outside.
+        while (finished.load() < strandCount * taskCount / 2) {
+            ::std::this_thread::yield();
+        }
+        for (auto &context : contexts) {
+            ASSERT_FALSE(context.strand->runningInThisThread());
+            for (int i = taskCount / 2; i < taskCount; ++i) {
+                context.strand->post(makeTask(context, i));
+            }
+        }
+
+        ASSERT_EQ(future.wait_for(::std::chrono::seconds(10)),
+                  ::std::future_status::ready);
+        for (auto &context : contexts) {
+            ASSERT_EQ(context.next, taskCount);
+        }
+    }
+}
+
+TEST(Strand, parallel)
+{
+    auto result = ::remotePortMapper::ThreadPool::create(2);
+    ASSERT_TRUE(result);
+    auto threadPool
+        = result.value<::std::shared_ptr<::remotePortMapper::ThreadPool>>();
+
+    // A task blocking one strand must not block another.
+    auto strand1 = ::remotePortMapper::Strand::create(threadPool)
+                       .value<::std::shared_ptr<::remotePortMapper::Strand>>();
+    auto strand2 = ::remotePortMapper::Strand::create(threadPool)
+                       .value<::std::shared_ptr<::remotePortMapper::Strand>>();
+
+    ::std::promise<void> release;
+    ::std::promise<void> done;
+    auto                 releaseFuture = release.get_future();
+    strand1->post([&]() -> void {
+        releaseFuture.wait();
+    });
+    strand2->post([&]() -> void {
+        release.set_value();
+    });
+    strand1->post([&]() -> void {
+        done.set_value();
+    });
+
+    auto future = done.get_future();
+    ASSERT_EQ(future.wait_for(::std::chrono::seconds(10)),
+              ::std::future_status::ready);
+}
+
+TEST(Strand, nullThreadPool)
+{
+    auto result = ::remotePortMapper::Strand::create(nullptr);
+    ASSERT_FALSE(result);
+}
+
+TEST(Strand, lastPoolReferenceInTask)
+{
+    auto threadPool
+        = ::remotePortMapper::ThreadPool::create(2)
+              .value<::std::shared_ptr<::remotePortMapper::ThreadPool>>();
+    auto strand = ::remotePortMapper::Strand::create(threadPool)
+                      .value<::std::shared_ptr<::remotePortMapper::Strand>>();
+    ::std::weak_ptr<::remotePortMapper::ThreadPool> weakThreadPool
+        = threadPool;
+
+    // The task holds the last reference, the pool is destroyed on one of its
+    // own workers.
+    ::std::promise<void> release;
+    auto                 releaseFuture = release.get_future().share();
+    strand->post(
+        [threadPool = ::std::move(threadPool), releaseFuture]() -> void {
+            releaseFuture.wait();
+        });
+    release.set_value();
+
+    auto deadline
+        = ::std::chrono::steady_clock::now() + ::std::chrono::seconds(10);
+    while (! weakThreadPool.expired()
+           && ::std::chrono::steady_clock::now() < deadline) {
+        ::std::this_thread::sleep_for(::std::chrono::milliseconds(1));
+    }
+    ASSERT_TRUE(weakThreadPool.expired());
+    ASSERT_EQ(strand->threadPool(), nullptr);
+}
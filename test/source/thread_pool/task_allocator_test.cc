@@ -0,0 +1,88 @@
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <future>
+#include <memory_resource>
+
+#include <gtest/gtest.h>
+
+#include <common/thread_pool/thread_pool.h>
+
+/**
+ * @brief   Arena of a connection, counts allocations.
+ */
+class Arena : public ::std::pmr::memory_resource {
+  public:
+    ::std::pmr::synchronized_pool_resource pool; ///< Pool of memory.
+    ::std::atomic<int> allocations   = 0;        ///< Allocations.
+    ::std::atomic<int> deallocations = 0;        ///< Deallocations.
+
+  private:
+    /**
+     * @brief       Allocate.
+     */
+    void *do_allocate(::std::size_t bytes, ::std::size_t alignment) override
+    {
+        allocations.fetch_add(1);
+        return pool.allocate(bytes, alignment);
+    }
+
+    /**
+     * @brief       Deallocate.
+     */
+    void do_deallocate(void         *ptr,
+                       ::std::size_t bytes,
+                       ::std::size_t alignment) override
+    {
+        deallocations.fetch_add(1);
+        pool.deallocate(ptr, bytes, alignment);
+    }
+
+    /**
+     * @brief       Compare.
+     */
+    bool do_is_equal(
+        const ::std::pmr::memory_resource &other) const noexcept override
+    {
+        return this == &other;
+    }
+};
+
+TEST(ThreadPool, taskAllocator)
+{
+    auto result = ::remotePortMapper::ThreadPool::create(2);
+    ASSERT_TRUE(result);
+    auto threadPool
+        = result.value<::std::shared_ptr<::remotePortMapper::ThreadPool>>();
+
+    // Tasks of a connection take their captures from its arena, they are
+    // destroyed on workers.
+    constexpr int              count = 100;
+    Arena                      arena;
+    ::std::array<uint64_t, 16> slice = {};
+    ::std::atomic<uint64_t>    sum(0);
+    ::std::atomic<int>         done(0);
+    ::std::promise<void>       finished;
+    for (int i = 0; i < count; ++i) {
+        slice[0] = static_cast<uint64_t>(i);
+        threadPool->addTask(::remotePortMapper::ThreadPool::Task(
+            ::std::allocator_arg, &arena,
+            [slice, &sum, &done, &finished]() -> void {
+                sum.fetch_add(slice[0]);
+                if (done.fetch_add(1) + 1 == count) {
+                    finished.set_value();
+                }
+            }));
+    }
+    auto future = finished.get_future();
+    ASSERT_EQ(future.wait_for(::std::chrono::seconds(10)),
+              ::std::future_status::ready);
+    ASSERT_EQ(sum.load(), count * (count - 1) / 2);
+    ASSERT_EQ(arena.allocations.load(), count);
+
+    // Released in bulk when the connection closes.
+    threadPool.reset();
+    ASSERT_EQ(arena.deallocations.load(), count);
+    arena.pool.release();
+}
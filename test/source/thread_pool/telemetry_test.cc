@@ -0,0 +1,156 @@
+#include <chrono>
+#include <cstdint>
+#include <future>
+#include <thread>
+
+#include <gtest/gtest.h>
+
+#include <common/thread_pool/histogram.h>
+#include <common/thread_pool/thread_pool.h>
+
+TEST(ThreadPool, histogram)
+{
+    ::remotePortMapper::Histogram histogram;
+    for (uint64_t i = 0; i < 100; ++i) {
+        histogram.record(i);
+    }
+    histogram.record(1000);
+
+    auto snapshot = histogram.snapshot();
+    ASSERT_EQ(snapshot.count, 101);
+    ASSERT_EQ(snapshot.sum, 4950 + 1000);
+    ASSERT_EQ(snapshot.max, 1000);
+    ASSERT_EQ(snapshot.buckets[0], 1);
+    ASSERT_EQ(snapshot.buckets[1], 1);
+    ASSERT_EQ(snapshot.buckets[2], 2);
+    ASSERT_EQ(snapshot.buckets[10], 1);
+    ASSERT_DOUBLE_EQ(snapshot.mean(), 5950.0 / 101);
+
+    // Upper bound of the bucket, never above the maximum.
+    ASSERT_EQ(snapshot.percentile(0), 0);
+    ASSERT_EQ(snapshot.percentile(50), 63);
+    ASSERT_EQ(snapshot.percentile(99), 127);
+    ASSERT_EQ(snapshot.percentile(100), 1000);
+
+    snapshot += histogram.snapshot();
+    ASSERT_EQ(snapshot.count, 202);
+    ASSERT_EQ(snapshot.buckets[10], 2);
+    ASSERT_EQ(snapshot.max, 1000);
+
+    ::remotePortMapper::HistogramSnapshot empty = {};
+    ASSERT_EQ(empty.mean(), 0);
+    ASSERT_EQ(empty.percentile(50), 0);
+}
+
+TEST(ThreadPool, telemetry)
+{
+    for (auto scheduler :
+         {::remotePortMapper::ThreadPoolScheduler::Global,
+          ::remotePortMapper::ThreadPoolScheduler::WorkStealing}) {
+        auto result = ::remotePortMapper::ThreadPool::create(
+            ::remotePortMapper::ThreadPoolOptions {
+                .workers                 = 2,
+                .scheduler               = scheduler,
+                .telemetrySampleInterval = 1});
+        ASSERT_TRUE(result);
+        auto threadPool
+            = result.value<::std::shared_ptr<::remotePortMapper::ThreadPool>>();
+
+        constexpr uint64_t count   = 20;
+        constexpr auto     runTime = ::std::chrono::milliseconds(1);
+        for (uint64_t i = 0; i < count; ++i) {
+            threadPool->addTask([runTime]() -> void {
+                ::std::this_thread::sleep_for(runTime);
+            });
+        }
+        ::std::promise<void> alarmed;
+        threadPool->addAlarm(::std::chrono::steady_clock::now(),
+                             [&]() -> void {
+                                 alarmed.set_value();
+                             });
+
+        // Tasks are recorded after they return.
+        auto deadline
+            = ::std::chrono::steady_clock::now() + ::std::chrono::seconds(10);
+        auto telemetry = threadPool->telemetry();
+        while (telemetry.runTime.count < count + 1
+               && ::std::chrono::steady_clock::now() < deadline) {
+            ::std::this_thread::sleep_for(::std::chrono::milliseconds(1));
+            telemetry = threadPool->telemetry();
+        }
+
+        ASSERT_EQ(telemetry.runTime.count, count + 1);
+        ASSERT_EQ(telemetry.waitTime.count, count + 1);
+        ASSERT_EQ(telemetry.queueDepth.count, count + 1);
+        ASSERT_GE(telemetry.queueDepth.max, 1);
+        ASSERT_GE(telemetry.runTime.max,
+                  static_cast<uint64_t>(
+                      ::std::chrono::nanoseconds(runTime).count()));
+        ASSERT_EQ(telemetry.alarmLateness.count, 1);
+
+        ASSERT_EQ(telemetry.workers.size(), 2);
+        ::std::chrono::nanoseconds busyTime(0);
+        for (auto &worker : telemetry.workers) {
+            ASSERT_GE(worker.busyRatio, 0.0);
+            ASSERT_LE(worker.busyRatio, 1.0);
+            busyTime += worker.busyTime;
+        }
+        ASSERT_GE(busyTime, runTime * count);
+
+        threadPool.reset();
+    }
+}
+
+TEST(ThreadPool, telemetrySampling)
+{
+    constexpr uint32_t interval = 4;
+    auto               result   = ::remotePortMapper::ThreadPool::create(
+        ::remotePortMapper::ThreadPoolOptions {
+            .workers = 2, .telemetrySampleInterval = interval});
+    ASSERT_TRUE(result);
+    auto threadPool
+        = result.value<::std::shared_ptr<::remotePortMapper::ThreadPool>>();
+
+    // One in each interval of tasks added by this thread is sampled, the
+    // countdown may be left partially used by previous pools.
+    constexpr uint64_t count   = 400;
+    constexpr uint64_t sampled = count / interval;
+    for (uint64_t i = 0; i < count; ++i) {
+        threadPool->addTask([]() -> void {});
+    }
+
+    auto deadline
+        = ::std::chrono::steady_clock::now() + ::std::chrono::seconds(10);
+    auto telemetry = threadPool->telemetry();
+    while (telemetry.runTime.count + interval < sampled
+           && ::std::chrono::steady_clock::now() < deadline) {
+        ::std::this_thread::sleep_for(::std::chrono::milliseconds(1));
+        telemetry = threadPool->telemetry();
+    }
+    threadPool.reset();
+
+    ASSERT_GE(telemetry.runTime.count + interval, sampled);
+    ASSERT_LE(telemetry.runTime.count, sampled);
+}
+
+TEST(ThreadPool, telemetryOff)
+{
+    auto result = ::remotePortMapper::ThreadPool::create(
+        ::remotePortMapper::ThreadPoolOptions {.workers   = 2,
+                                               .telemetrySampleInterval = 0});
+    ASSERT_TRUE(result);
+    auto threadPool
+        = result.value<::std::shared_ptr<::remotePortMapper::ThreadPool>>();
+
+    ::std::promise<void> done;
+    threadPool->addTask([&]() -> void {
+        done.set_value();
+    });
+    done.get_future().wait();
+
+    auto telemetry = threadPool->telemetry();
+    ASSERT_EQ(telemetry.runTime.count, 0);
+    ASSERT_EQ(telemetry.waitTime.count, 0);
+    ASSERT_TRUE(telemetry.workers.empty());
+    threadPool.reset();
+}
@@ -0,0 +1,137 @@
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <test/common/AllocationCounter.h>
+
+#include <common/thread_pool/thread_pool.h>
+
+/**
+ * @brief       Wait until a counter reaches a value.
+ *
+ * @param[in]   counter     Counter.
+ * @param[in]   value       Value.
+ *
+ * @return      \c true if reached, \c false if timeout.
+ */
+static bool waitFor(const ::std::atomic<int> &counter, int value)
+{
+    auto deadline
+        = ::std::chrono::steady_clock::now() + ::std::chrono::seconds(10);
+    while (counter.load() < value) {
+        if (::std::chrono::steady_clock::now() >= deadline) {
+            return false;
+        }
+        ::std::this_thread::sleep_for(::std::chrono::milliseconds(1));
+    }
+
+    return true;
+}
+
+TEST(ThreadPool, timer)
+{
+    auto result = ::remotePortMapper::ThreadPool::create(2);
+    ASSERT_TRUE(result);
+    auto threadPool
+        = result.value<::std::shared_ptr<::remotePortMapper::ThreadPool>>();
+
+    // Fires never before its timepoint.
+    ::std::atomic<int> fired(0);
+    auto               timepoint
+        = ::std::chrono::steady_clock::now() + ::std::chrono::milliseconds(20);
+    auto handle = threadPool->addTimer(timepoint, [&]() -> void {
+        EXPECT_GE(::std::chrono::steady_clock::now(), timepoint);
+        fired.fetch_add(1);
+    });
+    ASSERT_NE(handle.generation, 0);
+    ASSERT_TRUE(waitFor(fired, 1));
+
+    // A fired timer is not cancelable.
+    ASSERT_FALSE(threadPool->cancelTimer(handle));
+
+    // Cancel.
+    handle = threadPool->addTimer(::std::chrono::steady_clock::now()
+                                      + ::std::chrono::milliseconds(20),
+                                  [&]() -> void {
+                                      fired.fetch_add(1);
+                                  });
+    ASSERT_TRUE(threadPool->cancelTimer(handle));
+    ASSERT_FALSE(threadPool->cancelTimer(handle));
+    ::std::this_thread::sleep_for(::std::chrono::milliseconds(50));
+    ASSERT_EQ(fired.load(), 1);
+
+    // A stale handle never cancels the timer reusing its slot.
+    auto reused = threadPool->addTimer(::std::chrono::steady_clock::now()
+                                           + ::std::chrono::milliseconds(20),
+                                       [&]() -> void {
+                                           fired.fetch_add(1);
+                                       });
+    ASSERT_EQ(reused.index, handle.index);
+    ASSERT_NE(reused.generation, handle.generation);
+    ASSERT_FALSE(threadPool->cancelTimer(handle));
+    ASSERT_TRUE(waitFor(fired, 2));
+
+    // Invalid handles.
+    using TimerHandle = ::remotePortMapper::ThreadPool::TimerHandle;
+    ASSERT_FALSE(threadPool->cancelTimer(TimerHandle {}));
+    ASSERT_FALSE(threadPool->cancelTimer(
+        TimerHandle {.index = UINT32_MAX, .generation = 1}));
+
+    threadPool.reset();
+}
+
+TEST(ThreadPool, timerAllocationFree)
+{
+    auto result = ::remotePortMapper::ThreadPool::create(
+        ::remotePortMapper::ThreadPoolOptions {.workers = 2,
+                                               .telemetrySampleInterval = 0});
+    ASSERT_TRUE(result);
+    auto threadPool
+        = result.value<::std::shared_ptr<::remotePortMapper::ThreadPool>>();
+
+    // Tasks are built before counting, the timers own nothing else.
+    using Tasks = ::std::vector<::remotePortMapper::ThreadPool::Task>;
+    constexpr int      count     = 100;
+    ::std::atomic<int> fired(0);
+    auto               makeTasks = [&]() -> Tasks {
+        Tasks tasks;
+        for (int i = 0; i < count * 2; ++i) {
+            tasks.emplace_back([&]() -> void {
+                fired.fetch_add(1);
+            });
+        }
+        return tasks;
+    };
+    ::std::vector<::remotePortMapper::ThreadPool::TimerHandle> handles(count);
+    auto round = [&](Tasks &tasks) -> void {
+        auto now = ::std::chrono::steady_clock::now();
+        for (int i = 0; i < count; ++i) {
+            threadPool->addTimer(now + ::std::chrono::milliseconds(1),
+                                 ::std::move(tasks[i]));
+            handles[i] = threadPool->addTimer(now + ::std::chrono::hours(1),
+                                              ::std::move(tasks[count + i]));
+        }
+        for (auto &handle : handles) {
+            threadPool->cancelTimer(handle);
+        }
+    };
+
+    // Warm up, slots, queues and buffers grow to the peak.
+    auto tasks = makeTasks();
+    round(tasks);
+    ASSERT_TRUE(waitFor(fired, count));
+
+    tasks = makeTasks();
+    {
+        AllocationCounter counter;
+        round(tasks);
+        ASSERT_TRUE(waitFor(fired, count * 2));
+        ASSERT_EQ(counter.allocations(), 0);
+    }
+
+    threadPool.reset();
+}
@@ -0,0 +1,140 @@
+#include <cstdint>
+#include <future>
+#include <random>
+
+#include <gtest/gtest.h>
+
+#include <common/thread_pool/thread_pool.h>
+#include <common/thread_pool/timing_wheel.h>
+
+/**
+ * @brief   Node to test.
+ */
+class TimingWheelTestNode : public ::remotePortMapper::TimingWheelNode {
+  public:
+    uint64_t expected = 0; ///< Expected tick.
+};
+
+TEST(TimingWheel, expire)
+{
+    ::remotePortMapper::TimingWheel wheel(100);
+    ASSERT_TRUE(wheel.empty());
+    ASSERT_EQ(wheel.nextTick(), ::remotePortMapper::TimingWheel::noTick);
+
+    // Ticks across several levels, including the past.
+    ::std::vector<uint64_t> ticks
+        = {50, 100, 101, 163, 164, 4195, 4196, 300000, 1ULL << 40};
+    ::std::vector<TimingWheelTestNode> nodes(ticks.size());
+    for (::std::size_t i = 0; i < ticks.size(); ++i) {
+        nodes[i].expected = ::std::max<uint64_t>(ticks[i], 101);
+        wheel.insert(&nodes[i], ticks[i]);
+        ASSERT_TRUE(nodes[i].linked());
+    }
+    ASSERT_EQ(wheel.size(), ticks.size());
+
+    // Remove one.
+    wheel.remove(&nodes[3]);
+    ASSERT_FALSE(nodes[3].linked());
+    ASSERT_EQ(wheel.size(), ticks.size() - 1);
+
+    // Each node expires exactly at its tick.
+    ::std::vector<::remotePortMapper::TimingWheelNode *> expired;
+    ::std::size_t                                        count = 0;
+    while (! wheel.empty()) {
+        uint64_t next = wheel.nextTick();
+        ASSERT_GT(next, wheel.currentTick());
+
+        wheel.advance(next, expired);
+        for (auto node : expired) {
+            auto testNode = static_cast<TimingWheelTestNode *>(node);
+            ASSERT_EQ(testNode->expected, wheel.currentTick());
+            ASSERT_FALSE(testNode->linked());
+            ++count;
+        }
+        expired.clear();
+    }
+    ASSERT_EQ(count, ticks.size() - 1);
+}
+
+TEST(TimingWheel, random)
+{
+    ::std::mt19937_64                         random(12345);
+    ::std::uniform_int_distribution<uint64_t> distance(0, 1 << 20);
+
+    ::remotePortMapper::TimingWheel    wheel(random());
+    ::std::vector<TimingWheelTestNode> nodes(10000);
+    for (auto &node : nodes) {
+        node.expected = wheel.currentTick() + 1 + distance(random);
+        wheel.insert(&node, node.expected);
+    }
+
+    // Cancel every third node.
+    for (::std::size_t i = 0; i < nodes.size(); i += 3) {
+        wheel.remove(&nodes[i]);
+    }
+
+    // Advance in irregular steps, no node may expire late or early.
+    ::std::vector<::remotePortMapper::TimingWheelNode *> expired;
+    ::std::size_t                                        count = 0;
+    uint64_t                                             target
+        = wheel.currentTick();
+    while (! wheel.empty()) {
+        uint64_t last = target;
+        target += 1 + distance(random) / 64;
+        wheel.advance(target, expired);
+        for (auto node : expired) {
+            auto testNode = static_cast<TimingWheelTestNode *>(node);
+            ASSERT_LE(testNode->expected, target);
+            ASSERT_GT(testNode->expected, last);
+            ++count;
+        }
+        expired.clear();
+    }
+    ASSERT_EQ(count, nodes.size() - (nodes.size() + 2) / 3);
+}
+
+TEST(ThreadPool, timingWheelAlarm)
+{
+    auto result = ::remotePortMapper::ThreadPool::create(
+        ::remotePortMapper::ThreadPoolOptions {
+            .workers    = 2,
+            .alarmStore = ::remotePortMapper::ThreadPoolAlarmStore::TimingWheel,
+            .alarmTick  = ::std::chrono::milliseconds(5)});
+    ASSERT_TRUE(result);
+    auto threadPool
+        = result.value<::std::shared_ptr<::remotePortMapper::ThreadPool>>();
+
+    // Alarms fire in order, never early.
+    constexpr int        count = 20;
+    ::std::mutex         mutex;
+    ::std::vector<int>   fired;
+    ::std::promise<void> done;
+    auto                 begin = ::std::chrono::steady_clock::now();
+    for (int i = count - 1; i >= 0; --i) {
+        auto timepoint = begin + ::std::chrono::milliseconds(20 * i);
+        threadPool->addAlarm(timepoint, [&, i, timepoint]() -> void {
+            EXPECT_GE(::std::chrono::steady_clock::now(), timepoint);
+            ::std::unique_lock lock(mutex);
+            fired.push_back(i);
+            if (static_cast<int>(fired.size()) == count) {
+                done.set_value();
+            }
+        });
+    }
+
+    // Cancelled alarms never fire.
+    ::std::atomic<bool> canceledFired(false);
+    auto                alarm = threadPool->addAlarm(
+        begin + ::std::chrono::milliseconds(100), [&]() -> void {
+            canceledFired = true;
+        });
+    ASSERT_TRUE(alarm->cancel());
+
+    auto future = done.get_future();
+    ASSERT_EQ(future.wait_for(::std::chrono::seconds(10)),
+              ::std::future_status::ready);
+    for (int i = 0; i < count; ++i) {
+        ASSERT_EQ(fired[i], i);
+    }
+    ASSERT_FALSE(canceledFired.load());
+}
@@ -0,0 +1,112 @@
+#include <atomic>
+#include <chrono>
+#include <functional>
+#include <thread>
+
+#include <gtest/gtest.h>
+
+#include <common/thread_pool/thread_pool.h>
+#include <common/thread_pool/virtual_clock.h>
+
+/**
+ * @brief       Wait until a counter reaches a value.
+ *
+ * @param[in]   counter     Counter.
+ * @param[in]   value       Value.
+ *
+ * @return      \c true if reached, \c false if timeout.
+ */
+static bool waitFor(const ::std::atomic<int> &counter, int value)
+{
+    auto deadline
+        = ::std::chrono::steady_clock::now() + ::std::chrono::seconds(10);
+    while (counter.load() < value) {
+        if (::std::chrono::steady_clock::now() >= deadline) {
+            return false;
+        }
+        ::std::this_thread::yield();
+    }
+
+    return true;
+}
+
+TEST(VirtualClock, advance)
+{
+    auto start  = ::std::chrono::steady_clock::time_point();
+    auto result = ::remotePortMapper::VirtualClock::create(start);
+    ASSERT_TRUE(result);
+    auto clock
+        = result.value<::std::shared_ptr<::remotePortMapper::VirtualClock>>();
+    ASSERT_EQ(clock->now(), start);
+
+    // Time moves only when advanced, never backwards.
+    ::std::this_thread::sleep_for(::std::chrono::milliseconds(10));
+    ASSERT_EQ(clock->now(), start);
+    clock->advance(::std::chrono::hours(1));
+    ASSERT_EQ(clock->now(), start + ::std::chrono::hours(1));
+    clock->advance(-::std::chrono::hours(1));
+    ASSERT_EQ(clock->now(), start + ::std::chrono::hours(1));
+    clock->advanceTo(start);
+    ASSERT_EQ(clock->now(), start + ::std::chrono::hours(1));
+    clock->advanceTo(start + ::std::chrono::hours(2));
+    ASSERT_EQ(clock->now(), start + ::std::chrono::hours(2));
+}
+
+TEST(ThreadPool, virtualClock)
+{
+    for (auto store : {::remotePortMapper::ThreadPoolAlarmStore::SortedMap,
+                       ::remotePortMapper::ThreadPoolAlarmStore::TimingWheel}) {
+        auto clockResult = ::remotePortMapper::VirtualClock::create();
+        ASSERT_TRUE(clockResult);
+        auto clock = clockResult.value<
+            ::std::shared_ptr<::remotePortMapper::VirtualClock>>();
+        auto result = ::remotePortMapper::ThreadPool::create(
+            ::remotePortMapper::ThreadPoolOptions {.workers    = 2,
+                                                   .alarmStore = store,
+                                                   .clock      = clock});
+        ASSERT_TRUE(result);
+        auto threadPool = result.value<
+            ::std::shared_ptr<::remotePortMapper::ThreadPool>>();
+        ASSERT_EQ(threadPool->now(), clock->now());
+
+        // An hour long timeout fires only when the clock reaches it.
+        ::std::atomic<int> fired(0);
+        auto               start = clock->now();
+        threadPool->addAlarm(start + ::std::chrono::hours(1), [&]() -> void {
+            fired.fetch_add(1);
+        });
+        threadPool->addTimer(start + ::std::chrono::hours(2), [&]() -> void {
+            fired.fetch_add(1);
+        });
+        ::std::this_thread::sleep_for(::std::chrono::milliseconds(20));
+        clock->advance(::std::chrono::minutes(59));
+        ::std::this_thread::sleep_for(::std::chrono::milliseconds(20));
+        ASSERT_EQ(fired.load(), 0);
+        clock->advance(::std::chrono::minutes(1));
+        ASSERT_TRUE(waitFor(fired, 1));
+        clock->advanceTo(start + ::std::chrono::hours(2));
+        ASSERT_TRUE(waitFor(fired, 2));
+
+        // A day of keepalives every 30 seconds.
+        ::std::atomic<int>               keepalives(0);
+        ::std::function<void()>          keepalive;
+        constexpr ::std::chrono::seconds interval(30);
+        constexpr int                    count = 24 * 60 * 2;
+        keepalive = [&]() -> void {
+            if (keepalives.load() + 1 < count) {
+                threadPool->addAlarm(threadPool->now() + interval, keepalive);
+            }
+            keepalives.fetch_add(1);
+        };
+        threadPool->addAlarm(threadPool->now() + interval, keepalive);
+        for (int i = 1; i <= count; ++i) {
+            clock->advance(interval);
+            ASSERT_TRUE(waitFor(keepalives, i));
+        }
+        ASSERT_EQ(clock->now() - start,
+                  ::std::chrono::hours(2) + ::std::chrono::hours(24));
+        ASSERT_EQ(keepalives.load(), count);
+
+        threadPool.reset();
+    }
+}
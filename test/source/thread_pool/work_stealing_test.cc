@@ -0,0 +1,80 @@
+#include <cstdint>
+#include <future>
+
+#include <gtest/gtest.h>
+
+#include <common/thread_pool/thread_pool.h>
+
+/**
+ * @brief       Spawn a binary tree of tasks.
+ *
+ * @param[in]   threadPool      Thread pool.
+ * @param[in]   depth           Depth of the tree.
+ * @param[in]   counter         Counter of finished tasks.
+ * @param[in]   done            Promise to set after the last task.
+ * @param[in]   total           Count of all tasks.
+ */
+static void spawnTree(::remotePortMapper::ThreadPool &threadPool,
+                      int                             depth,
+                      ::std::atomic<int>             &counter,
+                      ::std::promise<void>           &done,
+                      int                             total)
+{
+    if (depth > 0) {
+        for (int i = 0; i < 2; ++i) {
+            threadPool.addTask([&, depth, total]() -> void {
+                spawnTree(threadPool, depth - 1, counter, done, total);
+            });
+        }
+    }
+
+    if (counter.fetch_add(1) + 1 == total) {
+        done.set_value();
+    }
+}
+
+TEST(ThreadPool, workStealing)
+{
+    auto result = ::remotePortMapper::ThreadPool::create(
+        ::remotePortMapper::ThreadPoolOptions {
+            .workers   = 4,
+            .scheduler = ::remotePortMapper::ThreadPoolScheduler::WorkStealing});
+    ASSERT_TRUE(result);
+    auto threadPool
+        = result.value<::std::shared_ptr<::remotePortMapper::ThreadPool>>();
+    ASSERT_EQ(threadPool->workerCount(), 4);
+    ASSERT_EQ(threadPool->scheduler(),
+              ::remotePortMapper::ThreadPoolScheduler::WorkStealing);
+
+    // Tasks spawned from workers.
+    {
+        constexpr int        depth = 10;
+        constexpr int        total = (1 << (depth + 1)) - 1;
+        ::std::atomic<int>   counter(0);
+        ::std::promise<void> done;
+        auto                 future = done.get_future();
+        threadPool->addTask([&]() -> void {
+            spawnTree(*threadPool, depth, counter, done, total);
+        });
+        ASSERT_EQ(future.wait_for(::std::chrono::seconds(10)),
+                  ::std::future_status::ready);
+        ASSERT_EQ(counter.load(), total);
+    }
+
+    // A worker waits for a task in its own deque, others must steal it.
+    {
+        ::std::promise<void> stolen;
+        ::std::promise<void> done;
+        auto                 future = done.get_future();
+        threadPool->addTask([&]() -> void {
+            auto stolenFuture = stolen.get_future();
+            threadPool->addTask([&]() -> void {
+                stolen.set_value();
+            });
+            stolenFuture.wait();
+            done.set_value();
+        });
+        ASSERT_EQ(future.wait_for(::std::chrono::seconds(10)),
+                  ::std::future_status::ready);
+    }
+}